@@ -0,0 +1,293 @@
+// bollEngine.cpp
+// See bollEngine.h and bollBand.cpp for the bands that are built
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "bollEngine.h"
+
+using namespace std;
+
+// Bars between exact rebuilds of the rolling moments
+#define RESYNC_BARS	1024
+
+// Normalized filter weights of the midline, newest first.  Returns the number of weights (0 if not a filter).
+//		>0	-	(period - jj)^maType / sum((1:period)^maType) as movAvg
+//		-5	-	A simple average of a simple average of n = ceil((period+1)/2) is a filter of 2n-1 triangular weights
+int bollWeights(int period, double maType, double *weights)
+{
+	if (maType > 0)
+	{
+		double weightSum = 0;
+		for (int ii = 1; ii <= period; ii++)
+		{
+			weightSum = weightSum + pow(double(ii), maType);
+		}
+
+		for (int jj = 0; jj < period; jj++)
+		{
+			weights[jj] = pow(double(period - jj), maType) / weightSum;
+		}
+
+		return period;
+	}
+	else if (maType == -5)
+	{
+		int n = (period + 2) / 2;
+		int numWeights = 2 * n - 1;
+
+		for (int jj = 0; jj < numWeights; jj++)
+		{
+			weights[jj] = double(jj < n ? jj + 1 : numWeights - jj) / (double(n) * n);
+		}
+
+		return numWeights;
+	}
+
+	return 0;
+}
+
+// Rolled term of a geometric (-2) or harmonic (-3) midline
+inline double bollTerm(double maType, double x)
+{
+	return (maType == -2) ? log(x) : 1 / x;
+}
+
+// One instrument in a single pass.  Pair kk is written at offset kk * pairStride.
+// 'window' holds 'period' values when the midline is trimmed (-4), otherwise it is unused.
+void bollKernel(const double *price, int rows, int period, double maType, const double *weights, int numWeights,
+	const double *devUp, const double *devDwn, int numUp, int numDwn, int numPairs, double *window,
+	double *lBand, double *mAvg, double *uBand, int pairStride)
+{
+	// Create a NaN value
+	double m_Nan = std::numeric_limits<double>::quiet_NaN(); 
+
+	// Welford state of the window: mean and sum of squared deviations from it
+	double mean = 0, M2 = 0;
+	double ema = price[0];
+	double alpha = 2.0 / (period + 1);
+
+	// Geometric and harmonic midlines roll a sum of logs | reciprocals alongside the moments
+	bool rollTerm = (maType == -2 || maType == -3);
+	double termSum = 0;
+
+	// Trimmed midline.  As trimmean, round(period * 10 / 200) observations are removed from each end with halves
+	// rounded down.
+	int trim = int(ceil(period / 20.0 - 0.5));
+
+	// NaN prices in the window.  While any remain the bar is NaN and the sorted window is not maintained.
+	int nanCount = 0;
+	bool windowValid = true;
+
+	for (int ii = 0; ii < rows; ii++)
+	{
+		double x = price[ii];
+
+		bool oldNan = (ii >= period && std::isnan(price[ii - period]));
+		nanCount = nanCount + (std::isnan(x) ? 1 : 0) - (oldNan ? 1 : 0);
+
+		// Moments of the window
+		if (ii < period)
+		{
+			// Warm up: add only
+			double delta = x - mean;
+			mean = mean + delta / (ii + 1);
+			M2 = M2 + delta * (x - mean);
+
+			if (rollTerm)
+				termSum = termSum + bollTerm(maType, x);
+		}
+		else if (ii % RESYNC_BARS == 0 || (oldNan && nanCount == 0))
+		{
+			// Exact rebuild over price[ii - period + 1 .. ii], also once the last NaN has left the window
+			double sum = 0;
+			for (int jj = ii - period + 1; jj <= ii; jj++)
+			{
+				sum = sum + price[jj];
+			}
+			mean = sum / period;
+
+			M2 = 0;
+			for (int jj = ii - period + 1; jj <= ii; jj++)
+			{
+				double dev = price[jj] - mean;
+				M2 = M2 + dev * dev;
+			}
+
+			if (rollTerm)
+			{
+				termSum = 0;
+				for (int jj = ii - period + 1; jj <= ii; jj++)
+				{
+					termSum = termSum + bollTerm(maType, price[jj]);
+				}
+			}
+		}
+		else
+		{
+			// Replace the oldest observation with the newest
+			double old = price[ii - period];
+			double meanLast = mean;
+			mean = mean + (x - old) / period;
+			M2 = M2 + (x - old) * ((x - mean) + (old - meanLast));
+			if (M2 < 0) M2 = 0;
+
+			if (rollTerm)
+				termSum = termSum + bollTerm(maType, x) - bollTerm(maType, old);
+		}
+
+		// A NaN seed is replaced by the next price
+		if (std::isnan(ema))
+			ema = x;
+		else if (ii > 0)
+			ema = ema + alpha * (x - ema);
+
+		// Sorted window.  The oldest observation is taken out and the newest put in its place.  NaN does not
+		// order, so the window is abandoned while it holds one and sorted afresh once it is clear.
+		if (window != NULL && nanCount > 0)
+		{
+			windowValid = false;
+		}
+		else if (window != NULL && !windowValid)
+		{
+			if (ii >= period - 1)
+			{
+				copy(price + ii - period + 1, price + ii + 1, window);
+				sort(window, window + period);
+				windowValid = true;
+			}
+		}
+		else if (window != NULL)
+		{
+			int pos;
+			if (ii < period)
+			{
+				pos = ii;
+			}
+			else
+			{
+				double old = price[ii - period];
+				for (pos = 0; pos < period - 1 && window[pos] != old; pos++);
+			}
+
+			while (pos > 0 && window[pos - 1] > x)
+			{
+				window[pos] = window[pos - 1];
+				pos--;
+			}
+			while (pos < (ii < period ? ii : period - 1) && window[pos + 1] < x)
+			{
+				window[pos] = window[pos + 1];
+				pos++;
+			}
+			window[pos] = x;
+		}
+
+		// As bollBand.m the first 'period' observations are NaN, as is any window holding a NaN
+		if (ii < period || nanCount > 0)
+		{
+			mAvg[ii] = m_Nan;
+			for (int kk = 0; kk < numPairs; kk++)
+			{
+				lBand[ii + kk * pairStride] = m_Nan;
+				uBand[ii + kk * pairStride] = m_Nan;
+			}
+			continue;
+		}
+
+		// Determine midline
+		double ma;
+		if (maType == 0)
+			ma = mean;
+		else if (maType == -1)
+			ma = ema;
+		else if (maType == -2)
+			ma = exp(termSum / period);
+		else if (maType == -3)
+			ma = period / termSum;
+		else if (maType == -4)
+		{
+			ma = 0;
+			for (int jj = trim; jj < period - trim; jj++)
+			{
+				ma = ma + window[jj];
+			}
+			ma = ma / (period - 2 * trim);
+		}
+		else
+		{
+			ma = 0;
+			for (int jj = 0; jj < numWeights; jj++)
+			{
+				ma = ma + weights[jj] * price[ii - jj];
+			}
+		}
+
+		// Sample standard deviation as slidefun('std', ...)
+		double stdAdj = sqrt(M2 / (period - 1));
+
+		mAvg[ii] = ma;
+		for (int kk = 0; kk < numPairs; kk++)
+		{
+			double up = devUp[numUp > 1 ? kk : 0];
+			double dwn = fabs(devDwn[numDwn > 1 ? kk : 0]);
+
+			lBand[ii + kk * pairStride] = ma - (dwn * stdAdj);
+			uBand[ii + kk * pairStride] = ma + (up * stdAdj);
+		}
+	}
+}
+//
+//  -------------------------------------------------------------------------
+//                                  _    _ 
+//         ___  _ __   ___ _ __    / \  | | __ _  ___   ___  _ __ __ _ 
+//        / _ \| '_ \ / _ \ '_ \  / _ \ | |/ _` |/ _ \ / _ \| '__/ _` |
+//       | (_) | |_) |  __/ | | |/ ___ \| | (_| | (_) | (_) | | | (_| |
+//        \___/| .__/ \___|_| |_/_/   \_\_|\__, |\___(_)___/|_|  \__, |
+//             |_|                         |___/                 |___/
+//  -------------------------------------------------------------------------
+//        This code is distributed in the hope that it will be useful,
+//
+//                      	   WITHOUT ANY WARRANTY
+//
+//                  WITHOUT CLAIM AS TO MERCHANTABILITY
+//
+//                  OR FITNESS FOR A PARTICULAR PURPOSE
+//
+//                          expressed or implied.
+//
+//   Use of this code, pseudocode, algorithmic or trading logic contained
+//   herein, whether sound or faulty for any purpose is the sole
+//   responsibility of the USER. Any such use of these algorithms, coding
+//   logic or concepts in whole or in part carry no covenant of correctness
+//   or recommended usage from the AUTHOR or any of the possible
+//   contributors listed or unlisted, known or unknown.
+//
+//   Any reference of this code or to this code including any variants from
+//   this code, or any other credits due this AUTHOR from this code shall be
+//   clearly and unambiguously cited and evident during any use, whether in
+//   whole or in part.
+//
+//   The public sharing of this code does not relinquish, reduce, restrict or
+//   encumber any rights the AUTHOR has in respect to claims of intellectual
+//   property.
+//
+//   IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY
+//   DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+//   OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+//   STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//   ANY WAY OUT OF THE USE OF THIS SOFTWARE, CODE, OR CODE FRAGMENT(S), EVEN
+//   IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//   -------------------------------------------------------------------------
+//
+//                             ALL RIGHTS RESERVED
+//
+//   -------------------------------------------------------------------------
+//
+//   Author:	Mark Tompkins
+//   Revision:	4906.24976
+//   Copyright:	(c)2013
+//
\ No newline at end of file
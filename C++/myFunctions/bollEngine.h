@@ -0,0 +1,76 @@
+#ifndef BOLLENGINE_H
+#define BOLLENGINE_H
+
+// bollEngine
+// Single pass Bollinger band kernel behind bollBand_mex.  It is kept free of the Matlab API so it can be built
+// into drivers (drivers/bollNan.cpp) as well as the gateway.
+//
+// The midline is a moving average as movAvg and the bands are a number of (sample) standard deviations above
+// and below it.  See bollBand.cpp for the midline types and the layout of the outputs.
+
+// Normalized filter weights of the midline, newest first.  Returns the number of weights (0 if not a filter).
+// 'weights' must hold period + 1 values.
+int bollWeights(int period, double maType, double *weights);
+
+// One instrument in a single pass.  Pair kk is written at offset kk * pairStride.
+// 'window' holds 'period' values when the midline is trimmed (-4), otherwise it is unused.
+// The first 'period' observations are NaN, as is any bar whose window holds a NaN price.
+void bollKernel(const double *price, int rows, int period, double maType, const double *weights, int numWeights,
+	const double *devUp, const double *devDwn, int numUp, int numDwn, int numPairs, double *window,
+	double *lBand, double *mAvg, double *uBand, int pairStride);
+
+#endif // BOLLENGINE_H
+//
+//  -------------------------------------------------------------------------
+//                                  _    _ 
+//         ___  _ __   ___ _ __    / \  | | __ _  ___   ___  _ __ __ _ 
+//        / _ \| '_ \ / _ \ '_ \  / _ \ | |/ _` |/ _ \ / _ \| '__/ _` |
+//       | (_) | |_) |  __/ | | |/ ___ \| | (_| | (_) | (_) | | | (_| |
+//        \___/| .__/ \___|_| |_/_/   \_\_|\__, |\___(_)___/|_|  \__, |
+//             |_|                         |___/                 |___/
+//  -------------------------------------------------------------------------
+//        This code is distributed in the hope that it will be useful,
+//
+//                      	   WITHOUT ANY WARRANTY
+//
+//                  WITHOUT CLAIM AS TO MERCHANTABILITY
+//
+//                  OR FITNESS FOR A PARTICULAR PURPOSE
+//
+//                          expressed or implied.
+//
+//   Use of this code, pseudocode, algorithmic or trading logic contained
+//   herein, whether sound or faulty for any purpose is the sole
+//   responsibility of the USER. Any such use of these algorithms, coding
+//   logic or concepts in whole or in part carry no covenant of correctness
+//   or recommended usage from the AUTHOR or any of the possible
+//   contributors listed or unlisted, known or unknown.
+//
+//   Any reference of this code or to this code including any variants from
+//   this code, or any other credits due this AUTHOR from this code shall be
+//   clearly and unambiguously cited and evident during any use, whether in
+//   whole or in part.
+//
+//   The public sharing of this code does not relinquish, reduce, restrict or
+//   encumber any rights the AUTHOR has in respect to claims of intellectual
+//   property.
+//
+//   IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY
+//   DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+//   OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+//   STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//   ANY WAY OUT OF THE USE OF THIS SOFTWARE, CODE, OR CODE FRAGMENT(S), EVEN
+//   IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//   -------------------------------------------------------------------------
+//
+//                             ALL RIGHTS RESERVED
+//
+//   -------------------------------------------------------------------------
+//
+//   Author:	Mark Tompkins
+//   Revision:	4906.24976
+//   Copyright:	(c)2013
+//
\ No newline at end of file
@@ -0,0 +1,202 @@
+// bollNan.cpp
+// Localized compiling: cl /O2 /EHsc /I.. bollNan.cpp ..\bollEngine.cpp
+//						g++ -O2 -I.. bollNan.cpp ../bollEngine.cpp -o bollNan
+//
+// Regression test of bollKernel with NaN prices.  Each case places NaNs in an otherwise clean series and runs
+// every midline type over both.  A bar whose window (or filter) holds a NaN must be NaN.  Every other bar must
+// match the clean series, which shows the rolling state has recovered once the NaNs rolled out.  The exponential
+// midline remembers every price, so outside the NaN windows it need only be finite.
+//
+// Usage:	bollNan
+//			Returns 0 when every case passes, 1 otherwise.
+
+#include <cstdio>
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "bollEngine.h"
+
+using namespace std;
+
+// Prototypes
+bool runCase(const char *name, const vector<double> &clean, const vector<int> &nanBars, int period);
+void runKernel(const vector<double> &price, int period, double maType, vector<double> &lBand, vector<double> &mAvg,
+	vector<double> &uBand);
+bool sameValue(double x, double y);
+
+int main()
+{
+	int rows = 3000;
+	int period = 20;
+	int numBad = 0;
+
+	vector<double> clean(rows);
+	for (int ii = 0; ii < rows; ii++)
+	{
+		clean[ii] = 1000 + 50 * sin(ii * 0.013) + (ii * 7919 % 97) * 0.1;
+	}
+
+	vector<int> nanBars(1, 0);
+	numBad += !runCase("leading NaN", clean, nanBars, period);
+
+	nanBars.assign(1, 500);
+	nanBars.push_back(501);
+	nanBars.push_back(502);
+	numBad += !runCase("run of NaNs", clean, nanBars, period);
+
+	// Overlapping windows, the last NaN leaving on a resync bar
+	nanBars.assign(1, 1000);
+	nanBars.push_back(1010);
+	nanBars.push_back(1024 - period);
+	numBad += !runCase("overlapping NaN windows", clean, nanBars, period);
+
+	nanBars.assign(1, rows - 1);
+	numBad += !runCase("NaN on the last observation", clean, nanBars, period);
+
+	printf("%d failed\n", numBad);
+
+	return numBad == 0 ? 0 : 1;
+}
+
+/////////////
+//
+// FUNCTIONS & METHODS
+//
+/////////////
+
+// Every midline type over the clean series and the series with NaNs at 'nanBars'
+bool runCase(const char *name, const vector<double> &clean, const vector<int> &nanBars, int period)
+{
+	int rows = int(clean.size());
+	double maTypes[] = {0, -1, -2, -3, -4, -5, 1, 2};
+	int numTypes = sizeof(maTypes) / sizeof(maTypes[0]);
+	bool pass = true;
+
+	vector<double> price(clean);
+	for (size_t nn = 0; nn < nanBars.size(); nn++)
+	{
+		price[nanBars[nn]] = std::numeric_limits<double>::quiet_NaN();
+	}
+
+	vector<double> weights(period + 1);
+
+	for (int tt = 0; tt < numTypes; tt++)
+	{
+		// Bars of price used by one output: the window, or the filter if it is longer
+		int span = bollWeights(period, maTypes[tt], &weights[0]);
+		if (span < period)
+			span = period;
+
+		vector<double> lClean, mClean, uClean, lBand, mAvg, uBand;
+		runKernel(clean, period, maTypes[tt], lClean, mClean, uClean);
+		runKernel(price, period, maTypes[tt], lBand, mAvg, uBand);
+
+		for (int ii = 0; ii < rows; ii++)
+		{
+			bool hasNan = false;
+			for (int jj = (ii - span + 1 > 0 ? ii - span + 1 : 0); jj <= ii; jj++)
+			{
+				hasNan = hasNan || std::isnan(price[jj]);
+			}
+
+			if (ii < period || hasNan)
+			{
+				if (!std::isnan(mAvg[ii]) || !std::isnan(lBand[ii]) || !std::isnan(uBand[ii]))
+					pass = false;
+			}
+			else if (maTypes[tt] == -1)
+			{
+				if (!std::isfinite(mAvg[ii]) || !std::isfinite(lBand[ii]) || !std::isfinite(uBand[ii]))
+					pass = false;
+			}
+			else if (!sameValue(mAvg[ii], mClean[ii]) || !sameValue(lBand[ii], lClean[ii]) ||
+				!sameValue(uBand[ii], uClean[ii]))
+			{
+				pass = false;
+			}
+		}
+	}
+
+	printf("%-40s %s\n", name, pass ? "ok" : "FAILED");
+
+	return pass;
+}
+
+// A single instrument and a single (2, 2) band pair
+void runKernel(const vector<double> &price, int period, double maType, vector<double> &lBand, vector<double> &mAvg,
+	vector<double> &uBand)
+{
+	int rows = int(price.size());
+	double devUp = 2, devDwn = 2;
+
+	vector<double> weights(period + 1), window(period);
+	int numWeights = bollWeights(period, maType, &weights[0]);
+
+	lBand.assign(rows, 0);
+	mAvg.assign(rows, 0);
+	uBand.assign(rows, 0);
+
+	bollKernel(&price[0], rows, period, maType, &weights[0], numWeights, &devUp, &devDwn, 1, 1, 1,
+		maType == -4 ? &window[0] : NULL, &lBand[0], &mAvg[0], &uBand[0], rows);
+}
+
+// Equal to within the rounding of the rolling moments
+bool sameValue(double x, double y)
+{
+	return fabs(x - y) <= 1e-9 * (fabs(y) > 1 ? fabs(y) : 1);
+}
+//
+//  -------------------------------------------------------------------------
+//                                  _    _ 
+//         ___  _ __   ___ _ __    / \  | | __ _  ___   ___  _ __ __ _ 
+//        / _ \| '_ \ / _ \ '_ \  / _ \ | |/ _` |/ _ \ / _ \| '__/ _` |
+//       | (_) | |_) |  __/ | | |/ ___ \| | (_| | (_) | (_) | | | (_| |
+//        \___/| .__/ \___|_| |_/_/   \_\_|\__, |\___(_)___/|_|  \__, |
+//             |_|                         |___/                 |___/
+//  -------------------------------------------------------------------------
+//        This code is distributed in the hope that it will be useful,
+//
+//                      	   WITHOUT ANY WARRANTY
+//
+//                  WITHOUT CLAIM AS TO MERCHANTABILITY
+//
+//                  OR FITNESS FOR A PARTICULAR PURPOSE
+//
+//                          expressed or implied.
+//
+//   Use of this code, pseudocode, algorithmic or trading logic contained
+//   herein, whether sound or faulty for any purpose is the sole
+//   responsibility of the USER. Any such use of these algorithms, coding
+//   logic or concepts in whole or in part carry no covenant of correctness
+//   or recommended usage from the AUTHOR or any of the possible
+//   contributors listed or unlisted, known or unknown.
+//
+//   Any reference of this code or to this code including any variants from
+//   this code, or any other credits due this AUTHOR from this code shall be
+//   clearly and unambiguously cited and evident during any use, whether in
+//   whole or in part.
+//
+//   The public sharing of this code does not relinquish, reduce, restrict or
+//   encumber any rights the AUTHOR has in respect to claims of intellectual
+//   property.
+//
+//   IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY
+//   DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+//   OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+//   STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//   ANY WAY OUT OF THE USE OF THIS SOFTWARE, CODE, OR CODE FRAGMENT(S), EVEN
+//   IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//   -------------------------------------------------------------------------
+//
+//                             ALL RIGHTS RESERVED
+//
+//   -------------------------------------------------------------------------
+//
+//   Author:	Mark Tompkins
+//   Revision:	4906.24976
+//   Copyright:	(c)2013
+//
\ No newline at end of file
@@ -0,0 +1,185 @@
+// numTicksEdges.cpp
+// Localized compiling: cl /O2 /EHsc /I.. numTicksEdges.cpp ..\numTicksEngine.cpp ..\myMath.cpp
+//						g++ -O2 -I.. numTicksEdges.cpp ../numTicksEngine.cpp ../myMath.cpp -o numTicksEdges
+//						(add -fsanitize=address to catch writes beyond the outputs)
+//
+// Regression test of numTicksEngine at the ends of a history.  A signal is executed at the following open, so a
+// signal on the last observation is never a trade and no fill may be placed beyond the last observation.
+// Each case is run as a sweep (as numTicksProfit does for a vector of targets) into outputs of exactly
+// rows x K, and as a single target run with the virtual bars inserted.
+//
+// Usage:	numTicksEdges
+//			Returns 0 when every case passes, 1 otherwise.
+
+#include <cstdio>
+#include <vector>
+#include "numTicksEngine.h"
+
+using namespace std;
+
+// Prototypes
+bool runCase(const char *name, const vector<double> &bars, const vector<double> &sig, int expectProfits);
+
+int main()
+{
+	int rows = 6;
+	int numBad = 0;
+
+	// Open | High | Low | Close of a market that travels well beyond every target.  The first observation
+	// closes far below the rest so a read past the last observation (into the next column) would take a profit.
+	double opens[]	= {100, 101, 102, 103, 104, 105};
+	double highs[]	= {101, 103, 104, 105, 106, 110};
+	double lows[]	= { 95,  96,  97,  98,  99,  90};
+	double closes[]	= { 80, 102, 103, 104, 105, 106};
+
+	vector<double> bars(rows * 4);
+	for (int ii = 0; ii < rows; ii++)
+	{
+		bars[ii] = opens[ii];
+		bars[ii + rows] = highs[ii];
+		bars[ii + 2 * rows] = lows[ii];
+		bars[ii + 3 * rows] = closes[ii];
+	}
+
+	// The only signal is on the last observation.  Nothing is traded.
+	vector<double> sig(rows, 0);
+	sig[rows - 1] = -1;
+	numBad += !runCase("signal on the last observation", bars, sig, 0);
+
+	// The first trade is filled on the last observation.  Its profit fills on the last observation too.
+	sig.assign(rows, 0);
+	sig[rows - 2] = -1;
+	numBad += !runCase("trade filled on the last observation", bars, sig, 1);
+
+	// An open position reversed on the last observation.  The reversal is never executed.
+	sig.assign(rows, 0);
+	sig[0] = 1;
+	sig[rows - 1] = -2;
+	numBad += !runCase("reversal on the last observation", bars, sig, 1);
+
+	printf("%d failed\n", numBad);
+
+	return numBad == 0 ? 0 : 1;
+}
+
+/////////////
+//
+// FUNCTIONS & METHODS
+//
+/////////////
+
+// Sweep of targets 1, 2 and 3 (fixed point and floating point) and a single target run
+bool runCase(const char *name, const vector<double> &bars, const vector<double> &sig, int expectProfits)
+{
+	int rows = int(sig.size());
+	double targets[] = {1, 2, 3};
+	int numTgts = 3;
+	bool pass = true;
+
+	for (int fixedPoint = 0; fixedPoint < 2; fixedPoint++)
+	{
+		numTicksEngine shared(&bars[0], &sig[0], rows, 1, targets[0], false, fixedPoint != 0);
+		vector<numTicksEngine> engines;
+		for (int tgt = 0; tgt < numTgts; tgt++)
+		{
+			engines.push_back(numTicksEngine(shared, targets[tgt]));
+		}
+
+		// Outputs of exactly rows x K
+		vector<double> pftSig(rows * numTgts, 0), pftPrice(rows * numTgts, 0);
+		vector<double> stopSig(rows * numTgts, 0), stopPrice(rows * numTgts, 0);
+		double badSig = 0;
+
+		for (int tgt = 0; tgt < numTgts; tgt++)
+		{
+			if (!engines[tgt].start())
+				continue;
+
+			for (int curBar = engines[tgt].firstBar(); curBar < rows - 1; curBar++)
+			{
+				if (!engines[tgt].step(curBar, badSig))
+					pass = false;
+			}
+			engines[tgt].finish();
+			engines[tgt].getProfits(&pftSig[tgt * rows], &pftPrice[tgt * rows], &stopSig[tgt * rows], &stopPrice[tgt * rows]);
+
+			if (engines[tgt].numProfits() != expectProfits)
+				pass = false;
+		}
+
+		if (expectProfits == 0)
+		{
+			for (int idx = 0; idx < rows * numTgts; idx++)
+			{
+				if (pftSig[idx] != 0 || pftPrice[idx] != 0)
+					pass = false;
+			}
+		}
+
+		// Single target with the virtual bars inserted
+		numTicksEngine engine(&bars[0], &sig[0], rows, 1, targets[0], false, fixedPoint != 0);
+		if (!engine.run(badSig) || engine.numProfits() != expectProfits)
+			pass = false;
+
+		vector<double> barsOut((rows + engine.numProfits()) * 4), sigOut(rows + engine.numProfits());
+		engine.getOutput(&barsOut[0], &sigOut[0]);
+	}
+
+	printf("%-40s %s\n", name, pass ? "ok" : "FAILED");
+
+	return pass;
+}
+//
+//  -------------------------------------------------------------------------
+//                                  _    _ 
+//         ___  _ __   ___ _ __    / \  | | __ _  ___   ___  _ __ __ _ 
+//        / _ \| '_ \ / _ \ '_ \  / _ \ | |/ _` |/ _ \ / _ \| '__/ _` |
+//       | (_) | |_) |  __/ | | |/ ___ \| | (_| | (_) | (_) | | | (_| |
+//        \___/| .__/ \___|_| |_/_/   \_\_|\__, |\___(_)___/|_|  \__, |
+//             |_|                         |___/                 |___/
+//  -------------------------------------------------------------------------
+//        This code is distributed in the hope that it will be useful,
+//
+//                      	   WITHOUT ANY WARRANTY
+//
+//                  WITHOUT CLAIM AS TO MERCHANTABILITY
+//
+//                  OR FITNESS FOR A PARTICULAR PURPOSE
+//
+//                          expressed or implied.
+//
+//   Use of this code, pseudocode, algorithmic or trading logic contained
+//   herein, whether sound or faulty for any purpose is the sole
+//   responsibility of the USER. Any such use of these algorithms, coding
+//   logic or concepts in whole or in part carry no covenant of correctness
+//   or recommended usage from the AUTHOR or any of the possible
+//   contributors listed or unlisted, known or unknown.
+//
+//   Any reference of this code or to this code including any variants from
+//   this code, or any other credits due this AUTHOR from this code shall be
+//   clearly and unambiguously cited and evident during any use, whether in
+//   whole or in part.
+//
+//   The public sharing of this code does not relinquish, reduce, restrict or
+//   encumber any rights the AUTHOR has in respect to claims of intellectual
+//   property.
+//
+//   IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY
+//   DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+//   OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+//   STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//   ANY WAY OUT OF THE USE OF THIS SOFTWARE, CODE, OR CODE FRAGMENT(S), EVEN
+//   IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//   -------------------------------------------------------------------------
+//
+//                             ALL RIGHTS RESERVED
+//
+//   -------------------------------------------------------------------------
+//
+//   Author:	Mark Tompkins
+//   Revision:	4906.24976
+//   Copyright:	(c)2013
+//
\ No newline at end of file
@@ -0,0 +1,170 @@
+// numTicksScaling.cpp
+// Localized compiling: cl /O2 /EHsc /openmp /I.. numTicksScaling.cpp ..\numTicksEngine.cpp ..\myMath.cpp
+//						g++ -O2 -fopenmp -I.. numTicksScaling.cpp ../numTicksEngine.cpp ../myMath.cpp -o numTicksScaling
+//
+// Thread scaling of numTicksEngine.  A batch of independent evaluations (one engine each, as a parameter sweep
+// would run them) is timed serially and then across 1, 2, 4 ... threads.  Every parallel run is checked against
+// the serial results so a speedup can not come from shared state.
+//
+// Usage:	numTicksScaling [rows] [engines]		(defaults 100000 and 64)
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <omp.h>
+#include "numTicksEngine.h"
+
+using namespace std;
+
+// Prototypes
+void makeBars(int rows, unsigned int seed, vector<double> &bars, vector<double> &sig);
+double evaluate(const vector<double> &bars, const vector<double> &sig, int rows, double numTicks, bool openAvg);
+
+int main(int argc, char *argv[])
+{
+	int rows = argc > 1 ? atoi(argv[1]) : 100000;
+	int numEngines = argc > 2 ? atoi(argv[2]) : 64;
+
+	vector<double> bars, sig;
+	makeBars(rows, 12345, bars, sig);
+
+	// Serial reference
+	vector<double> reference(numEngines);
+	double start = omp_get_wtime();
+	for (int eng = 0; eng < numEngines; eng++)
+	{
+		reference[eng] = evaluate(bars, sig, rows, 1 + eng % 16, eng % 2 == 1);
+	}
+	double serial = omp_get_wtime() - start;
+
+	printf("%d engines over %d observations\n", numEngines, rows);
+	printf("threads   seconds   speedup   results\n");
+	printf("serial  %9.3f   %7.2f   reference\n", serial, 1.0);
+
+	for (int threads = 1; threads <= omp_get_max_threads(); threads = threads * 2)
+	{
+		vector<double> result(numEngines);
+
+		start = omp_get_wtime();
+#pragma omp parallel for schedule(dynamic) num_threads(threads)
+		for (int eng = 0; eng < numEngines; eng++)
+		{
+			result[eng] = evaluate(bars, sig, rows, 1 + eng % 16, eng % 2 == 1);
+		}
+		double elapsed = omp_get_wtime() - start;
+
+		int mismatch = 0;
+		for (int eng = 0; eng < numEngines; eng++)
+		{
+			if (result[eng] != reference[eng]) mismatch++;
+		}
+
+		printf("%7d %9.3f   %7.2f   %s\n", threads, elapsed, serial / elapsed, mismatch == 0 ? "identical" : "MISMATCH");
+		if (mismatch != 0)
+			return 1;
+	}
+
+	return 0;
+}
+
+/////////////
+//
+// FUNCTIONS & METHODS
+//
+/////////////
+
+// Random walk Open | High | Low | Close on a quarter tick with sparse +/- 1 | 2 lot signals
+void makeBars(int rows, unsigned int seed, vector<double> &bars, vector<double> &sig)
+{
+	srand(seed);
+	bars.assign(rows * 4, 0);
+	sig.assign(rows, 0);
+
+	long long price = 4000;
+	for (int ii = 0; ii < rows; ii++)
+	{
+		long long open = price + rand() % 9 - 4;
+		long long close = open + rand() % 9 - 4;
+		bars[ii] = open * 0.25;
+		bars[ii + rows] = ((open > close ? open : close) + rand() % 5) * 0.25;
+		bars[ii + 2 * rows] = ((open < close ? open : close) - rand() % 5) * 0.25;
+		bars[ii + 3 * rows] = close * 0.25;
+		price = close;
+
+		int draw = rand() % 12;
+		sig[ii] = draw == 0 ? 1 : draw == 1 ? -1 : draw == 2 ? 2 : draw == 3 ? -2 : 0;
+	}
+}
+
+// One evaluation.  The checksum covers every profit quantity and price.
+double evaluate(const vector<double> &bars, const vector<double> &sig, int rows, double numTicks, bool openAvg)
+{
+	numTicksEngine engine(&bars[0], &sig[0], rows, 0.25, numTicks, openAvg, true);
+	double badSig = 0;
+	if (!engine.run(badSig))
+		return -1;
+
+	vector<double> barsOut((rows + engine.numProfits()) * 4), sigOut(rows + engine.numProfits());
+	engine.getOutput(&barsOut[0], &sigOut[0]);
+
+	double checksum = engine.numProfits();
+	for (int ii = 0; ii < (int)sigOut.size(); ii++)
+	{
+		checksum = checksum + sigOut[ii] * barsOut[ii] * (ii % 7 + 1);
+	}
+	return checksum;
+}
+//
+//  -------------------------------------------------------------------------
+//                                  _    _ 
+//         ___  _ __   ___ _ __    / \  | | __ _  ___   ___  _ __ __ _ 
+//        / _ \| '_ \ / _ \ '_ \  / _ \ | |/ _` |/ _ \ / _ \| '__/ _` |
+//       | (_) | |_) |  __/ | | |/ ___ \| | (_| | (_) | (_) | | | (_| |
+//        \___/| .__/ \___|_| |_/_/   \_\_|\__, |\___(_)___/|_|  \__, |
+//             |_|                         |___/                 |___/
+//  -------------------------------------------------------------------------
+//        This code is distributed in the hope that it will be useful,
+//
+//                      	   WITHOUT ANY WARRANTY
+//
+//                  WITHOUT CLAIM AS TO MERCHANTABILITY
+//
+//                  OR FITNESS FOR A PARTICULAR PURPOSE
+//
+//                          expressed or implied.
+//
+//   Use of this code, pseudocode, algorithmic or trading logic contained
+//   herein, whether sound or faulty for any purpose is the sole
+//   responsibility of the USER. Any such use of these algorithms, coding
+//   logic or concepts in whole or in part carry no covenant of correctness
+//   or recommended usage from the AUTHOR or any of the possible
+//   contributors listed or unlisted, known or unknown.
+//
+//   Any reference of this code or to this code including any variants from
+//   this code, or any other credits due this AUTHOR from this code shall be
+//   clearly and unambiguously cited and evident during any use, whether in
+//   whole or in part.
+//
+//   The public sharing of this code does not relinquish, reduce, restrict or
+//   encumber any rights the AUTHOR has in respect to claims of intellectual
+//   property.
+//
+//   IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY
+//   DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+//   OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+//   STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//   ANY WAY OUT OF THE USE OF THIS SOFTWARE, CODE, OR CODE FRAGMENT(S), EVEN
+//   IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//   -------------------------------------------------------------------------
+//
+//                             ALL RIGHTS RESERVED
+//
+//   -------------------------------------------------------------------------
+//
+//   Author:	Mark Tompkins
+//   Revision:	4906.24976
+//   Copyright:	(c)2013
+//
\ No newline at end of file
@@ -0,0 +1,248 @@
+// rsiBench.cpp
+// Localized compiling: cl /O2 /EHsc /I.. rsiBench.cpp ..\rsiEngine.cpp
+//						g++ -O2 -I.. rsiBench.cpp ../rsiEngine.cpp -o rsiBench
+//
+// Timing of relStrIdx.  The multi-pass calculation relStrIdx used before rsiKernel (advances and declines, then the
+// averages, then the RSI, each into a full length temporary) is timed against rsiKernel on the same prices, first
+// for a single lookback and then for a sweep of K lookbacks (the multi-pass calculation is called once per lookback).
+// Each timing is the best of several repetitions.  The largest difference between the two results is reported.
+//
+// Usage:	rsiBench [rows] [K]		(defaults 2000000 and 20)
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <ctime>
+#include <limits>
+#include <vector>
+#include "rsiEngine.h"
+
+using namespace std;
+
+#define REPS	5
+
+// Prototypes
+void rsiMultiPass(const double *barsInPtr, int rowsData, int obsvIn, double *RSI);
+double maxDiff(const vector<double> &x, const vector<double> &y);
+double seconds(clock_t start);
+
+int main(int argc, char *argv[])
+{
+	int rows = argc > 1 ? atoi(argv[1]) : 2000000;
+	int numObsv = argc > 2 ? atoi(argv[2]) : 20;
+
+	// Random walk
+	srand(12345);
+	vector<double> prices(rows);
+	double price = 1000;
+	for (int ii = 0; ii < rows; ii++)
+	{
+		price = price + (rand() % 201 - 100) * 0.01;
+		prices[ii] = price;
+	}
+
+	// Lookbacks 5, 10, 15 ...
+	vector<double> obsvIn(numObsv);
+	for (int kk = 0; kk < numObsv; kk++)
+	{
+		obsvIn[kk] = 5 * (kk + 1);
+	}
+
+	printf("%d observations\n", rows);
+	printf("lookbacks   multi-pass   rsiKernel   speedup   max difference\n");
+
+	for (int sweep = 0; sweep < 2; sweep++)
+	{
+		// A single lookback of 14, then the sweep
+		double single = 14;
+		int K = sweep == 0 ? 1 : numObsv;
+		double *lookbacks = sweep == 0 ? &single : &obsvIn[0];
+		int maxObsv = int(lookbacks[K - 1]);
+
+		vector<double> multiPass(size_t(rows) * K), kernel(size_t(rows) * K);
+		vector<double> scratch(2 * K + 2 + 3 * K);
+		double bestMulti = HUGE_VAL, bestKernel = HUGE_VAL;
+
+		for (int rep = 0; rep < REPS; rep++)
+		{
+			clock_t start = clock();
+			for (int kk = 0; kk < K; kk++)
+			{
+				rsiMultiPass(&prices[0], rows, int(lookbacks[kk]), &multiPass[size_t(kk) * rows]);
+			}
+			double elapsed = seconds(start);
+			if (elapsed < bestMulti) bestMulti = elapsed;
+
+			start = clock();
+			rsiKernel(&prices[0], rows, 1, lookbacks, K, maxObsv, &scratch[0], &kernel[0], rows);
+			elapsed = seconds(start);
+			if (elapsed < bestKernel) bestKernel = elapsed;
+		}
+
+		printf("%9d   %8.1f ms   %6.1f ms   %7.2f   %g\n", K, bestMulti * 1000, bestKernel * 1000,
+			bestMulti / bestKernel, maxDiff(multiPass, kernel));
+	}
+
+	return 0;
+}
+
+/////////////
+//
+// FUNCTIONS & METHODS
+//
+/////////////
+
+// relStrIdx as it was: three passes over full length temporaries
+void rsiMultiPass(const double *barsInPtr, int rowsData, int obsvIn, double *RSI)
+{
+	double m_Nan = std::numeric_limits<double>::quiet_NaN(); 
+
+	double *advances = new double[rowsData];
+	double *declines = new double[rowsData];
+	double *avgGain = new double[rowsData];
+	double *avgLoss = new double[rowsData];
+
+	// Calculate advances & declines
+	advances[0] = 0;
+	declines[0] = 0;
+
+	for (int ii=1;ii != rowsData; ii++)
+	{
+		if (barsInPtr[ii] - barsInPtr[ii-1] > 0)
+		{
+			advances[ii] = fabs(barsInPtr[ii] - barsInPtr[ii-1]);
+			declines[ii] = 0;
+		}
+		else
+		{
+			advances[ii] = 0;
+			declines[ii] = fabs(barsInPtr[ii] - barsInPtr[ii-1]);
+		}
+	}
+
+	// Calculate avgGains & avgLosses
+	for (int ii = (obsvIn); ii != rowsData; ii++)
+	{
+		if (ii == (obsvIn))
+		{
+			double sumAdv = 0;
+			double sumDec = 0;
+
+			for (int jj = 0; jj != obsvIn; jj++)
+			{
+				sumAdv = sumAdv + advances[ii-jj];
+				sumDec = sumDec + declines[ii-jj];
+			}
+
+			avgGain[ii] = sumAdv / obsvIn;
+			avgLoss[ii] = sumDec / obsvIn;
+		}
+		else
+		{
+			avgGain[ii] = ((avgGain[ii-1] * (obsvIn - 1)) + advances[ii]) / obsvIn;
+			avgLoss[ii] = ((avgLoss[ii-1] * (obsvIn - 1)) + declines[ii]) / obsvIn;
+		}
+	}
+
+	// Assign RSI values to output array
+	for (int ii = 0; ii != rowsData; ii++)
+	{
+		if (ii < (obsvIn))
+		{
+			RSI[ii] = m_Nan;
+		}
+		else
+		{
+			if (avgLoss[ii] == 0)
+			{
+				RSI[ii] = 100;
+			}
+			else
+			{
+				RSI[ii] = 100 - (100 / (1 + avgGain[ii] / avgLoss[ii]));
+			}
+		}
+	}
+
+	delete []advances;
+	delete []declines;
+	delete []avgGain;
+	delete []avgLoss;
+}
+
+// Largest absolute difference.  NaN must match NaN.
+double maxDiff(const vector<double> &x, const vector<double> &y)
+{
+	double diff = 0;
+	for (size_t idx = 0; idx < x.size(); idx++)
+	{
+		if (x[idx] != x[idx] || y[idx] != y[idx])
+		{
+			if (!(x[idx] != x[idx] && y[idx] != y[idx]))
+				return numeric_limits<double>::quiet_NaN();
+			continue;
+		}
+		if (fabs(x[idx] - y[idx]) > diff)
+			diff = fabs(x[idx] - y[idx]);
+	}
+	return diff;
+}
+
+double seconds(clock_t start)
+{
+	return double(clock() - start) / CLOCKS_PER_SEC;
+}
+//
+//  -------------------------------------------------------------------------
+//                                  _    _ 
+//         ___  _ __   ___ _ __    / \  | | __ _  ___   ___  _ __ __ _ 
+//        / _ \| '_ \ / _ \ '_ \  / _ \ | |/ _` |/ _ \ / _ \| '__/ _` |
+//       | (_) | |_) |  __/ | | |/ ___ \| | (_| | (_) | (_) | | | (_| |
+//        \___/| .__/ \___|_| |_/_/   \_\_|\__, |\___(_)___/|_|  \__, |
+//             |_|                         |___/                 |___/
+//  -------------------------------------------------------------------------
+//        This code is distributed in the hope that it will be useful,
+//
+//                      	   WITHOUT ANY WARRANTY
+//
+//                  WITHOUT CLAIM AS TO MERCHANTABILITY
+//
+//                  OR FITNESS FOR A PARTICULAR PURPOSE
+//
+//                          expressed or implied.
+//
+//   Use of this code, pseudocode, algorithmic or trading logic contained
+//   herein, whether sound or faulty for any purpose is the sole
+//   responsibility of the USER. Any such use of these algorithms, coding
+//   logic or concepts in whole or in part carry no covenant of correctness
+//   or recommended usage from the AUTHOR or any of the possible
+//   contributors listed or unlisted, known or unknown.
+//
+//   Any reference of this code or to this code including any variants from
+//   this code, or any other credits due this AUTHOR from this code shall be
+//   clearly and unambiguously cited and evident during any use, whether in
+//   whole or in part.
+//
+//   The public sharing of this code does not relinquish, reduce, restrict or
+//   encumber any rights the AUTHOR has in respect to claims of intellectual
+//   property.
+//
+//   IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY
+//   DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+//   OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+//   STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//   ANY WAY OUT OF THE USE OF THIS SOFTWARE, CODE, OR CODE FRAGMENT(S), EVEN
+//   IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//   -------------------------------------------------------------------------
+//
+//                             ALL RIGHTS RESERVED
+//
+//   -------------------------------------------------------------------------
+//
+//   Author:	Mark Tompkins
+//   Revision:	4906.24976
+//   Copyright:	(c)2013
+//
\ No newline at end of file
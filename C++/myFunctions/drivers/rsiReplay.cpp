@@ -0,0 +1,214 @@
+// rsiReplay.cpp
+// Localized compiling: cl /O2 /EHsc /I.. rsiReplay.cpp ..\rsiEngine.cpp
+//						g++ -O2 -I.. rsiReplay.cpp ../rsiEngine.cpp -o rsiReplay
+//
+// Regression test of rsiEngine against the batch kernel of relStrIdx.  Random walks of several instruments are
+// run through rsiKernel for a set of lookbacks, then replayed one bar at a time through an rsiEngine per
+// instrument and lookback.  Half way through every engine is saved with getState, reset, and restored with
+// setState so a persisted state is covered.  The replay must be bit-identical to the batch result, NaN for NaN.
+//
+// Usage:	rsiReplay [rows] [instruments]		(defaults 5000 and 11)
+//			Returns 0 when every value matches, 1 otherwise.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include "rsiEngine.h"
+
+using namespace std;
+
+// Prototypes
+void makePrices(int rows, int cols, unsigned int seed, vector<double> &prices);
+bool sameValue(double x, double y);
+
+int main(int argc, char *argv[])
+{
+	int rows = argc > 1 ? atoi(argv[1]) : 5000;
+	int cols = argc > 2 ? atoi(argv[2]) : 11;
+
+	// Includes a lookback of 1, a lookback equal to the number of rows and a duplicate
+	double lookbacks[] = {1, 2, 14, 14, 30, 250};
+	int numObsv = sizeof(lookbacks) / sizeof(lookbacks[0]);
+	vector<double> obsvIn(lookbacks, lookbacks + numObsv);
+	obsvIn.push_back(rows);
+	numObsv++;
+
+	int maxObsv = 0;
+	for (int kk = 0; kk < numObsv; kk++)
+	{
+		if (obsvIn[kk] > rows)
+		{
+			printf("A lookback of %g is greater than the %d rows. Aborting.\n", obsvIn[kk], rows);
+			return 1;
+		}
+		if (obsvIn[kk] > maxObsv)
+		{
+			maxObsv = int(obsvIn[kk]);
+		}
+	}
+
+	vector<double> prices;
+	makePrices(rows, cols, 12345, prices);
+
+	/////////////
+	// START
+	/////////////
+
+	// Batch
+	int lookbackStride = rows * cols;
+	vector<double> batch(size_t(lookbackStride) * numObsv);
+	vector<double> scratch(cols * (2 * numObsv + 2) + 3 * numObsv);
+	rsiKernel(&prices[0], rows, cols, &obsvIn[0], numObsv, maxObsv, &scratch[0], &batch[0], lookbackStride);
+
+	// Replay
+	vector<double> replay(batch.size());
+	int saveBar = rows / 2;
+	for (int mm = 0; mm < cols; mm++)
+	{
+		for (int kk = 0; kk < numObsv; kk++)
+		{
+			rsiEngine engine(int(obsvIn[kk]));
+			double *out = &replay[mm * rows + kk * lookbackStride];
+
+			for (int ii = 0; ii < rows; ii++)
+			{
+				if (ii == saveBar)
+				{
+					rsiState saved = engine.getState();
+					engine.reset();
+					engine.setState(saved);
+				}
+
+				out[ii] = engine.update(prices[ii + mm * rows]);
+			}
+		}
+	}
+
+	// Compare
+	int numBad = 0;
+	for (size_t idx = 0; idx < batch.size(); idx++)
+	{
+		if (!sameValue(batch[idx], replay[idx]))
+		{
+			if (numBad < 10)
+			{
+				int kk = int(idx / lookbackStride);
+				int mm = int((idx % lookbackStride) / rows);
+				int ii = int(idx % rows);
+				printf("Mismatch: bar %d instrument %d lookback %g  batch %.17g  replay %.17g\n",
+					ii, mm, obsvIn[kk], batch[idx], replay[idx]);
+			}
+			numBad++;
+		}
+	}
+
+	/////////////
+	// FINISHED
+	/////////////
+
+	printf("%d rows, %d instruments, %d lookbacks: %d mismatches\n", rows, cols, numObsv, numBad);
+
+	return numBad == 0 ? 0 : 1;
+}
+
+/////////////
+//
+// FUNCTIONS & METHODS
+//
+/////////////
+
+// Random walks with flat stretches so zero changes and zero average losses are exercised
+void makePrices(int rows, int cols, unsigned int seed, vector<double> &prices)
+{
+	srand(seed);
+	prices.resize(size_t(rows) * cols);
+
+	for (int mm = 0; mm < cols; mm++)
+	{
+		double price = 100 + mm;
+		for (int ii = 0; ii < rows; ii++)
+		{
+			int draw = rand() % 10;
+			if (draw < 2)
+			{
+				// Unchanged
+			}
+			else if (draw < 6)
+			{
+				price = price + (rand() % 100) * 0.01;
+			}
+			else
+			{
+				price = price - (rand() % 100) * 0.01;
+			}
+			prices[ii + mm * rows] = price;
+		}
+	}
+}
+
+// Bit-identical, treating NaN as equal to NaN
+bool sameValue(double x, double y)
+{
+	if (x != x || y != y)
+	{
+		return x != x && y != y;
+	}
+
+	return memcmp(&x, &y, sizeof(double)) == 0;
+}
+//
+//  -------------------------------------------------------------------------
+//                                  _    _ 
+//         ___  _ __   ___ _ __    / \  | | __ _  ___   ___  _ __ __ _ 
+//        / _ \| '_ \ / _ \ '_ \  / _ \ | |/ _` |/ _ \ / _ \| '__/ _` |
+//       | (_) | |_) |  __/ | | |/ ___ \| | (_| | (_) | (_) | | | (_| |
+//        \___/| .__/ \___|_| |_/_/   \_\_|\__, |\___(_)___/|_|  \__, |
+//             |_|                         |___/                 |___/
+//  -------------------------------------------------------------------------
+//        This code is distributed in the hope that it will be useful,
+//
+//                      	   WITHOUT ANY WARRANTY
+//
+//                  WITHOUT CLAIM AS TO MERCHANTABILITY
+//
+//                  OR FITNESS FOR A PARTICULAR PURPOSE
+//
+//                          expressed or implied.
+//
+//   Use of this code, pseudocode, algorithmic or trading logic contained
+//   herein, whether sound or faulty for any purpose is the sole
+//   responsibility of the USER. Any such use of these algorithms, coding
+//   logic or concepts in whole or in part carry no covenant of correctness
+//   or recommended usage from the AUTHOR or any of the possible
+//   contributors listed or unlisted, known or unknown.
+//
+//   Any reference of this code or to this code including any variants from
+//   this code, or any other credits due this AUTHOR from this code shall be
+//   clearly and unambiguously cited and evident during any use, whether in
+//   whole or in part.
+//
+//   The public sharing of this code does not relinquish, reduce, restrict or
+//   encumber any rights the AUTHOR has in respect to claims of intellectual
+//   property.
+//
+//   IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY
+//   DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+//   OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+//   STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//   ANY WAY OUT OF THE USE OF THIS SOFTWARE, CODE, OR CODE FRAGMENT(S), EVEN
+//   IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//   -------------------------------------------------------------------------
+//
+//                             ALL RIGHTS RESERVED
+//
+//   -------------------------------------------------------------------------
+//
+//   Author:	Mark Tompkins
+//   Revision:	4906.24976
+//   Copyright:	(c)2013
+//
\ No newline at end of file
@@ -1,4 +1,4 @@
-
+#include <cmath>
 
 // Return true if given variable has a fractional component.
 bool fraction(double num)
@@ -17,6 +17,26 @@ double sign(double num)
 	return num > 0 ? 1 : (num < 0 ? -1 : 0);
 }
 
+// Return a price as a whole number of minimum tick increments
+// e.g. priceToTicks(1234.75, 0.25) = 4939
+long long priceToTicks(double price, double minTick)
+{
+	return (long long)floor(price / minTick + 0.5);
+}
+
+// Return a signal snapped to the nearest half unit when it is within rounding error of one
+// e.g. snapHalf(1.4999999999) = 1.5, snapHalf(0.3) = 0.3
+double snapHalf(double num)
+{
+	double halves = floor(num * 2 + 0.5);
+
+	if (fabs(num * 2 - halves) <= 1e-9)
+	{
+		return halves / 2;
+	}
+	return num;
+}
+
 //
 //  -------------------------------------------------------------------------
 //                                  _    _ 
@@ -7,6 +7,13 @@ double sign(double num);
 // Return true if given variable has a fractional component.
 bool fraction(double num);
 
+// Return a price as a whole number of minimum tick increments
+long long priceToTicks(double price, double minTick);
+
+// Return a signal snapped to the nearest half unit when it is within rounding error of one.
+// Signals that have been through arithmetic (e.g. 1.4999999999) are then recognized exactly.
+double snapHalf(double num);
+
 #endif MYMATH_H 
 
 //
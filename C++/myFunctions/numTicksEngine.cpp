@@ -0,0 +1,995 @@
+// numTicksEngine.cpp
+// See numTicksEngine.h and numTicksProfit.cpp for the signal conventions that are applied
+
+#include <cmath>
+#include <list>
+#include <iterator>
+#include <algorithm>
+#include "numTicksEngine.h"
+#include "myMath.h"
+
+using namespace std;
+
+// Prototypes
+static profitEntry createProfitLedgerEntry(int ID, int qty, double price, bool isStop);
+static void shrinkProfitLedger(ringBuffer<profitEntry> &profitLedger);
+static bool isTrade(double isSig);
+static bool knownAdvSig(double advSig);
+static int sumQty(const ringBuffer<openEntry> &theList);
+
+numTicksEngine::numTicksEngine(const double *barsIn, const double *sigIn, int rows, double minTick, double numTicks,
+	bool openAvg, bool fixedPoint)
+{
+	this->rows = rows;
+	this->minTick = minTick;
+	this->numTicks = numTicks;
+	this->openAvg = openAvg;
+	this->fixedPoint = fixedPoint;
+
+	//	Assign shift variables
+	//	This allows up to properly traverse the mxArray which is in an N x 1 form concatenating all columns
+	shiftOpen = 0;							// used for readability 
+	shiftHigh = rows;
+	shiftLow = 2 * rows;
+	shiftClose = 3 * rows;
+
+	barsInPtr = barsIn;
+	sigInPtr = sigIn;
+	barsRawPtr = barsIn;
+
+	PROFIT_TGT = (minTick * numTicks);
+	priceUnit = 1;
+	setStops(0, 0);
+
+	// Fixed point.  Convert each price to whole ticks once.  Ticks are held as integer valued doubles,
+	// which are exact well beyond any price series, so the profit target logic is shared.
+	if (fixedPoint && minTick > 0)
+	{
+		barsTicks.resize(rows * 4);
+		sigSnapped.resize(rows);
+
+		for (int iter = 0; iter < rows * 4; iter++)
+		{
+			barsTicks[iter] = (double)priceToTicks(barsIn[iter], minTick);
+		}
+		for (int iter = 0; iter < rows; iter++)
+		{
+			sigSnapped[iter] = snapHalf(sigIn[iter]);
+		}
+
+		barsInPtr = &barsTicks[0];
+		sigInPtr = &sigSnapped[0];
+		PROFIT_TGT = floor(numTicks + 0.5);
+		priceUnit = minTick;
+	}
+
+	// Locate the first trade and count the signals once.  Neither depends on the target.
+	for (firstSig = 0; firstSig < rows; firstSig++)					// Remember C++ starts counting at '0'
+	{
+		if (isTrade(sigInPtr[firstSig]))	// See if we have a signal
+		{
+			break;							// Exit the for loop
+		}
+	}
+
+	numSigs = 0;
+	for (int iter = firstSig; iter < rows; iter++)
+	{
+		if (sigInPtr[iter] != 0)
+		{
+			numSigs++;
+		}
+	}
+}
+
+numTicksEngine::numTicksEngine(const numTicksEngine &shared, double numTicks)
+{
+	rows = shared.rows;
+	minTick = shared.minTick;
+	this->numTicks = numTicks;
+	openAvg = shared.openAvg;
+	fixedPoint = shared.fixedPoint;
+
+	shiftOpen = shared.shiftOpen;
+	shiftHigh = shared.shiftHigh;
+	shiftLow = shared.shiftLow;
+	shiftClose = shared.shiftClose;
+
+	// Evaluate on the prices and signals already prepared by 'shared'
+	barsInPtr = shared.barsInPtr;
+	sigInPtr = shared.sigInPtr;
+	barsRawPtr = shared.barsRawPtr;
+	priceUnit = shared.priceUnit;
+	firstSig = shared.firstSig;
+	numSigs = shared.numSigs;
+
+	PROFIT_TGT = (fixedPoint && minTick > 0) ? floor(numTicks + 0.5) : (minTick * numTicks);
+
+	STOP_TGT = shared.STOP_TGT;
+	TRAIL_TGT = shared.TRAIL_TGT;
+	STOP_DIST = shared.STOP_DIST;
+	stopsOn = shared.stopsOn;
+}
+
+void numTicksEngine::setStops(double stopTicks, double trailTicks)
+{
+	// Distances are in the same units as the prices being evaluated
+	if (fixedPoint && minTick > 0)
+	{
+		STOP_TGT = floor(stopTicks + 0.5);
+		TRAIL_TGT = floor(trailTicks + 0.5);
+	}
+	else
+	{
+		STOP_TGT = minTick * stopTicks;
+		TRAIL_TGT = minTick * trailTicks;
+	}
+
+	stopsOn = (STOP_TGT > 0) || (TRAIL_TGT > 0);
+
+	// A new line item is protected by the nearer of the two
+	STOP_DIST = HUGE_VAL;
+	if (STOP_TGT > 0)
+	{
+		STOP_DIST = STOP_TGT;
+	}
+	if (TRAIL_TGT > 0 && TRAIL_TGT < STOP_DIST)
+	{
+		STOP_DIST = TRAIL_TGT;
+	}
+}
+
+bool numTicksEngine::run(double &badSig)
+{
+	if (!start())
+	{
+		return true;
+	}
+
+	for (int curBar = firstBar(); curBar < rows - 1; curBar++)
+	{
+		if (!step(curBar, badSig))
+		{
+			return false;
+		}
+	}
+
+	finish();
+
+	return true;
+}
+
+bool numTicksEngine::start()
+{
+	// START //
+	openLedger.clear();
+	profitLedger.clear();
+
+	// The first trade was located when the signals were prepared
+	sigIndex = firstSig;
+	bool anyTrades = sigIndex < rows;		// Trade logical
+
+	// If there are no trades or the minTick is zero indicating no profit taking there is nothing to add
+	// A signal on the last observation is never executed (there is no following open) so it is not a trade
+	if (!anyTrades || minTick == 0 || sigIndex >= rows - 1)
+	{
+		return false;
+	}
+
+	/////////////
+	//
+	// FIRST SIGNAL PROCESSING
+	//
+	/////////////	
+
+	// Initialize ledgers for open positions and profits
+	// Every open line item is created by a signal and every profit line item closes an open line item,
+	// so neither ledger can hold more line items than there are signals.  Both share one arena.
+	ledgerArena.resize(numSigs * (sizeof(openEntry) + sizeof(profitEntry)));
+	openLedger.attach((openEntry*)&ledgerArena[0], numSigs);
+	profitLedger.attach((profitEntry*)(&ledgerArena[0] + numSigs * sizeof(openEntry)), numSigs);
+
+	// Put first detected trade on openLedger
+	openLedger.push_back(createOpenLedgerEntry(sigIndex, int(sigInPtr[sigIndex]), barsInPtr[sigIndex + 1 + shiftOpen]));
+
+	// Short signal.  Assign minMax to LOW
+	if (sigInPtr[sigIndex] < 0)		
+	{
+		minMax = barsInPtr[sigIndex + 1 + shiftLow];
+	}
+	// Long signal. Assign minMax to HIGH
+	else if (sigInPtr[sigIndex] > 0)	
+	{
+		minMax = barsInPtr[sigIndex + 1 + shiftHigh];
+	}
+
+	// Check for profit on same observation
+	// 'minMax' has been updated so we can safely call 'sameBarProfitCheck'
+	openPosition = int(sigInPtr[sigIndex]);
+	sameBarProfitCheck(sigIndex, int(sigInPtr[sigIndex]), openPosition, minMax);
+
+	if (TRAIL_TGT > 0)
+	{
+		trailStops(sigIndex);
+	}
+
+	// FIRST BAR END
+
+	return true;
+}
+
+// ITERATE SECTION
+// Advance one observation
+bool numTicksEngine::step(int curBar, double &badSig)
+{
+	// An open at or through a stop fills before the signal is executed
+	if (stopsOn && openPosition != 0)
+	{
+		checkStops(curBar, openPosition, true);
+	}
+
+	// ORDER OF SIGNIFICANCE from a signal with an existing position
+	// REVERSE
+	if (fraction(sigInPtr[curBar]))
+	{
+		// Is fraction the same sign (additive in nature) ?
+		// Additive
+		if (sign(sigInPtr[curBar] == sign(openPosition)))
+		{
+			// Nothing to do with the current logic
+			// The only fraction currently in use is |0.5| to liquidate entire opposing openPosition
+		}
+		// Reductive (liquidate)
+		else
+		{
+			// Adding logic here for prevention of 'other' fractions or surprising inputs
+			if (knownAdvSig(sigInPtr[curBar]))
+			{
+				// Liquidate any open position
+				openLedger.clear();
+				openPosition = 0;
+			}
+			// Unknown advanced instruction
+			else
+			{
+				badSig = sigInPtr[curBar];
+				return false;
+			}
+		}
+	}
+
+	// REDUCE or ADD
+	// Do we have a signal with an integer portion ?
+	if (abs(int(sigInPtr[curBar])) >= 1)
+	{
+		// Signal is reductive
+		if ((int(sigInPtr[curBar]) > 0 && openPosition < 0) || (int(sigInPtr[curBar]) < 0 && openPosition > 0))					
+		{
+			// Signal is effectively a reverse or liquidate
+			if (int(sigInPtr[curBar]) >= openPosition)
+			{
+				openPosition = int(sigInPtr[curBar]) + openPosition;
+				openLedger.clear();
+				if (openPosition != 0)
+				{
+					openLedger.push_back(createOpenLedgerEntry(curBar, openPosition, barsInPtr[curBar + 1 + shiftOpen]));
+				}
+			}
+			else
+			{
+				// How many do we need to reduce by?
+				int needQty = int(sigInPtr[curBar]);
+				// Prepare to iterate until we are satisfied
+				while (needQty !=0)
+				{
+					// Is the current line item quantity larger than what we need?
+					if (abs(openLedger.front().qtyOpen) > needQty)
+					{
+						// Reduce the position size.  We are aggregating so we add (e.g. 5 Purchases + 4 Sales = 1 Long)
+						openLedger.front().qtyOpen = openLedger.front().qtyOpen + needQty;
+						// We are satisfied and don't need any more contracts
+						needQty = 0;
+					}
+					// Current line item quantity is equal to or smaller than what we need.  Process P&L and remove.
+					else
+					{
+						// Reduce needed quantity by what we've been provided
+						needQty = needQty + openLedger.front().qtyOpen;
+						// Remove the line item (FIFO)
+						openLedger.pop_front();
+					}
+				}
+				openPosition = openPosition + int(sigInPtr[curBar]);
+			}
+		}
+		// Signal is additive
+		else
+		{
+			// Before adding, check if the open qualifies to liquidate any existing position
+			if (openPosition != 0)
+			{
+				chkOpenMethod(openPosition, curBar, minMax);
+			}
+			
+			// Process addition
+			// Put trade on openLedger
+			openLedger.push_back(createOpenLedgerEntry(curBar, int(sigInPtr[curBar]), barsInPtr[curBar + 1 + shiftOpen]));
+			openPosition = openPosition + int(sigInPtr[curBar]);
+			sameBarProfitCheck(curBar, int(sigInPtr[curBar]), openPosition, minMax);
+		}
+	}
+	// NONE
+	else
+	{
+		// We can just check against the open and leave the range check for all entries on the openLedger below
+		// Only check if necessary
+		if (openPosition !=0)
+		{
+			chkOpenMethod(openPosition, curBar, minMax);
+		}
+		
+	}
+
+	// Stops within the range fill before any profit target
+	if (stopsOn && openPosition != 0)
+	{
+		checkStops(curBar, openPosition, false);
+	}
+
+	// Check for extremes that result in a profit for any openPosition
+	if (openPosition != 0)
+	{
+		checkMinMax(curBar, openPosition, minMax);
+	}
+
+	if (TRAIL_TGT > 0)
+	{
+		trailStops(curBar);
+	}
+
+	return true;
+}
+
+void numTicksEngine::finish()
+{
+	/////////////
+	//
+	// Consolidate profit line items that share an observation
+	//
+	/////////////
+	shrinkProfitLedger(profitLedger);
+}
+
+void numTicksEngine::getOutput(double *barsOut, double *sigOut)
+{
+	double *barsOutPtr = barsOut;
+	double *sigOutPtr = sigOut;
+
+	// Temporary lists
+	list<double> signals;
+	list<double> vBars;
+
+	// List iterators
+	list<double>::const_iterator signalsIter		= signals.begin();
+	list<double>::const_iterator vBarsIter			= vBars.begin();
+	list<double>::const_iterator vBarsOpenIter		= vBars.begin();
+	list<double>::const_iterator vBarsHighIter		= vBars.begin();
+	list<double>::const_iterator vBarsLowIter		= vBars.begin();
+	list<double>::const_iterator vBarsCloseIter		= vBars.begin();
+
+	// deep copy mxArray --> myDblList
+	// Original prices are returned as given
+	for (int iter = 0; iter < rows * 4; iter++)
+	{
+		vBars.push_back(barsRawPtr[iter]);
+	}
+
+	for (int iter = 0; iter < rows; iter++)
+	{
+		signals.push_back(sigInPtr[iter]);
+	}
+
+	// Inserts based on profitLedger
+	profitEntry *pftIter;
+	int shiftAdd = 0;
+	int lastLoc = 0;
+
+	// Reset pointers
+	signalsIter		= signals.begin();
+	vBarsOpenIter	= vBars.begin();
+	vBarsHighIter	= vBars.begin();
+	vBarsLowIter	= vBars.begin();
+	vBarsCloseIter	= vBars.begin();
+
+	advance(vBarsHighIter, shiftHigh);
+	advance(vBarsLowIter, shiftLow);
+	advance(vBarsCloseIter, shiftClose);
+
+	// Move price pointer to sync with signal pointer (signal lags price by one bar)
+	vBarsOpenIter++;
+	vBarsHighIter++;
+	vBarsLowIter++;
+	vBarsCloseIter++;
+
+	// At this point we should have pointers as
+	// signals[0]
+	// vBarsOpenIter[1]
+	// vBarsHighIter[1 + shiftHigh] ...
+
+	// Because we insert before the current index we move all pointers 'in front' of the insertion point
+	signalsIter++;
+	vBarsOpenIter++;
+	vBarsHighIter++;
+	vBarsLowIter++;
+	vBarsCloseIter++;
+
+	for (int pftLine = 0; pftLine < profitLedger.size(); pftLine++)
+	{
+		pftIter = &profitLedger[pftLine];
+
+		shiftAdd = pftIter->barIndex - lastLoc;
+
+		// Advance the pointers to insert location
+		advance(signalsIter, shiftAdd);
+		advance(vBarsOpenIter, shiftAdd);
+		advance(vBarsHighIter, shiftAdd);
+		advance(vBarsLowIter, shiftAdd);
+		advance(vBarsCloseIter, shiftAdd);
+
+		signals.insert(signalsIter, pftIter->qtyProfit);
+		vBars.insert (vBarsOpenIter,pftIter->profitPrice * priceUnit);
+		vBars.insert (vBarsHighIter,pftIter->profitPrice * priceUnit);
+		vBars.insert (vBarsLowIter,pftIter->profitPrice * priceUnit);
+		vBars.insert (vBarsCloseIter,pftIter->profitPrice * priceUnit);
+
+		lastLoc = pftIter->barIndex;
+	}
+
+	// Reset pointer
+	int outIter = 0;
+
+	for (vBarsIter	= vBars.begin(); vBarsIter != vBars.end(); vBarsIter++)
+	{
+		barsOutPtr[outIter] = *vBarsIter;
+		outIter++;
+	}
+
+	// Reset index
+	outIter = 0;
+	for (signalsIter = signals.begin(); signalsIter != signals.end(); signalsIter++)
+	{
+		sigOutPtr[outIter] = *signalsIter;
+		outIter++;
+	}
+}
+
+void numTicksEngine::getProfits(double *pftSig, double *pftPrice, double *stopSig, double *stopPrice) const
+{
+	// A profit line item for signal 'barIndex' is filled on the following observation
+	// Stop prices are accumulated as value (quantity * price) and averaged below
+	for (int pftLine = 0; pftLine < profitLedger.size(); pftLine++)
+	{
+		const profitEntry &pft = profitLedger[pftLine];
+		int fillBar = pft.barIndex + 1;
+
+		if (fillBar >= rows)
+		{
+			continue;
+		}
+
+		if (pft.isStop)
+		{
+			stopSig[fillBar] = stopSig[fillBar] + pft.qtyProfit;
+			stopPrice[fillBar] = stopPrice[fillBar] + pft.qtyProfit * pft.profitPrice * priceUnit;
+		}
+		else
+		{
+			pftSig[fillBar] = pftSig[fillBar] + pft.qtyProfit;
+			pftPrice[fillBar] = pft.profitPrice * priceUnit;
+		}
+	}
+
+	for (int pftLine = 0; stopsOn && pftLine < profitLedger.size(); pftLine++)
+	{
+		const profitEntry &pft = profitLedger[pftLine];
+		int fillBar = pft.barIndex + 1;
+
+		if (fillBar < rows && pft.isStop && stopSig[fillBar] == 0)
+		{
+			// Opposing stops netted to zero
+			stopPrice[fillBar] = pft.profitPrice * priceUnit;
+		}
+	}
+
+	for (int ii = 0; stopsOn && ii < rows; ii++)
+	{
+		if (stopSig[ii] != 0)
+		{
+			stopPrice[ii] = stopPrice[ii] / stopSig[ii];
+		}
+	}
+}
+
+/////////////
+//
+// FUNCTIONS & METHODS
+//
+/////////////
+
+// Constructor for ledger line item creation
+openEntry numTicksEngine::createOpenLedgerEntry(int ID, int qty, double price)
+{
+	openEntry OpenLedgerEntry;
+	OpenLedgerEntry.sigIndex = ID;
+	OpenLedgerEntry.qtyOpen = qty;
+	OpenLedgerEntry.openPrice = price;
+	if (qty < 0)
+	{
+		OpenLedgerEntry.profitPrice = price - PROFIT_TGT;
+		OpenLedgerEntry.stopPrice = price + STOP_DIST;
+	}
+	else
+	{
+		OpenLedgerEntry.profitPrice = price + PROFIT_TGT;
+		OpenLedgerEntry.stopPrice = price - STOP_DIST;
+	}
+
+	return OpenLedgerEntry;
+}
+
+static profitEntry createProfitLedgerEntry(int ID, int qty, double price, bool isStop)
+{
+	profitEntry ProfitLedgerEntry;
+	ProfitLedgerEntry.barIndex = ID;
+	ProfitLedgerEntry.qtyProfit = qty;												// Quantity already transformed at calling function
+	ProfitLedgerEntry.profitPrice = price;
+	ProfitLedgerEntry.isStop = isStop;
+
+	return ProfitLedgerEntry;
+}
+
+void numTicksEngine::moveProfitLedger(const int ID, int qty, double price, bool isStop)
+{
+	// We take the price of the next observation for the generated signal
+	// We reverse the quantity to reflect closing of the positions
+	profitLedger.push_back(createProfitLedgerEntry(ID, qty * -1, price, isStop));	
+}
+
+void numTicksEngine::sameBarProfitCheck(const int ID, int qty, int &openPosition, double &minMax)
+{
+	// A stop within the range of the entry observation fills before any profit target
+	if (stopsOn)
+	{
+		double stopPrice = openLedger.back().stopPrice;
+		if (((qty < 0) && (barsInPtr[ID + 1 + shiftHigh] >= stopPrice)) ||
+			((qty > 0) && (barsInPtr[ID + 1 + shiftLow] <= stopPrice)))
+		{
+			moveProfitLedger(ID, qty, stopPrice, true);
+			openPosition = openPosition - qty;
+			openLedger.pop_back();
+			return;
+		}
+	}
+
+	if (openAvg == 0)
+	{
+		// Is there a profit on the bar of the trade? 
+		// Short signal - check LOW
+		if ((qty < 0) && (barsInPtr[ID + 1 + shiftLow] < barsInPtr[ID + 1 + shiftOpen] - PROFIT_TGT))
+		{
+			// We have a profit on the same observation.  Move the entry in the profit ledger
+			moveProfitLedger(ID, qty, barsInPtr[ID + 1 + shiftOpen] - PROFIT_TGT);
+			openPosition = openPosition - qty;
+			openLedger.pop_back();
+		}
+		// Long signal - check HIGH
+		else if ((qty > 0) && (barsInPtr[ID + 1 + shiftHigh] > barsInPtr[ID + 1 + shiftOpen] + PROFIT_TGT))	
+		{
+			// We have a profit on the same observation.  Put entry in the profit ledger
+			moveProfitLedger(ID, qty, barsInPtr[ID + 1 + shiftOpen] + PROFIT_TGT);
+			openPosition = openPosition - qty;
+			openLedger.pop_back();
+		} 
+		else
+		{
+			openPosition = openPosition + qty;
+		}
+	}
+	else
+	{
+
+		// Check same bar using new average
+		// Requires minMax already updated !!
+		newAvgChk(ID, openPosition, minMax);
+
+	}
+}
+
+// A new High | Low has occurred and we have determined that we have an openPosition
+// Check if profit targets have been reached
+void numTicksEngine::newMinMax(const int ID, int &openPosition, double &minMax)
+{
+	if (!openLedger.empty())
+	{
+		if (openAvg == 0)
+		{
+			int iter = 0;
+			while (iter < openLedger.size())
+			{
+				openEntry &line = openLedger[iter];
+				bool taken = false;
+
+				// Short. Check minMax <= profitPrice
+				if (openPosition < 0)				
+				{
+					taken = (minMax <= line.profitPrice);
+				}
+				// Long. Check minMax >= profitPrice
+				else if (openPosition > 0)		
+				{
+					taken = (minMax >= line.profitPrice);
+				}
+
+				if (taken)
+				{
+					moveProfitLedger(ID, line.qtyOpen, line.profitPrice);
+					openLedger.erase(iter);
+				}
+				else
+				{
+					iter++;
+				}
+			}
+			openPosition = sumQty(openLedger);
+		}
+		// Using the average price approach 
+		else
+		{
+			newAvgChk(ID, openPosition, minMax);
+		}
+	}
+}
+
+void numTicksEngine::newAvgChk(const int ID, int &openPosition, double &minMax)
+{
+	double profitPrice = getAvgPftPrice();
+
+	if (openPosition < 0)				// Short. Check minMax <= profitPrice
+	{
+		if (minMax <= profitPrice)
+		{
+			while (!openLedger.empty())
+			{
+				moveProfitLedger(ID, openLedger.front().qtyOpen, profitPrice);
+				openLedger.pop_front();
+			}
+			openPosition = 0;
+		}
+	}
+	else if (openPosition > 0)			// Long. Check minMax >= profitPrice
+	{
+		if (minMax >= profitPrice)
+		{
+			while (!openLedger.empty())
+			{
+				moveProfitLedger(ID, openLedger.front().qtyOpen, profitPrice);
+				openLedger.pop_front();
+			}
+			openPosition = 0;
+		}
+	}
+}
+
+double numTicksEngine::getAvgPftPrice() const
+{
+	int netQty = 0;
+	double sumWghts = 0;
+	double wghtAvg = 0;
+	double profitPrice = 0;
+
+
+	for (int iter = 0; iter < openLedger.size(); iter++)
+	{
+		netQty = netQty + openLedger[iter].qtyOpen;
+		sumWghts = sumWghts + (abs(openLedger[iter].qtyOpen) * openLedger[iter].openPrice);
+	}
+
+	wghtAvg = sumWghts / abs(netQty);
+
+	// Short objective
+	if (netQty < 0)
+	{
+		profitPrice = wghtAvg - PROFIT_TGT;
+	}
+	// Long objective
+	else
+	{
+		profitPrice = wghtAvg + PROFIT_TGT;
+	}
+
+	return profitPrice;
+}
+
+void numTicksEngine::checkOpen(const int ID, int &openPosition)
+{
+	if (openAvg == 0)
+	{
+		int iter = 0;
+		while (iter < openLedger.size())
+		{
+			openEntry &line = openLedger[iter];
+			bool taken;
+
+			// Short
+			if (openPosition < 0)
+			{
+				taken = (barsInPtr[ID + 1 + shiftOpen] <= line.profitPrice);
+			}
+			// Long
+			else
+			{
+				taken = (barsInPtr[ID + 1 + shiftOpen] >= line.profitPrice);
+			}
+
+			if (taken)
+			{
+				// Open satisfies profit threshold
+				moveProfitLedger(ID, line.qtyOpen, barsInPtr[ID + 1 + shiftOpen]);
+				openLedger.erase(iter);
+				openPosition = sumQty(openLedger);
+			}
+			else
+			{
+				iter++;
+			}
+		}
+	}
+	else
+	{
+		double profitPrice = getAvgPftPrice();
+
+		if (openPosition < 0)
+		{
+			if (barsInPtr[ID + 1 + shiftOpen] <= profitPrice)
+			{
+				// Open satisfies profit threshold
+				while (!openLedger.empty())
+				{
+					moveProfitLedger(ID, openLedger.front().qtyOpen, barsInPtr[ID + 1 + shiftOpen]);
+					openLedger.pop_front();
+				}
+				openPosition = 0;
+			}
+		}
+		else
+		{
+			if (barsInPtr[ID + 1 + shiftOpen] >= profitPrice)
+			{
+				// Open satisfies profit threshold
+				while (!openLedger.empty())
+				{
+					moveProfitLedger(ID, openLedger.front().qtyOpen, barsInPtr[ID + 1 + shiftOpen]);
+					openLedger.pop_front();
+				}
+				openPosition = 0;
+			}
+		}
+	}
+}
+
+void numTicksEngine::checkMinMax(const int ID, int &openPosition, double &minMax)
+{
+	if (openPosition < 0)								// Short.  Check minMax to LOW
+	{
+		if (barsInPtr[ID + 1 + shiftLow] < minMax)		//New minMax
+		{
+			minMax = barsInPtr[ID + 1 + shiftLow];
+			newMinMax(ID, openPosition, minMax);
+		}
+	}
+	else if (openPosition > 0)							// Long.  Check minMax to HIGH
+	{
+		if (barsInPtr[ID + 1 + shiftHigh] > minMax)		//New minMax
+		{
+			minMax = barsInPtr[ID + 1 + shiftHigh];
+			newMinMax(ID, openPosition, minMax);
+		}			
+	}
+}
+
+// Close any line item whose stop has been reached.
+// At the open a gap through the stop fills at the open, otherwise a stop within the range fills at the stop.
+void numTicksEngine::checkStops(const int ID, int &openPosition, bool atOpen)
+{
+	double openPrice = barsInPtr[ID + 1 + shiftOpen];
+	int iter = 0;
+	while (iter < openLedger.size())
+	{
+		openEntry &line = openLedger[iter];
+		bool stopped;
+
+		// Short.  Check against the HIGH
+		if (line.qtyOpen < 0)
+		{
+			stopped = (atOpen ? openPrice : barsInPtr[ID + 1 + shiftHigh]) >= line.stopPrice;
+		}
+		// Long.  Check against the LOW
+		else
+		{
+			stopped = (atOpen ? openPrice : barsInPtr[ID + 1 + shiftLow]) <= line.stopPrice;
+		}
+
+		if (stopped)
+		{
+			moveProfitLedger(ID, line.qtyOpen, atOpen ? openPrice : line.stopPrice, true);
+			openLedger.erase(iter);
+		}
+		else
+		{
+			iter++;
+		}
+	}
+	openPosition = sumQty(openLedger);
+}
+
+// Ratchet trailing stops with the extreme of the observation
+void numTicksEngine::trailStops(const int ID)
+{
+	for (int iter = 0; iter < openLedger.size(); iter++)
+	{
+		openEntry &line = openLedger[iter];
+
+		if (line.qtyOpen < 0)
+		{
+			line.stopPrice = min(line.stopPrice, barsInPtr[ID + 1 + shiftLow] + TRAIL_TGT);
+		}
+		else
+		{
+			line.stopPrice = max(line.stopPrice, barsInPtr[ID + 1 + shiftHigh] - TRAIL_TGT);
+		}
+	}
+}
+
+// Aggregate profit line items taken on the same observation in the same direction.
+// The ledger is compacted in place in a single pass.
+static void shrinkProfitLedger(ringBuffer<profitEntry> &profitLedger)
+{
+	int numLines = profitLedger.size();
+	int keep = 0;
+
+	for (int iterMain = 0; iterMain < numLines; iterMain++)
+	{
+		int iterPlusOne = iterMain + 1;		// Look ahead is always iterMain+1
+		// Stops are filled at their own price and are never aggregated
+		if ((iterPlusOne < numLines) && (profitLedger[iterMain].barIndex == profitLedger[iterPlusOne].barIndex) &&
+			(sign(profitLedger[iterMain].qtyProfit) == sign(profitLedger[iterPlusOne].qtyProfit)) &&
+			!profitLedger[iterMain].isStop && !profitLedger[iterPlusOne].isStop)
+		{
+			profitLedger[iterPlusOne].qtyProfit = profitLedger[iterPlusOne].qtyProfit + profitLedger[iterMain].qtyProfit;
+		}
+		else
+		{
+			profitLedger[keep] = profitLedger[iterMain];
+			keep++;
+		}
+	}
+
+	while (profitLedger.size() > keep)
+	{
+		profitLedger.pop_back();
+	}
+}
+
+static bool isTrade(double isSig)
+{
+	if (abs(isSig)>=1)
+	{
+		return true;
+	}
+	return false;
+}
+
+static bool knownAdvSig(double advSig)
+{
+	// We can check for known advanced signals to help in debugging
+	// by registering them here.  This can be a searchable array when
+	// more than one advanced signal exists.
+	// For now we only need to check for |0.5|
+
+	double frac = abs(advSig - int(advSig));
+
+	if (frac == 0.5)		// Close any opposing open position
+	{
+		return true;
+	}
+	return false;
+}
+
+// Method to sum the quantity values in any struct of type tradeEntry
+static int sumQty(const ringBuffer<openEntry>& theList)
+{
+	int sumOfQty = 0;  // the sum is accumulated here
+	// for (int i=0; i<x.size(); i++)
+	for (int it = 0; it < theList.size(); it++)
+	{
+		sumOfQty += theList[it].qtyOpen;
+	}
+
+	return sumOfQty;
+}
+
+void numTicksEngine::chkOpenMethod(int &openPosition, const int curBar, double &minMax)
+{
+	if (openPosition < 0)
+	{
+		// We can add a check to reduce calls to the function unless necessary
+		if(barsInPtr[curBar + 1 + shiftOpen] < minMax)
+		{
+			checkOpen(curBar, openPosition);
+			minMax = barsInPtr[curBar + 1 + shiftOpen];
+		}
+	}
+	else if (openPosition > 0)
+	{
+		if(barsInPtr[curBar + 1 + shiftOpen] > minMax)
+		{
+			checkOpen(curBar, openPosition);
+			minMax = barsInPtr[curBar + 1 + shiftOpen];
+		}
+	}	
+}
+
+//
+//  -------------------------------------------------------------------------
+//                                  _    _ 
+//         ___  _ __   ___ _ __    / \  | | __ _  ___   ___  _ __ __ _ 
+//        / _ \| '_ \ / _ \ '_ \  / _ \ | |/ _` |/ _ \ / _ \| '__/ _` |
+//       | (_) | |_) |  __/ | | |/ ___ \| | (_| | (_) | (_) | | | (_| |
+//        \___/| .__/ \___|_| |_/_/   \_\_|\__, |\___(_)___/|_|  \__, |
+//             |_|                         |___/                 |___/
+//  -------------------------------------------------------------------------
+//        This code is distributed in the hope that it will be useful,
+//
+//                      	   WITHOUT ANY WARRANTY
+//
+//                  WITHOUT CLAIM AS TO MERCHANTABILITY
+//
+//                  OR FITNESS FOR A PARTICULAR PURPOSE
+//
+//                          expressed or implied.
+//
+//   Use of this code, pseudocode, algorithmic or trading logic contained
+//   herein, whether sound or faulty for any purpose is the sole
+//   responsibility of the USER. Any such use of these algorithms, coding
+//   logic or concepts in whole or in part carry no covenant of correctness
+//   or recommended usage from the AUTHOR or any of the possible
+//   contributors listed or unlisted, known or unknown.
+//
+//   Any reference of this code or to this code including any variants from
+//   this code, or any other credits due this AUTHOR from this code shall be
+//   clearly and unambiguously cited and evident during any use, whether in
+//   whole or in part.
+//
+//   The public sharing of this code does not relinquish, reduce, restrict or
+//   encumber any rights the AUTHOR has in respect to claims of intellectual
+//   property.
+//
+//   IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY
+//   DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+//   OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+//   STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//   ANY WAY OUT OF THE USE OF THIS SOFTWARE, CODE, OR CODE FRAGMENT(S), EVEN
+//   IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//   -------------------------------------------------------------------------
+//
+//                             ALL RIGHTS RESERVED
+//
+//   -------------------------------------------------------------------------
+//
+//   Author:	Mark Tompkins
+//   Revision:	4906.24976
+//   Copyright:	(c)2013
+//
\ No newline at end of file
@@ -0,0 +1,240 @@
+#ifndef NUMTICKSENGINE_H
+#define NUMTICKSENGINE_H
+
+// numTicksEngine
+// Profit target engine behind numTicksProfit.
+//
+// Every piece of state for a single evaluation (target, ledgers, fixed point buffers) lives in the
+// engine rather than in file scope globals, so any number of engines may run concurrently, one per
+// thread, against the same or different inputs.  No Matlab API is called from within the engine.
+//
+// Usage:
+//		numTicksEngine eng(barsIn, sigIn, rows, minTick, numTicks, openAvg, fixedPoint);
+//		if (!eng.run(badSig))			// unknown advanced instruction given in badSig
+//		eng.numProfits()				// number of virtual bars to insert
+//		eng.getOutput(barsOut, sigOut)	// (rows + numProfits) x 4 and (rows + numProfits) x 1
+//
+// To sweep several targets over the same history, engines built on a shared engine are advanced
+// together one observation at a time.  The prepared inputs (fixed point prices and signals, the first trade
+// and the signal count) are shared.  Each target keeps its own ledgers because its exits change the open
+// position every later observation sees, so a sweep of K targets costs K evaluations, not one:
+//		if (eng[k].start())				// identical for every k
+//			for (bar = eng[k].firstBar(); bar < rows - 1; bar++)
+//				eng[k].step(bar, badSig)	// for every k
+//			eng[k].finish()
+//		eng[k].getProfits(pftSig, pftPrice, stopSig, stopPrice)
+//
+// Protective stops (a fixed stop and | or a trailing stop) may be evaluated alongside the profit target in the
+// same pass.  Stop exits are recorded in the profit ledger as any other exit and produce the same virtual bars.
+// Fills are deterministic:
+//		- An open at or through a stop fills the stop at the open, before the observation's signal
+//		- When a stop and a profit target are both within an observation's range the stop fills first
+//		- A trailing stop is ratcheted with an observation's extreme only after that observation has been checked
+
+#include <vector>
+
+// Create a struct for open position
+typedef struct openEntry
+{
+	int sigIndex;								//	Array index of signal that created open position
+	int qtyOpen;								//	Quantity of created open position
+	double openPrice;							//	Entry price of open position
+	double profitPrice;							//	Price where position will be closed with a profit
+	double stopPrice;							//	Price where position will be closed with a loss (fixed or trailing)
+} openEntry;
+
+// Create struct for profit ledger
+typedef struct profitEntry
+{
+	int barIndex;								//	Array index of observation that create the profit taking
+	int qtyProfit;								//	Quantity bought or sold at the profit taking price
+	double profitPrice;							//	Profit price
+	bool isStop;								//	Closed by a stop rather than a profit target
+} profitEntry;
+
+// Fixed capacity FIFO ledger laid over a block of a per-call arena.
+// Line items are contiguous (modulo the wrap) so scans are cache friendly and
+// nothing is allocated while the observations are iterated.
+template <typename T>
+class ringBuffer
+{
+public:
+	ringBuffer() : buf(0), capacity(0), head(0), count(0) {}
+
+	void attach(T *block, int cap) { buf = block; capacity = cap; head = 0; count = 0; }
+
+	bool empty() const { return count == 0; }
+	int size() const { return count; }
+	void clear() { head = 0; count = 0; }
+
+	// Line item 'ii' counted from the front
+	T& operator[](int ii) { int idx = head + ii; return buf[idx < capacity ? idx : idx - capacity]; }
+	const T& operator[](int ii) const { int idx = head + ii; return buf[idx < capacity ? idx : idx - capacity]; }
+	T& front() { return buf[head]; }
+	T& back() { return (*this)[count - 1]; }
+
+	void push_back(const T &x) { (*this)[count] = x; count++; }
+	void pop_back() { count--; }
+	void pop_front() { head = (head + 1 < capacity) ? head + 1 : 0; count--; }
+
+	// Remove line item 'ii' preserving order
+	void erase(int ii)
+	{
+		for (int jj = ii; jj < count - 1; jj++)
+		{
+			(*this)[jj] = (*this)[jj + 1];
+		}
+		count--;
+	}
+
+private:
+	T *buf;
+	int capacity;
+	int head;
+	int count;
+};
+
+class numTicksEngine
+{
+public:
+	// barsIn is rows x 4 (Open | High | Low | Close) column major and sigIn is rows x 1.  Neither is copied,
+	// both must outlive the engine.  A minTick of zero disables profit taking.
+	numTicksEngine(const double *barsIn, const double *sigIn, int rows, double minTick, double numTicks,
+		bool openAvg, bool fixedPoint);
+
+	// An engine for another target over the prices and signals already prepared by 'shared'.
+	// 'shared' must outlive it.
+	numTicksEngine(const numTicksEngine &shared, double numTicks);
+
+	// Walk the observations and build the profit ledger.
+	// Returns false if an unknown advanced instruction is encountered.  The offending signal is passed back in 'badSig'.
+	bool run(double &badSig);
+
+	// Distance in ticks to a fixed stop and to a trailing stop.  Zero disables either.  Must precede start().
+	void setStops(double stopTicks, double trailTicks);
+
+	// run() one observation at a time.
+	// start() opens the first trade and returns false if there is nothing to evaluate (no trades or no minTick).
+	bool start();
+	int firstBar() const { return sigIndex + 1; }
+	bool step(int curBar, double &badSig);
+	void finish();
+
+	// Number of virtual profit taking bars found by run()
+	int numProfits() const { return profitLedger.size(); }
+
+	// Write the given prices and signals with the virtual bars inserted.
+	// barsOut must hold (rows + numProfits()) x 4 and sigOut (rows + numProfits()) values.
+	void getOutput(double *barsOut, double *sigOut);
+
+	// Add the profit taking quantity and write the profit price on the observation each profit is filled.
+	// Stop exits are kept apart in stopSig | stopPrice so each quantity is paired with the price it filled at.
+	// Stops filled on the same observation are priced at their quantity weighted average (stopSig * stopPrice
+	// is the value traded), or at the last fill where opposing stops net to zero.
+	// All arrays hold 'rows' values and are expected to be zeroed.
+	void getProfits(double *pftSig, double *pftPrice, double *stopSig, double *stopPrice) const;
+
+private:
+	openEntry createOpenLedgerEntry(int ID, int qty, double price);
+	double getAvgPftPrice() const;
+	void moveProfitLedger(const int ID, int qty, double price, bool isStop = false);
+	void checkOpen(const int ID, int &openPosition);
+	void newAvgChk(const int ID, int &openPosition, double &minMax);
+	void newMinMax(const int ID, int &openPosition, double &minMax);
+	void checkMinMax(const int ID, int &openPosition, double &minMax);
+	void chkOpenMethod(int &openPosition, const int curBar, double &minMax);
+	void sameBarProfitCheck(const int ID, int qty, int &openPosition, double &minMax);
+	void checkStops(const int ID, int &openPosition, bool atOpen);
+	void trailStops(const int ID);
+
+	double PROFIT_TGT;							// Calculated profit target (for readability)
+	double STOP_TGT;							// Calculated fixed stop distance (0 = none)
+	double TRAIL_TGT;							// Calculated trailing stop distance (0 = none)
+	double STOP_DIST;							// Distance to the nearer of the two from an entry
+	bool stopsOn;
+	double numTicks;							// Number of ticks (representing $ multiples) in which to take a profit
+	double minTick;								// What a single tick increment is for a given contract
+	bool openAvg;								// Manage profit taking per contract or average the net position (false = atomic | true = average)
+	bool fixedPoint;							// Prices and targets are in whole ticks
+
+	const double *barsInPtr;					// Prices the targets are evaluated on (whole ticks in fixed point)
+	const double *sigInPtr;						// Signals the targets are evaluated on (snapped in fixed point)
+	const double *barsRawPtr;					// Prices as given, returned with the virtual bars
+	int rows;
+	int shiftOpen;								// used for readability
+	int shiftHigh;
+	int shiftLow;
+	int shiftClose;
+	double priceUnit;							// Converts an internal price back to an output price
+	int firstSig;								// Index of the first trade (rows if none)
+	int numSigs;								// Signals from the first trade on.  Bounds both ledgers.
+
+	// Evaluation state
+	int sigIndex;								// Index of the first trade
+	int openPosition;							// Net open position
+	double minMax;								// Current minimum | maximum to optimize (minimize) checks
+
+	// Owned buffers
+	std::vector<double> barsTicks;				// Fixed point prices
+	std::vector<double> sigSnapped;				// Fixed point signals
+	std::vector<char> ledgerArena;				// Backing store shared by both ledgers
+
+	ringBuffer<openEntry> openLedger;
+	ringBuffer<profitEntry> profitLedger;
+};
+
+#endif // NUMTICKSENGINE_H
+//
+//  -------------------------------------------------------------------------
+//                                  _    _ 
+//         ___  _ __   ___ _ __    / \  | | __ _  ___   ___  _ __ __ _ 
+//        / _ \| '_ \ / _ \ '_ \  / _ \ | |/ _` |/ _ \ / _ \| '__/ _` |
+//       | (_) | |_) |  __/ | | |/ ___ \| | (_| | (_) | (_) | | | (_| |
+//        \___/| .__/ \___|_| |_/_/   \_\_|\__, |\___(_)___/|_|  \__, |
+//             |_|                         |___/                 |___/
+//  -------------------------------------------------------------------------
+//        This code is distributed in the hope that it will be useful,
+//
+//                      	   WITHOUT ANY WARRANTY
+//
+//                  WITHOUT CLAIM AS TO MERCHANTABILITY
+//
+//                  OR FITNESS FOR A PARTICULAR PURPOSE
+//
+//                          expressed or implied.
+//
+//   Use of this code, pseudocode, algorithmic or trading logic contained
+//   herein, whether sound or faulty for any purpose is the sole
+//   responsibility of the USER. Any such use of these algorithms, coding
+//   logic or concepts in whole or in part carry no covenant of correctness
+//   or recommended usage from the AUTHOR or any of the possible
+//   contributors listed or unlisted, known or unknown.
+//
+//   Any reference of this code or to this code including any variants from
+//   this code, or any other credits due this AUTHOR from this code shall be
+//   clearly and unambiguously cited and evident during any use, whether in
+//   whole or in part.
+//
+//   The public sharing of this code does not relinquish, reduce, restrict or
+//   encumber any rights the AUTHOR has in respect to claims of intellectual
+//   property.
+//
+//   IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY
+//   DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+//   OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+//   STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//   ANY WAY OUT OF THE USE OF THIS SOFTWARE, CODE, OR CODE FRAGMENT(S), EVEN
+//   IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//   -------------------------------------------------------------------------
+//
+//                             ALL RIGHTS RESERVED
+//
+//   -------------------------------------------------------------------------
+//
+//   Author:	Mark Tompkins
+//   Revision:	4906.24976
+//   Copyright:	(c)2013
+//
\ No newline at end of file
@@ -0,0 +1,559 @@
+// plEngine.cpp
+// See plEngine.h and calcProfitLoss.cpp for the signal conventions that are applied
+
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include "plEngine.h"
+#include "myMath.h"
+
+using namespace std;
+
+// Observations between exact revaluations of the floating point ledger aggregate
+#define RESYNC_BARS	1024
+
+// Prototypes
+static tradeEntry createLineEntry(int ID, int qty, double price, long long ticks);
+static bool knownAdvSig(double advSig);
+
+plEngine::plEngine(double bigPoint, double cost, double minTick)
+{
+	BIG_POINT = bigPoint;
+	COST = cost;
+	MIN_TICK = minTick;
+	TICK_VALUE = minTick * bigPoint;
+	tickMode = minTick > 0;
+	blotterOn = false;
+	reset();
+}
+
+void plEngine::reset()
+{
+	openLedger.clear();
+	position = 0;
+	inTrade = false;
+	pendingSig = 0;
+	numObs = 0;
+
+	ledgerQty = 0;
+	ledgerTicks = 0;
+	ledgerValue = 0;
+
+	barTicks = 0;
+	barContracts = 0;
+	cumTicks = 0;
+	cumContracts = 0;
+
+	for (int ii = 0; ii < 2; ii++)
+	{
+		cashBar[ii] = 0;
+		openEQBar[ii] = 0;
+		netLiqBar[ii] = 0;
+		returnsBar[ii] = 0;
+	}
+	runSum = 0;
+	runSumPrior = 0;
+
+	trades.clear();
+	highs.clear();
+	lows.clear();
+}
+
+bool plEngine::addBar(double open, double close, double sig, double &badSig)
+{
+	// Without High | Low the body of the observation is the best measure of its range
+	return addBar(open, max(open, close), min(open, close), close, sig, badSig);
+}
+
+bool plEngine::addBar(double open, double high, double low, double close, double sig, double &badSig)
+{
+	double newCash = 0;
+	double newOpenEQ = 0;
+
+	// Fixed point.  Each price is converted to ticks exactly once.
+	long long openTicks = 0;
+	long long closeTicks = 0;
+	if (tickMode)
+	{
+		openTicks = priceToTicks(open, MIN_TICK);
+		closeTicks = priceToTicks(close, MIN_TICK);
+		sig = snapHalf(sig);
+	}
+	barTicks = 0;
+	barContracts = 0;
+
+	// The first observation has nothing to execute
+	if (numObs > 0)
+	{
+		// Waiting on the first trade.  We only need the integer portion of the first trade.
+		if (!inTrade)
+		{
+			if (abs(pendingSig) >= 1)
+			{
+				// Put first trade on ledger
+				// Execution price lags signal by one observation
+				openLedger.push_back(createLineEntry(numObs - 1, int(pendingSig), open, openTicks));
+				updateAggregate(openLedger.back(), openLedger.back().quantity);
+				position = int(pendingSig);
+				inTrade = true;
+				// Open equity is not valued on the observation the first trade is executed
+			}
+		}
+		else
+		{
+			if (pendingSig != 0)
+			{
+				// Validate before anything is changed
+				if (fraction(pendingSig) && !knownAdvSig(pendingSig))
+				{
+					badSig = pendingSig;
+					return false;
+				}
+
+				executeSig(numObs - 1, pendingSig, open, openTicks, newCash);
+
+				if (tickMode)
+				{
+					newCash = barTicks * TICK_VALUE - barContracts * COST;
+				}
+			}
+
+			// Calculate current openEQ if there are any positions
+			if (position != 0 && !openLedger.empty())
+			{
+				if (tickMode)
+				{
+					newOpenEQ = (closeTicks * ledgerQty - ledgerTicks) * TICK_VALUE;
+				}
+				else
+				{
+					if (numObs % RESYNC_BARS == 0)
+					{
+						resyncLedger();
+					}
+					newOpenEQ = ((close * ledgerQty) - ledgerValue) * BIG_POINT;
+				}
+			}
+		}
+	}
+
+	// Roll the observation window
+	double priorNetLiq = netLiqBar[PRIOR];		// Final since the last update
+
+	cashBar[PRIOR] = cashBar[CURRENT];
+	openEQBar[PRIOR] = openEQBar[CURRENT];
+	cashBar[CURRENT] = newCash;
+	openEQBar[CURRENT] = newOpenEQ;
+
+	// This is a 'dirty' cleaning of trades that were closed on the next observation.
+	// Because we are creating a vBar for profit objectives, if the openEquity is greater than the next
+	// observation's cash, we'll reduce openEquity to equal cash.  This should normalize some spikes.
+	if (numObs >= 2)
+	{
+		if (openEQBar[PRIOR] != cashBar[CURRENT] && openEQBar[CURRENT] == 0 && cashBar[CURRENT] > 0)
+		{
+			openEQBar[PRIOR] = cashBar[CURRENT];
+		}
+	}
+
+	// Cumulative sum of closed trades and open equity per observation
+	runSumPrior = runSum;
+	if (tickMode)
+	{
+		// Accumulated in integers so there is no drift over any number of fills
+		cumTicks = cumTicks + barTicks;
+		cumContracts = cumContracts + barContracts;
+		runSum = cumTicks * TICK_VALUE - cumContracts * COST;
+	}
+	else
+	{
+		runSum = runSum + cashBar[CURRENT];
+	}
+	netLiqBar[PRIOR] = runSumPrior + openEQBar[PRIOR];
+	netLiqBar[CURRENT] = runSum + openEQBar[CURRENT];
+
+	// Return from observation to observation
+	returnsBar[PRIOR] = numObs >= 2 ? netLiqBar[PRIOR] - priorNetLiq : 0;
+	returnsBar[CURRENT] = numObs >= 1 ? netLiqBar[CURRENT] - netLiqBar[PRIOR] : 0;
+
+	if (blotterOn)
+	{
+		trackExtremes(high, low);
+	}
+
+	pendingSig = sig;
+	numObs++;
+
+	return true;
+}
+
+void plEngine::getBar(plBar which, double &cash, double &openEQ, double &netLiq, double &returns) const
+{
+	cash = cashBar[which];
+	openEQ = openEQBar[which];
+	netLiq = netLiqBar[which];
+	returns = returnsBar[which];
+}
+
+// Execute a signal given on observation 'ID' at 'price' (the open of observation ID + 1)
+// Realized P&L is aggregated in 'cash', or in ticks and contracts in fixed point mode
+void plEngine::executeSig(int ID, double sig, double price, long long ticks, double &cash)
+{
+	// Is this an advanced signal?
+	if (fraction(sig))
+	{
+		// Check for additive or reductive
+		if ((position <= 0 && sig <= -1) || (position >= 0 && sig >= 1))
+			// Additive
+		{
+			// We ignore reverse advance instructions when they are additive
+		}
+		// Reductive.  Reverse instruction.
+		else
+		{
+			// Liquidate any open position
+			while (!openLedger.empty())
+			{
+				closeLine(openLedger.front(), openLedger.front().quantity, price, ticks, cash);
+				updateAggregate(openLedger.front(), -openLedger.front().quantity);
+				openLedger.pop_front();
+			}
+
+			position = 0;
+		}
+	}
+
+	// Any integer and if so Additive or reductive ?
+	if ((position <= 0 && sig <= -1) || (position >= 0 && sig >= 1))
+		// Additive
+	{
+		// Trade is additive. Add or create existing position --> openLedger
+		openLedger.push_back(createLineEntry(ID, int(sig), price, ticks));
+		updateAggregate(openLedger.back(), openLedger.back().quantity);
+		position = position + int(sig);
+	}
+	// Reductive
+	else
+	{
+		// Signal is effectively a reverse or liquidate
+		if (int(abs(sig)) >= abs(position))
+		{
+			// New trade is larger than or equal to existing position. Calculate cash on all ledger lines
+			while (!openLedger.empty())
+			{
+				closeLine(openLedger.front(), openLedger.front().quantity, price, ticks, cash);
+				updateAggregate(openLedger.front(), -openLedger.front().quantity);
+				openLedger.pop_front();
+			}
+
+			// update open position tracker
+			position = int(sig) + position;
+
+			// if there is a 'remainder', this is the new net open position
+			// put it on the openLedger
+			if (position != 0)
+			{
+				openLedger.push_back(createLineEntry(ID, position, price, ticks));
+				updateAggregate(openLedger.back(), openLedger.back().quantity);
+			}
+		}
+		// partial liquidation
+		else
+		{
+			// New trade is smaller than the current open position.
+			// How many do we need to reduce by?
+			int needQty = int(sig);
+
+			// Prepare to iterate until we are satisfied
+			while (needQty !=0)
+			{
+				// Is the current line item quantity larger than what we need?
+				if (abs(openLedger.front().quantity) > needQty)
+				{
+					// If so we will P&L the quantity we need and reduce the open position size
+					closeLine(openLedger.front(), -needQty, price, ticks, cash);
+					// Reduce the position size.  We are aggregating so we add (e.g. 5 Purchases + 4 Sales = 1 Long)
+					openLedger.front().quantity = openLedger.front().quantity + needQty;
+					updateAggregate(openLedger.front(), needQty);
+					// We are satisfied and don't need any more contracts
+					needQty = 0;
+				}
+				// Current line item quantity is equal to or smaller than what we need.  Process P&L and remove.
+				else
+				{
+					// P&L entire quantity
+					closeLine(openLedger.front(), -openLedger.front().quantity, price, ticks, cash);
+					updateAggregate(openLedger.front(), -openLedger.front().quantity);
+					// Reduce needed quantity by what we've been provided
+					needQty = needQty + openLedger.front().quantity;
+					// Remove the line item (FIFO)
+					openLedger.pop_front();
+				}
+			}
+			// update open position tracker
+			position = position + sig;
+		}
+	}
+}
+
+// Close 'qty' of a ledger line item at 'price' (the open of the current observation)
+// Realized P&L is aggregated in 'cash' (or ticks) and the round trip is put on the blotter if enabled
+void plEngine::closeLine(const tradeEntry &line, int qty, double price, long long ticks, double &cash)
+{
+	if (tickMode)
+	{
+		barTicks = barTicks + (ticks - line.ticks) * qty;
+		barContracts = barContracts + abs(qty);
+	}
+	else
+	{
+		cash = cash + ((price - line.price) * qty * BIG_POINT) - (abs(qty) * COST);
+	}
+
+	if (blotterOn)
+	{
+		blotterEntry trade;
+		trade.entryBar = line.index + 1;				// Execution lags the signal by one observation
+		trade.exitBar = numObs;
+		trade.quantity = qty;
+		trade.entryPrice = line.price;
+		trade.exitPrice = price;
+		trade.grossPL = tickMode ? (ticks - line.ticks) * qty * TICK_VALUE : (price - line.price) * qty * BIG_POINT;
+		trade.netPL = trade.grossPL - (abs(qty) * COST);
+
+		// Extremes from the entry observation up to and including the exit price
+		double highSince = price;
+		double lowSince = price;
+
+		int lo, hi, mid;
+
+		// First high | low on or after the entry observation is the extreme since entry
+		lo = 0; hi = (int)highs.size();
+		while (lo < hi)
+		{
+			mid = (lo + hi) / 2;
+			if (highs[mid].index < trade.entryBar) lo = mid + 1; else hi = mid;
+		}
+		if (lo < (int)highs.size()) highSince = max(highSince, highs[lo].price);
+
+		lo = 0; hi = (int)lows.size();
+		while (lo < hi)
+		{
+			mid = (lo + hi) / 2;
+			if (lows[mid].index < trade.entryBar) lo = mid + 1; else hi = mid;
+		}
+		if (lo < (int)lows.size()) lowSince = min(lowSince, lows[lo].price);
+
+		double upMove = (highSince - line.price) * qty * BIG_POINT;
+		double downMove = (lowSince - line.price) * qty * BIG_POINT;
+		trade.MFE = max(upMove, downMove);
+		trade.MAE = min(upMove, downMove);
+
+		trades.push_back(trade);
+	}
+}
+
+// Keep the monotonic highs | lows current for excursion tracking
+void plEngine::trackExtremes(double high, double low)
+{
+	while (!highs.empty() && highs.back().price <= high)
+	{
+		highs.pop_back();
+	}
+	extremeEntry newHigh = { numObs, high };
+	highs.push_back(newHigh);
+
+	while (!lows.empty() && lows.back().price >= low)
+	{
+		lows.pop_back();
+	}
+	extremeEntry newLow = { numObs, low };
+	lows.push_back(newLow);
+
+	// Nothing older than the oldest open line item's entry is needed
+	if (openLedger.empty())
+	{
+		highs.clear();
+		lows.clear();
+	}
+	else
+	{
+		int oldestEntry = openLedger.front().index + 1;
+		while (highs.front().index < oldestEntry)
+		{
+			highs.pop_front();
+		}
+		while (lows.front().index < oldestEntry)
+		{
+			lows.pop_front();
+		}
+	}
+}
+
+// 'qty' contracts of a ledger line item were added (positive) or removed (negative).  Adjust the running aggregate.
+// Line items all share the sign of the position, so a net quantity of zero is an empty ledger and the floating
+// point aggregate restarts from an exact zero.
+void plEngine::updateAggregate(const tradeEntry &line, int qty)
+{
+	ledgerQty = ledgerQty + qty;
+	ledgerTicks = ledgerTicks + line.ticks * qty;
+	ledgerValue = (ledgerQty == 0) ? 0 : ledgerValue + line.price * qty;
+}
+
+// Open equity of the ledger at 'price'
+// !!!!!!!!!!!!!!!!!!!!!!
+// !! IMPORTANT
+// !!!!!!!!!!!!!!!!!!!!!!
+// Because we are using virtual bars for calculations, we have introduced a known issue
+// that a profit may occur within an observation High or Low.  To offset this we
+// clean certain openEQ calculations in addBar. This will cause some invalid depictions
+// of open equity between observations but would be effectively be a margining issue
+//
+// Open equity is valued in O(1) from the running aggregate, ((price * ledgerQty) - ledgerValue) * bigPoint.
+// In floating point each fill adds its rounding to ledgerValue, so while a position stays open it is rebuilt
+// from the line items every RESYNC_BARS observations to bound the drift.
+void plEngine::resyncLedger()
+{
+	ledgerValue = 0;
+	for (deque<tradeEntry>::const_iterator it=openLedger.begin();it!=openLedger.end();it++)
+	{
+		ledgerValue = ledgerValue + (it->price * it->quantity);
+	}
+}
+
+/////////////
+//
+// FUNCTIONS & METHODS
+//
+/////////////
+
+// Each observation is passed through the same plEngine used by calcProfitLossLive so that batch and
+// streaming results agree
+bool calcColumnPL(const double *openPtr, const double *highPtr, const double *lowPtr, const double *closePtr,
+				  const double *sigInPtr, int rowsData, double BIG_POINT, double COST, double MIN_TICK,
+				  double *cashIdx, double *openEQIdx, double *netLiqIdx, double *returnsIdx, double &badSig,
+				  vector<blotterEntry> *blotter)
+{
+	plEngine engine(BIG_POINT, COST, MIN_TICK);
+	double cashPrior;					// Cash of the prior observation does not change
+
+	const bool hasHighLow = (highPtr != NULL && lowPtr != NULL);
+
+	engine.enableBlotter(blotter != NULL);
+
+	for (int ii = 0; ii < rowsData; ii++)
+	{
+		bool ok;
+		if (hasHighLow)
+		{
+			ok = engine.addBar(openPtr[ii], highPtr[ii], lowPtr[ii], closePtr[ii], sigInPtr[ii], badSig);
+		}
+		else
+		{
+			ok = engine.addBar(openPtr[ii], closePtr[ii], sigInPtr[ii], badSig);
+		}
+
+		if (!ok)
+		{
+			return false;
+		}
+
+		// The prior observation is now final
+		if (ii > 0)
+		{
+			engine.getBar(plEngine::PRIOR, cashPrior, openEQIdx[ii-1], netLiqIdx[ii-1], returnsIdx[ii-1]);
+		}
+
+		engine.getBar(plEngine::CURRENT, cashIdx[ii], openEQIdx[ii], netLiqIdx[ii], returnsIdx[ii]);
+	}
+
+	if (blotter != NULL)
+	{
+		engine.swapBlotter(*blotter);
+	}
+
+	return true;
+}
+
+// Constructor for ledger line item creation
+static tradeEntry createLineEntry(int ID, int qty, double price, long long ticks)
+{
+	tradeEntry lineEntry;
+	lineEntry.index = ID;
+	lineEntry.quantity = qty;
+	lineEntry.price = price;
+	lineEntry.ticks = ticks;
+
+	return lineEntry;
+}
+
+static bool knownAdvSig(double advSig)
+{
+	// We can check for known advanced signals to help in debugging
+	// by registering them here.  This can be a searchable array when
+	// more than one advanced signal exists.
+	// For now we only need to check for |0.5|
+
+	double frac = abs(advSig - int(advSig));
+
+	if (frac == 0.5)		// Close any opposing open position
+	{
+		return true;
+	}
+	return false;
+}
+
+//
+//  -------------------------------------------------------------------------
+//                                  _    _ 
+//         ___  _ __   ___ _ __    / \  | | __ _  ___   ___  _ __ __ _ 
+//        / _ \| '_ \ / _ \ '_ \  / _ \ | |/ _` |/ _ \ / _ \| '__/ _` |
+//       | (_) | |_) |  __/ | | |/ ___ \| | (_| | (_) | (_) | | | (_| |
+//        \___/| .__/ \___|_| |_/_/   \_\_|\__, |\___(_)___/|_|  \__, |
+//             |_|                         |___/                 |___/
+//  -------------------------------------------------------------------------
+//        This code is distributed in the hope that it will be useful,
+//
+//                      	 WITHOUT ANY WARRANTY
+//
+//                  WITHOUT CLAIM AS TO MERCHANTABILITY
+//
+//                  OR FITNESS FOR A PARTICULAR PURPOSE
+//
+//                           expressed or implied.
+//
+//   Use of this code, pseudocode, algorithmic or trading logic contained
+//   herein, whether sound or faulty for any purpose is the sole
+//   responsibility of the USER. Any such use of these algorithms, coding
+//   logic or concepts in whole or in part carry no covenant of correctness
+//   or recommended usage from the AUTHOR or any of the possible
+//   contributors listed or unlisted, known or unknown.
+//
+//   Any reference of this code or to this code including any variants from
+//   this code, or any other credits due this AUTHOR from this code shall be
+//   clearly and unambiguously cited and evident during any use, whether in
+//   whole or in part.
+//
+//   The public sharing of this code does not relinquish, reduce, restrict or
+//   encumber any rights the AUTHOR has in respect to claims of intellectual
+//   property.
+//
+//   IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY
+//   DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+//   OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+//   STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//   ANY WAY OUT OF THE USE OF THIS SOFTWARE, CODE, OR CODE FRAGMENT(S), EVEN
+//   IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//   -------------------------------------------------------------------------
+//
+//                             ALL RIGHTS RESERVED
+//
+//   -------------------------------------------------------------------------
+//
+//   Author:	Mark Tompkins
+//   Revision:	4913.37624
+//   Copyright:	(c)2013
+//
\ No newline at end of file
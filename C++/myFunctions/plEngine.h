@@ -0,0 +1,203 @@
+#ifndef PLENGINE_H
+#define PLENGINE_H
+
+// plEngine
+// Incremental profit and loss engine shared by calcProfitLoss, calcProfitLossPortfolio and calcProfitLossLive.
+//
+// Observations are given one at a time as (open, close, signal).  A signal is executed
+// at the open of the following observation, open equity is valued at the close.
+// Results are identical to a batch run of calcProfitLoss over the same history.
+//
+// Because open equity of an observation may be 'cleaned' once the next observation's cash
+// is known, each update finalizes the PRIOR observation and provides a provisional CURRENT one.
+//
+// When enabled, a blotter of round trips is built as ledger line items are closed.
+//
+// Given a minimum tick the engine runs in fixed point.  Prices are converted once to whole ticks,
+// the ledger and cumulative cash are kept in integer ticks and contracts, and only converted to
+// dollars (ticks * minTick * bigPoint) for output.  Signals are snapped to the nearest half unit
+// so advanced instructions do not depend on rounding.
+
+#include <deque>
+#include <vector>
+
+// Create a struct for convenience
+typedef struct tradeEntry
+{
+	int index;
+	int quantity;
+	double price;
+	long long ticks;							// Price in whole ticks (fixed point mode)
+} tradeEntry;
+
+// A closed round trip (or the closed portion of a ledger line item)
+typedef struct blotterEntry
+{
+	int entryBar;								// Observation the entry was filled on (0 based)
+	int exitBar;								// Observation the exit was filled on (0 based)
+	int quantity;								// Quantity closed as applied to cash (positive long)
+	double entryPrice;
+	double exitPrice;
+	double grossPL;								// P&L before commission
+	double netPL;								// P&L after commission.  Sums to cash.
+	double MAE;									// Maximum adverse excursion while open
+	double MFE;									// Maximum favorable excursion while open
+} blotterEntry;
+
+// Price extreme of an observation for excursion tracking
+typedef struct extremeEntry
+{
+	int index;
+	double price;
+} extremeEntry;
+
+class plEngine
+{
+public:
+	enum plBar { PRIOR = 0, CURRENT = 1 };
+
+	// A minTick of zero values the ledger in floating point
+	plEngine(double bigPoint, double cost, double minTick = 0);
+
+	// Clear all state so the engine can be reused on a new history
+	void reset();
+
+	// Add one observation.  Each line item is put on and taken off the ledger once so fills are O(1) amortized.
+	// Open equity is O(1) from the running aggregate of the ledger.  In floating point the aggregate is
+	// rebuilt from the open line items periodically (O(1) amortized) to bound rounding drift.
+	// Returns false, leaving the engine unchanged, if the signal being executed is an unknown advanced
+	// instruction.  The offending signal is passed back in 'badSig'.
+	bool addBar(double open, double close, double sig, double &badSig);
+
+	// As above when High and Low are available.  Only used to measure excursions for the blotter.
+	bool addBar(double open, double high, double low, double close, double sig, double &badSig);
+
+	// Record a blotter of closed round trips.  Must be set before the first observation.
+	void enableBlotter(bool enable) { blotterOn = enable; }
+	const std::vector<blotterEntry>& blotter() const { return trades; }
+	void swapBlotter(std::vector<blotterEntry> &x) { trades.swap(x); }
+
+	// Values for the PRIOR (now final) or CURRENT (provisional) observation
+	void getBar(plBar which, double &cash, double &openEQ, double &netLiq, double &returns) const;
+
+	int numBars() const { return numObs; }
+	int openPosition() const { return position; }
+	double cashSum() const { return runSum; }
+	double netLiq() const { return netLiqBar[CURRENT]; }
+	const std::deque<tradeEntry>& ledger() const { return openLedger; }
+
+private:
+	void executeSig(int ID, double sig, double price, long long ticks, double &cash);
+	void closeLine(const tradeEntry &line, int qty, double price, long long ticks, double &cash);
+	void trackExtremes(double high, double low);
+	void updateAggregate(const tradeEntry &line, int qty);
+	void resyncLedger();
+
+	double BIG_POINT;
+	double COST;
+	double MIN_TICK;
+	double TICK_VALUE;							// Dollar value of one tick (minTick * bigPoint)
+	bool tickMode;
+
+	std::deque<tradeEntry> openLedger;			// FIFO ledger of open line items
+	int position;								// Net open position
+	bool inTrade;								// The first trade has been executed
+	double pendingSig;							// Signal awaiting execution at the next open
+	int numObs;									// Number of observations processed
+
+	// Running aggregate of the ledger, adjusted by each line item put on, reduced or taken off, so open equity
+	// does not require a walk of every line item.  Integers in fixed point mode, so there is no drift.
+	int ledgerQty;								// Signed net quantity
+	long long ledgerTicks;						// Quantity weighted entry ticks (fixed point mode)
+	double ledgerValue;							// Quantity weighted entry prices (floating point mode)
+
+	// Realized ticks and contracts traded, this observation and cumulative (fixed point mode)
+	long long barTicks;
+	long long barContracts;
+	long long cumTicks;
+	long long cumContracts;
+
+	// PRIOR and CURRENT observations
+	double cashBar[2];
+	double openEQBar[2];
+	double netLiqBar[2];
+	double returnsBar[2];
+	double runSum;								// Cumulative cash through CURRENT
+	double runSumPrior;							// Cumulative cash through PRIOR
+
+	// Blotter
+	// The extremes are monotonic so the high | low since any open line item's entry is found by a binary search.
+	// Anything older than the oldest open line item is discarded.
+	bool blotterOn;
+	std::vector<blotterEntry> trades;
+	std::deque<extremeEntry> highs;				// Decreasing highs
+	std::deque<extremeEntry> lows;				// Increasing lows
+};
+
+// P&L a single series of signals against its Open | Close (and optionally High | Low) prices with a plEngine.
+// Shared by calcProfitLoss (each signal column) and calcProfitLossPortfolio (each instrument).
+// 'highPtr' and 'lowPtr' may be NULL, in which case the body of each observation is taken as its range.
+// Returns false if an unknown advanced signal was encountered, in which case it is passed back in 'badSig'.
+// If 'blotter' is not NULL the closed round trips are returned in it.
+// Does not call back into Matlab so it is safe to run concurrently on separate series.
+bool calcColumnPL(const double *openPtr, const double *highPtr, const double *lowPtr, const double *closePtr,
+				  const double *sigInPtr, int rowsData, double BIG_POINT, double COST, double MIN_TICK,
+				  double *cashIdx, double *openEQIdx, double *netLiqIdx, double *returnsIdx, double &badSig,
+				  std::vector<blotterEntry> *blotter);
+
+#endif // PLENGINE_H
+
+//
+//  -------------------------------------------------------------------------
+//                                  _    _ 
+//         ___  _ __   ___ _ __    / \  | | __ _  ___   ___  _ __ __ _ 
+//        / _ \| '_ \ / _ \ '_ \  / _ \ | |/ _` |/ _ \ / _ \| '__/ _` |
+//       | (_) | |_) |  __/ | | |/ ___ \| | (_| | (_) | (_) | | | (_| |
+//        \___/| .__/ \___|_| |_/_/   \_\_|\__, |\___(_)___/|_|  \__, |
+//             |_|                         |___/                 |___/
+//  -------------------------------------------------------------------------
+//        This code is distributed in the hope that it will be useful,
+//
+//                      	 WITHOUT ANY WARRANTY
+//
+//                  WITHOUT CLAIM AS TO MERCHANTABILITY
+//
+//                  OR FITNESS FOR A PARTICULAR PURPOSE
+//
+//                           expressed or implied.
+//
+//   Use of this code, pseudocode, algorithmic or trading logic contained
+//   herein, whether sound or faulty for any purpose is the sole
+//   responsibility of the USER. Any such use of these algorithms, coding
+//   logic or concepts in whole or in part carry no covenant of correctness
+//   or recommended usage from the AUTHOR or any of the possible
+//   contributors listed or unlisted, known or unknown.
+//
+//   Any reference of this code or to this code including any variants from
+//   this code, or any other credits due this AUTHOR from this code shall be
+//   clearly and unambiguously cited and evident during any use, whether in
+//   whole or in part.
+//
+//   The public sharing of this code does not relinquish, reduce, restrict or
+//   encumber any rights the AUTHOR has in respect to claims of intellectual
+//   property.
+//
+//   IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY
+//   DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+//   OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+//   STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//   ANY WAY OUT OF THE USE OF THIS SOFTWARE, CODE, OR CODE FRAGMENT(S), EVEN
+//   IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//   -------------------------------------------------------------------------
+//
+//                             ALL RIGHTS RESERVED
+//
+//   -------------------------------------------------------------------------
+//
+//   Author:	Mark Tompkins
+//   Revision:	4913.37729
+//   Copyright:	(c)2013
+//
@@ -0,0 +1,215 @@
+// rsiEngine.cpp
+// See rsiEngine.h and relStrIdx.cpp for the formula that is applied
+// The batch kernel behind relStrIdx lives here with the engine so both are built from the same primitives.
+
+#include <limits>
+#include "rsiEngine.h"
+
+using namespace std;
+
+rsiEngine::rsiEngine(int lookback)
+{
+	N = lookback;
+	reset();
+}
+
+void rsiEngine::reset()
+{
+	state.lastPrice = 0;
+	state.avgGain = 0;
+	state.avgLoss = 0;
+	state.count = -1;
+}
+
+double rsiEngine::update(double price)
+{
+	// First observation.  There is no change to measure.
+	if (state.count < 0)
+	{
+		state.lastPrice = price;
+		state.count = 0;
+		return numeric_limits<double>::quiet_NaN();
+	}
+
+	double advance, decline;
+	rsiAdvDec(price, state.lastPrice, advance, decline);
+	state.lastPrice = price;
+
+	// Once seeded only 'count > N' matters.  Capped so a live engine never overflows.
+	if (state.count <= N)
+	{
+		state.count++;
+	}
+
+	if (!rsiAdvance(state.count, N, advance, decline, state.avgGain, state.avgLoss))
+	{
+		return numeric_limits<double>::quiet_NaN();
+	}
+
+	return rsiValue(state.avgGain, state.avgLoss);
+}
+
+// Advance, decline, Wilder averages and RSI for every lookback of 'numCols' adjacent instruments in one forward pass.
+// Instrument mm, lookback kk is written to RSI[ii + mm * rowsData + kk * lookbackStride].
+// scratch holds numCols * (2 * numObsv + 2) + 3 * numObsv values: the state of each instrument and lookback, the
+// current advance and decline of each instrument, the coefficients of each lookback and a row of RSI values.
+// No other memory is used.
+void rsiKernel(const double *barsInPtr, int rowsData, int numCols, const double *obsvIn, int numObsv, int maxObsv,
+	double *scratch, double *RSI, int lookbackStride)
+{
+	// Create a NaN value
+	double m_Nan = std::numeric_limits<double>::quiet_NaN(); 
+
+	// State of lookback kk, instrument mm is [kk * numCols + mm] so instruments are contiguous
+	double *avgGain = scratch;
+	double *avgLoss = avgGain + numObsv * numCols;
+	double *adv = avgLoss + numObsv * numCols;
+	double *dec = adv + numCols;
+	double *decay = dec + numCols;
+	double *weight = decay + numObsv;
+	double *rsiRow = weight + numObsv;
+
+	for (int kk = 0; kk < numObsv; kk++)
+	{
+		decay[kk] = rsiDecay(obsvIn[kk]);
+		weight[kk] = rsiWeight(obsvIn[kk]);
+	}
+
+	for (int state = 0; state < numObsv * numCols; state++)
+	{
+		avgGain[state] = 0;
+		avgLoss[state] = 0;
+	}
+
+	// The first observation has no change
+	for (int kk = 0; kk < numObsv && rowsData > 0; kk++)
+	{
+		for (int mm = 0; mm < numCols; mm++)
+		{
+			RSI[mm * rowsData + kk * lookbackStride] = m_Nan;
+		}
+	}
+
+	for (int ii = 1; ii < rowsData; ii++)
+	{
+		for (int mm = 0; mm < numCols; mm++)
+		{
+			rsiAdvDec(barsInPtr[ii + mm * rowsData], barsInPtr[ii - 1 + mm * rowsData], adv[mm], dec[mm]);
+		}
+
+		// Until the longest lookback has been seeded a lookback may still be warming up
+		if (ii <= maxObsv)
+		{
+			for (int kk = 0; kk < numObsv; kk++)
+			{
+				for (int mm = 0; mm < numCols; mm++)
+				{
+					int state = kk * numCols + mm;
+
+					if (rsiAdvance(ii, obsvIn[kk], adv[mm], dec[mm], avgGain[state], avgLoss[state]))
+					{
+						RSI[ii + mm * rowsData + kk * lookbackStride] = rsiValue(avgGain[state], avgLoss[state]);
+					}
+					else
+					{
+						RSI[ii + mm * rowsData + kk * lookbackStride] = m_Nan;
+					}
+				}
+			}
+		}
+		// Every lookback is in its recursion.  A single instrument's lookbacks are contiguous so the update is
+		// vectorized across lookbacks.  The row is gathered first as the columns of the output are far apart.
+		else if (numCols == 1)
+		{
+			double advance = adv[0];
+			double decline = dec[0];
+
+			for (int kk = 0; kk < numObsv; kk++)
+			{
+				rsiWilder(decay[kk], weight[kk], advance, decline, avgGain[kk], avgLoss[kk]);
+				rsiRow[kk] = rsiRatio(avgGain[kk], avgLoss[kk]);
+			}
+
+			// As rsiValue.  A lookback without a loss is 100.
+			for (int kk = 0; kk < numObsv; kk++)
+			{
+				RSI[ii + kk * lookbackStride] = (avgLoss[kk] == 0) ? 100 : rsiRow[kk];
+			}
+		}
+		// Branch free across instruments
+		else
+		{
+			for (int kk = 0; kk < numObsv; kk++)
+			{
+				double decayK = decay[kk];
+				double weightK = weight[kk];
+				double *gainK = avgGain + kk * numCols;
+				double *lossK = avgLoss + kk * numCols;
+
+				for (int mm = 0; mm < numCols; mm++)
+				{
+					rsiWilder(decayK, weightK, adv[mm], dec[mm], gainK[mm], lossK[mm]);
+				}
+
+				for (int mm = 0; mm < numCols; mm++)
+				{
+					RSI[ii + mm * rowsData + kk * lookbackStride] = rsiValue(gainK[mm], lossK[mm]);
+				}
+			}
+		}
+	}
+}
+//
+//  -------------------------------------------------------------------------
+//                                  _    _ 
+//         ___  _ __   ___ _ __    / \  | | __ _  ___   ___  _ __ __ _ 
+//        / _ \| '_ \ / _ \ '_ \  / _ \ | |/ _` |/ _ \ / _ \| '__/ _` |
+//       | (_) | |_) |  __/ | | |/ ___ \| | (_| | (_) | (_) | | | (_| |
+//        \___/| .__/ \___|_| |_/_/   \_\_|\__, |\___(_)___/|_|  \__, |
+//             |_|                         |___/                 |___/
+//  -------------------------------------------------------------------------
+//        This code is distributed in the hope that it will be useful,
+//
+//                      	   WITHOUT ANY WARRANTY
+//
+//                  WITHOUT CLAIM AS TO MERCHANTABILITY
+//
+//                  OR FITNESS FOR A PARTICULAR PURPOSE
+//
+//                          expressed or implied.
+//
+//   Use of this code, pseudocode, algorithmic or trading logic contained
+//   herein, whether sound or faulty for any purpose is the sole
+//   responsibility of the USER. Any such use of these algorithms, coding
+//   logic or concepts in whole or in part carry no covenant of correctness
+//   or recommended usage from the AUTHOR or any of the possible
+//   contributors listed or unlisted, known or unknown.
+//
+//   Any reference of this code or to this code including any variants from
+//   this code, or any other credits due this AUTHOR from this code shall be
+//   clearly and unambiguously cited and evident during any use, whether in
+//   whole or in part.
+//
+//   The public sharing of this code does not relinquish, reduce, restrict or
+//   encumber any rights the AUTHOR has in respect to claims of intellectual
+//   property.
+//
+//   IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY
+//   DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+//   OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+//   STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//   ANY WAY OUT OF THE USE OF THIS SOFTWARE, CODE, OR CODE FRAGMENT(S), EVEN
+//   IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//   -------------------------------------------------------------------------
+//
+//                             ALL RIGHTS RESERVED
+//
+//   -------------------------------------------------------------------------
+//
+//   Author:	Mark Tompkins
+//   Revision:	4906.24976
+//   Copyright:	(c)2013
+//
\ No newline at end of file
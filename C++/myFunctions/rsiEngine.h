@@ -0,0 +1,174 @@
+#ifndef RSIENGINE_H
+#define RSIENGINE_H
+
+// rsiEngine
+// Incremental relative strength index shared by relStrIdx (batch) and live use.
+//
+// Holds the Wilder state of a single lookback: the last price, the average gain and loss, and the number of
+// price changes seen.  Each observation is added in O(1).  Results are identical to a batch run of relStrIdx
+// over the same history because its kernel (rsiKernel) is built on the same primitives (rsiAdvance, rsiValue).
+// drivers/rsiReplay.cpp checks the two against each other.
+//
+// The first observation has no change and the RSI is NaN until 'lookback' changes have been seen.
+// The average of the first 'lookback' changes seeds the state, which then follows Wilder's recursion
+//		avg[0] = ((avg[-1] * (N-1)) + change[0]) / N
+//
+// The state may be saved and restored (e.g. persisted between sessions) with getState | setState.
+
+// Advance | decline of a price from the price prior
+inline void rsiAdvDec(double price, double lastPrice, double &advance, double &decline)
+{
+	double change = price - lastPrice;
+
+	if (change > 0)
+	{
+		advance = change;
+		decline = 0;
+	}
+	else
+	{
+		advance = 0;
+		decline = -change;
+	}
+}
+
+// Coefficients of Wilder's recursion for a lookback of N
+inline double rsiDecay(double N) { return (N - 1) / N; }
+inline double rsiWeight(double N) { return 1 / N; }
+
+// Wilder's recursion for a seeded state, ((avg * (N-1)) + change) / N, with the coefficients given so the
+// divisions are made once per lookback rather than once per observation
+inline void rsiWilder(double decay, double weight, double advance, double decline, double &avgGain, double &avgLoss)
+{
+	avgGain = (avgGain * decay) + (advance * weight);
+	avgLoss = (avgLoss * decay) + (decline * weight);
+}
+
+// Advance the state of one lookback by one change.  'count' is the number of changes including this one.
+// While warming up the averages hold running sums.  Returns true once the state is seeded (count >= N).
+inline bool rsiAdvance(int count, double N, double advance, double decline, double &avgGain, double &avgLoss)
+{
+	if (count < N)
+	{
+		avgGain = avgGain + advance;
+		avgLoss = avgLoss + decline;
+		return false;
+	}
+	else if (count == N)
+	{
+		avgGain = (avgGain + advance) / N;
+		avgLoss = (avgLoss + decline) / N;
+		return true;
+	}
+
+	rsiWilder(rsiDecay(N), rsiWeight(N), advance, decline, avgGain, avgLoss);
+	return true;
+}
+
+// 100 - 100 / (1 + RS) written with a single division, 100 * avgGain / (avgGain + avgLoss).
+// Not defined when avgLoss is zero.  Free of branches so a row of lookbacks vectorizes.
+inline double rsiRatio(double avgGain, double avgLoss)
+{
+	return 100 * avgGain / (avgGain + avgLoss);
+}
+
+// RSI of a seeded state
+inline double rsiValue(double avgGain, double avgLoss)
+{
+	return (avgLoss == 0) ? 100 : rsiRatio(avgGain, avgLoss);
+}
+
+// Create a struct for the persistent state
+typedef struct rsiState
+{
+	double lastPrice;
+	double avgGain;								// Running sum of advances while warming up
+	double avgLoss;								// Running sum of declines while warming up
+	int count;									// Number of price changes seen, capped at N + 1 (-1 before the first observation)
+} rsiState;
+
+class rsiEngine
+{
+public:
+	rsiEngine(int lookback);
+
+	// Clear all state so the engine can be reused on a new history
+	void reset();
+
+	// Add one observation in O(1) time.  Returns the RSI, or NaN while warming up.
+	double update(double price);
+
+	// Returns true once 'lookback' changes have been seen
+	bool ready() const { return state.count >= N; }
+	int lookback() const { return int(N); }
+
+	// Save | restore the state.  A restored engine continues exactly as the saved one would have.
+	rsiState getState() const { return state; }
+	void setState(const rsiState &saved) { state = saved; }
+
+private:
+	double N;
+	rsiState state;
+};
+
+// Batch RSI of 'numCols' adjacent instruments (column major, 'rowsData' each) for every lookback in one forward pass.
+// Used by relStrIdx.  Instrument mm, lookback kk is written to RSI[ii + mm * rowsData + kk * lookbackStride].
+// 'scratch' must hold numCols * (2 * numObsv + 2) + 3 * numObsv values.  'maxObsv' is the longest lookback.
+void rsiKernel(const double *barsInPtr, int rowsData, int numCols, const double *obsvIn, int numObsv, int maxObsv,
+	double *scratch, double *RSI, int lookbackStride);
+
+#endif // RSIENGINE_H
+//
+//  -------------------------------------------------------------------------
+//                                  _    _ 
+//         ___  _ __   ___ _ __    / \  | | __ _  ___   ___  _ __ __ _ 
+//        / _ \| '_ \ / _ \ '_ \  / _ \ | |/ _` |/ _ \ / _ \| '__/ _` |
+//       | (_) | |_) |  __/ | | |/ ___ \| | (_| | (_) | (_) | | | (_| |
+//        \___/| .__/ \___|_| |_/_/   \_\_|\__, |\___(_)___/|_|  \__, |
+//             |_|                         |___/                 |___/
+//  -------------------------------------------------------------------------
+//        This code is distributed in the hope that it will be useful,
+//
+//                      	   WITHOUT ANY WARRANTY
+//
+//                  WITHOUT CLAIM AS TO MERCHANTABILITY
+//
+//                  OR FITNESS FOR A PARTICULAR PURPOSE
+//
+//                          expressed or implied.
+//
+//   Use of this code, pseudocode, algorithmic or trading logic contained
+//   herein, whether sound or faulty for any purpose is the sole
+//   responsibility of the USER. Any such use of these algorithms, coding
+//   logic or concepts in whole or in part carry no covenant of correctness
+//   or recommended usage from the AUTHOR or any of the possible
+//   contributors listed or unlisted, known or unknown.
+//
+//   Any reference of this code or to this code including any variants from
+//   this code, or any other credits due this AUTHOR from this code shall be
+//   clearly and unambiguously cited and evident during any use, whether in
+//   whole or in part.
+//
+//   The public sharing of this code does not relinquish, reduce, restrict or
+//   encumber any rights the AUTHOR has in respect to claims of intellectual
+//   property.
+//
+//   IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY
+//   DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+//   OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+//   STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//   ANY WAY OUT OF THE USE OF THIS SOFTWARE, CODE, OR CODE FRAGMENT(S), EVEN
+//   IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//   -------------------------------------------------------------------------
+//
+//                             ALL RIGHTS RESERVED
+//
+//   -------------------------------------------------------------------------
+//
+//   Author:	Mark Tompkins
+//   Revision:	4906.24976
+//   Copyright:	(c)2013
+//
\ No newline at end of file
@@ -18,6 +18,8 @@ function [dirtyS] = insEchos( s )
 %
 %	Note:	Matrix inputs are permitted
 %
+%   See also INSECHOS_MEX
+%
 
 dirtyS = s;
 [rows,cols] = size(dirtyS);
@@ -26,8 +28,8 @@ dirtyS = s;
 for jj = 1:cols
     % Iterate rows
     for ii = 2:rows
-        if  dirtyS(ii) == 0
-            dirtyS(ii) = dirtyS(ii-1);
+        if  dirtyS(ii,jj) == 0
+            dirtyS(ii,jj) = dirtyS(ii-1,jj);
         end; %if
     end; %for ii
 end; %for jj
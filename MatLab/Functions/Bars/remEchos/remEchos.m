@@ -12,6 +12,8 @@ function [cleanS] = remEchos( s )
 %	This output is now "actionable" as a SIGNAL
 %
 %   Note: This function can accept a vectorized matrix
+%
+%   See also REMECHOS_MEX
 
 cleanS = s;
 [rows,cols] = size(cleanS);
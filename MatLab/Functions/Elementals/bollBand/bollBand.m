@@ -26,6 +26,8 @@ function [lBand, mAvg, uBand] = bollBand(price, period, maType, devUp, devDwn)
 %	OUTPUTS		lBand		Lower Bollinger band    (MA - Kstd)
 %				mBand		Midline average         (MA)
 %               uBand       Upper Bollinger band    (MA + Kstd)
+%
+%   See also BOLLBAND_MEX, which also accepts vectors of (DEVUP, DEVDWN) pairs (one band per pair).
 
 %% MEX code to be skipped
 coder.extrinsic('movAvg_mex','slidefun');
@@ -15,6 +15,8 @@ function [ tLine,iTrend ] = iTrend(price)
 %
 %   [T,I] = ITREND(PRICE) returns the trendline T
 %
+%   See also ITREND_MEX, which also accepts an N x M array of instruments.
+%
 
 %% Error check
 rows = size(price,1);
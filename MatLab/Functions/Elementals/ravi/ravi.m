@@ -28,6 +28,8 @@ function [ ind ] = ravi(price,lead,lag,D,M)
 %								D		0
 %								M		20
 %
+%   See also RAVI_MEX, which also accepts vectors of (LEAD, LAG) pairs (one column per pair).
+%
 
 %% MEX code to be skipped
 coder.extrinsic('exist','slidefun','atr_mex');
@@ -31,6 +31,8 @@ function amp = snr(price,iMult,qMult)
 %									qMult	0.338
 %   amp = SNR(PRICE,...)	Returns a SNR vector with declared values
 %
+%   See also SNR_MEX, which also accepts vectors of IMULT and QMULT (one column per pair).
+%
 
 %% MEX code to be skipped
 coder.extrinsic('OHLCSplitter');
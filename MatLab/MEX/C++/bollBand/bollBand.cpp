@@ -0,0 +1,248 @@
+// bollBand.cpp
+// Localized mex'ing: mex COMPFLAGS="$COMPFLAGS /openmp" bollBand.cpp bollEngine.cpp -output bollBand_mex
+//		(OpenMP is optional.  Without it instruments are processed serially.)
+//
+// Native Bollinger bands.  The midline is a moving average and the bands are a number of (sample) standard
+// deviations above and below it.
+//
+//	NOTE:	bollBand.m makes a full pass for the standard deviation (slidefun) and another for the average
+//			(movAvg_mex) before building the bands.  This kernel keeps a Welford style rolling mean and sum of
+//			squared deviations over the window, updated in O(1) per bar, and writes the midline and every band
+//			pair in the same pass.  The moments are shared so each additional (devUp, devDwn) pair costs two
+//			multiply-adds per bar.  The accumulator is rebuilt exactly every RESYNC_BARS bars to bound drift.
+//			A NaN price poisons the rolling state, so the NaNs in the window are counted and the state is
+//			rebuilt from the window once the last of them has rolled out.
+//
+// nlhs Number of output variables nargout 
+// plhs Array of mxArray pointers to the output variables varargout
+// nrhs Number of input variables nargin
+// prhs Array of mxArray pointers to the input variables varargin
+//
+// Matlab function:
+// [lBand, mAvg, uBand] = bollBand_mex(price, period, maType, devUp, devDwn)
+// 
+// Inputs:
+//		price		An N x 1 array of prices ordinarily 'Close', or an N x M array of M instruments
+//		period		Lookback of the average and the standard deviation (>= 2)
+//		maType		Midline average as movAvg:
+//						 0	-	Simple (the rolling mean)
+//						-1	-	Exponential (seeded with the first price)
+//						-2	-	Geometric (rolling sum of logs)
+//						-3	-	Harmonic (rolling sum of reciprocals)
+//						-4	-	Trimmed 10% (sorted window, as trimmean rounding halves down)
+//						-5	-	Triangle (as tsmovavg 't': a simple average of a simple average of ceil((period+1)/2))
+//						>0	-	Weighted with weights (period - ii + 1)^maType
+//		devUp		Standard deviations above the midline, or a vector of K values
+//		devDwn		Standard deviations below the midline, or a vector of K values.  The sign is ignored.
+//
+//		devUp and devDwn form K pairs (devUp(k), devDwn(k)).  A scalar is paired with every value of the other.
+//
+// Outputs:
+//		lBand		Lower bands (MA - devDwn * std).  N x K, or N x M x K for M instruments.
+//		mAvg		Midline average.  N x M.
+//		uBand		Upper bands (MA + devUp * std).  N x K, or N x M x K for M instruments.
+//
+//		As bollBand.m the first 'period' observations are NaN, as is any bar whose window holds a NaN price.
+//
+
+#include "mex.h"
+#include <cmath>
+#include "bollEngine.h"
+
+using namespace std;
+
+// Macros
+#define isReal2DfullDouble(P) (!mxIsComplex(P) && mxGetNumberOfDimensions(P) == 2 && !mxIsSparse(P) && mxIsDouble(P))
+#define isRealScalar(P) (isReal2DfullDouble(P) && mxGetNumberOfElements(P) == 1)
+#define isRealVector(P) (isReal2DfullDouble(P) && mxGetNumberOfElements(P) > 0 && (mxGetM(P) == 1 || mxGetN(P) == 1))
+
+// Prototypes
+mxArray *bollCreateBands(int rows, int cols, int numPairs);
+
+void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
+				 int nrhs, const mxArray *prhs[]) /* Input variables */
+{
+	// Check number of inputs
+	if (nrhs != 5)
+		mexErrMsgIdAndTxt( "MATLAB:bollBand:NumInputs",
+		"Number of input arguments is not correct. Aborting.");
+
+	if (nlhs > 3)
+		mexErrMsgIdAndTxt( "MATLAB:bollBand:NumOutputs",
+		"Number of output assignments is not correct. Aborting.");
+
+	// Define constants (#define assigns a variable as either a constant or a macro)
+	// Inputs
+#define price_IN	prhs[0]
+#define period_IN	prhs[1]
+#define maType_IN	prhs[2]
+#define devUp_IN	prhs[3]
+#define devDwn_IN	prhs[4]
+
+	// Outputs
+#define lBand_OUT	plhs[0]
+#define mAvg_OUT	plhs[1]
+#define uBand_OUT	plhs[2]
+
+	// Check type of supplied inputs
+	if (!isReal2DfullDouble(price_IN)) 
+		mexErrMsgIdAndTxt( "MATLAB:bollBand:BadInputType",
+		"Input 'price' must be a 2 dimensional full double array. Aborting.");
+
+	if (!isRealScalar(period_IN) || !isRealScalar(maType_IN))
+		mexErrMsgIdAndTxt( "MATLAB:bollBand:BadInputType",
+		"Inputs 'period' and 'maType' must be scalars. Aborting.");
+
+	if (!isRealVector(devUp_IN) || !isRealVector(devDwn_IN))
+		mexErrMsgIdAndTxt( "MATLAB:bollBand:BadInputType",
+		"Inputs 'devUp' and 'devDwn' must be scalars or vectors. Aborting.");
+
+	int rows = int(mxGetM(price_IN));
+	int cols = int(mxGetN(price_IN));
+	int period = int(mxGetScalar(period_IN));
+	double maType = mxGetScalar(maType_IN);
+	int numUp = int(mxGetNumberOfElements(devUp_IN));
+	int numDwn = int(mxGetNumberOfElements(devDwn_IN));
+
+	if (period < 2 || period > rows)
+		mexErrMsgIdAndTxt( "MATLAB:bollBand:BadInputType",
+		"The period must be at least 2 and no greater than the number of observations. Aborting.");
+
+	if (maType < 0 && (maType != floor(maType) || maType < -5))
+		mexErrMsgIdAndTxt( "MATLAB:bollBand:BadInputType",
+		"This type of average calculation is currently unhandled or known. Aborting.");
+
+	if (numUp != numDwn && numUp != 1 && numDwn != 1)
+		mexErrMsgIdAndTxt( "MATLAB:bollBand:BadInputType",
+		"Inputs 'devUp' and 'devDwn' must have the same number of elements or one must be a scalar. Aborting.");
+
+	int numPairs = (numUp > numDwn) ? numUp : numDwn;
+
+	/* Assign pointers to the input array */ 
+	double *pricePtr = mxGetPr(price_IN);
+	double *devUpPtr = mxGetPr(devUp_IN);
+	double *devDwnPtr = mxGetPr(devDwn_IN);
+
+	/* Create matrices for the return arguments */ 
+	lBand_OUT = bollCreateBands(rows, cols, numPairs);
+	mAvg_OUT = mxCreateDoubleMatrix(rows, cols, mxREAL);
+	uBand_OUT = bollCreateBands(rows, cols, numPairs);
+
+	double *lBandPtr = mxGetPr(lBand_OUT);
+	double *mAvgPtr = mxGetPr(mAvg_OUT);
+	double *uBandPtr = mxGetPr(uBand_OUT);
+
+	// Filter weights of a weighted or triangle midline are normalized once and shared by every instrument.
+	// A trimmed midline keeps a sorted copy of each instrument's window.
+	// Scratch is allocated here as workers do not call the Matlab API.
+	double *weights = (double*)mxMalloc((period + 1) * sizeof(double));
+	int numWeights = bollWeights(period, maType, weights);
+	double *window = (double*)mxMalloc((maType == -4 ? cols * period : 1) * sizeof(double));
+
+	/////////////
+	// START
+	/////////////
+
+	// Pair kk of instrument mm is column (mm + kk * cols)
+	int pairStride = rows * cols;
+
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+	for (int col = 0; col < cols; col++)
+	{
+		bollKernel(pricePtr + col * rows, rows, period, maType, weights, numWeights, devUpPtr, devDwnPtr, numUp, numDwn,
+			numPairs, maType == -4 ? window + col * period : NULL, lBandPtr + col * rows, mAvgPtr + col * rows,
+			uBandPtr + col * rows, pairStride);
+	}
+
+	mxFree(weights);
+	mxFree(window);
+
+	// Release outputs which were not requested
+	if (nlhs < 3)
+	{
+		mxDestroyArray(uBand_OUT);
+	}
+
+	if (nlhs < 2)
+	{
+		mxDestroyArray(mAvg_OUT);
+	}
+
+	/////////////
+	// FINISHED
+	/////////////
+
+	return;
+}
+
+/////////////
+//
+// FUNCTIONS & METHODS
+//
+/////////////
+
+// Band output following relStrIdx: N x K for a single instrument, N x M x K otherwise
+mxArray *bollCreateBands(int rows, int cols, int numPairs)
+{
+	if (cols > 1 && numPairs > 1)
+	{
+		mwSize dims[3] = {(mwSize)rows, (mwSize)cols, (mwSize)numPairs};
+		return mxCreateNumericArray(3, dims, mxDOUBLE_CLASS, mxREAL);
+	}
+
+	return mxCreateDoubleMatrix(rows, cols * numPairs, mxREAL);
+}
+//
+//  -------------------------------------------------------------------------
+//                                  _    _ 
+//         ___  _ __   ___ _ __    / \  | | __ _  ___   ___  _ __ __ _ 
+//        / _ \| '_ \ / _ \ '_ \  / _ \ | |/ _` |/ _ \ / _ \| '__/ _` |
+//       | (_) | |_) |  __/ | | |/ ___ \| | (_| | (_) | (_) | | | (_| |
+//        \___/| .__/ \___|_| |_/_/   \_\_|\__, |\___(_)___/|_|  \__, |
+//             |_|                         |___/                 |___/
+//  -------------------------------------------------------------------------
+//        This code is distributed in the hope that it will be useful,
+//
+//                      	   WITHOUT ANY WARRANTY
+//
+//                  WITHOUT CLAIM AS TO MERCHANTABILITY
+//
+//                  OR FITNESS FOR A PARTICULAR PURPOSE
+//
+//                          expressed or implied.
+//
+//   Use of this code, pseudocode, algorithmic or trading logic contained
+//   herein, whether sound or faulty for any purpose is the sole
+//   responsibility of the USER. Any such use of these algorithms, coding
+//   logic or concepts in whole or in part carry no covenant of correctness
+//   or recommended usage from the AUTHOR or any of the possible
+//   contributors listed or unlisted, known or unknown.
+//
+//   Any reference of this code or to this code including any variants from
+//   this code, or any other credits due this AUTHOR from this code shall be
+//   clearly and unambiguously cited and evident during any use, whether in
+//   whole or in part.
+//
+//   The public sharing of this code does not relinquish, reduce, restrict or
+//   encumber any rights the AUTHOR has in respect to claims of intellectual
+//   property.
+//
+//   IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY
+//   DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+//   OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+//   STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//   ANY WAY OUT OF THE USE OF THIS SOFTWARE, CODE, OR CODE FRAGMENT(S), EVEN
+//   IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//   -------------------------------------------------------------------------
+//
+//                             ALL RIGHTS RESERVED
+//
+//   -------------------------------------------------------------------------
+//
+//   Author:	Mark Tompkins
+//   Revision:	4906.24976
+//   Copyright:	(c)2013
+//
\ No newline at end of file
@@ -1,5 +1,7 @@
 // calcProfitLoss.cpp 
 // http://www.kobashicomputing.com/node/177 for a reference to x64 bit
+// Localized mex'ing: mex COMPFLAGS="$COMPFLAGS /openmp" calcProfitLoss.cpp myMath.cpp plEngine.cpp
+//		(OpenMP is optional.  Without it multiple signal columns are processed serially.)
 //
 // nlhs Number of output variables nargout 
 // plhs Array of mxArray pointers to the output variables varargout
@@ -8,12 +10,20 @@
 //
 // Matlab function:
 // [cash,openEQ,netLiq,returns] = calcProfitLoss(data,sig,bigPoint,cost)
+// [cash,openEQ,netLiq,returns,blotter] = calcProfitLoss(data,sig,bigPoint,cost)
+// [...] = calcProfitLoss(data,sig,bigPoint,cost,minTick)
 // 
 // Inputs:
-//		data		A 2-D array of prices in the form of Open | Close
+//		data		A 2-D array of prices in the form of Open | Close or Open | High | Low | Close
 //		sig			An array the same length as data, which gives the quantity bought or sold on a given bar.  Consider Matlab remEchosMEX
+//					May be an N x K matrix where each column is an independent signal evaluated against the same data
 //		bigPoint	Double representing the full tick dollar value of the contract being P&L'd
 //		cost		Double representing the per contract commission
+//		minTick		(optional) Double representing the minimum tick increment of the contract.
+//					When given, P&L is calculated in fixed point.  Prices are converted once to whole ticks,
+//					ledger and cumulative cash arithmetic is integer, and results are converted to dollars
+//					(ticks * minTick * bigPoint) only at output.  This avoids drift over large numbers of fills.
+//					Signals are snapped to the nearest half unit so |0.5| instructions are recognized exactly.
 //
 // Outputs:
 //		cash		A 2D array of cash debts and credits
@@ -21,6 +31,22 @@
 //		netLiq		A 2D array of aggregated cash transactions plus the current openEQ if any up to a given observation
 //		returns		A 2D array of bar to bar returns
 //
+//		blotter		(optional) A 1 x K struct array, one element per column of 'sig', of closed round trips.
+//					Each field is a column vector with one row per closed ledger line item (or portion of one):
+//						entryBar	Observation the entry was filled on
+//						exitBar		Observation the exit was filled on
+//						quantity	Quantity closed (positive long, negative short)
+//						entryPrice	Fill price of the entry
+//						exitPrice	Fill price of the exit
+//						grossPL		P&L before commission
+//						netPL		P&L after commission.  Sums to the column's cash.
+//						MAE			Maximum adverse excursion while open
+//						MFE			Maximum favorable excursion while open
+//					Excursions use High | Low when given, otherwise Open | Close.
+//					The blotter is built in the same pass and only when requested.
+//
+//		All outputs have one column per column of 'sig'
+//
 //	NOTE: This function accepts both advanced (fractional) and standard SIGNAL inputs
 //
 //		By leveraging fractions as additional logic, we are able to construct more meaningful signals beyond the scope of a simple Buy or Sell of quantity X.
@@ -61,9 +87,10 @@
 //
 
 #include "mex.h"
-#include <deque>
 #include <cmath>
 #include "myMath.h"
+#include "plEngine.h"
+#include <vector>
 
 // Declare external reference to undocumented C function
 #ifdef __cplusplus
@@ -80,23 +107,13 @@ extern "C"
 
 using namespace std;
 
-// Create a struct for convenience
-typedef struct tradeEntry
-{
-	int index;
-	int quantity;
-	double price;
-} tradeEntry;
-
 // Prototypes
-tradeEntry createLineEntry(int ID, int qty, double price);
-int sumQty(const deque<tradeEntry>& x);
-bool fraction(double num);
-bool knownAdvSig(double advSig);
+mxArray *createBlotter(const vector<blotterEntry> *blotters, int numCols);
 
 // Macros
 #define isReal2DfullDouble(P) (!mxIsComplex(P) && mxGetNumberOfDimensions(P) == 2 && !mxIsSparse(P) && mxIsDouble(P))
 #define isRealScalar(P) (isReal2DfullDouble(P) && mxGetNumberOfElements(P) == 1)
+#define codeLine	__LINE__	// help error trapping in MatLab
 
 void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				 int nrhs, const mxArray *prhs[]) /* Input variables */
@@ -111,13 +128,13 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 	// mexPrintf("Hello, world!"); /* Do something interesting */
 
 	// Check number of inputs
-	if (nrhs != 4)
+	if (nrhs != 4 && nrhs != 5)
 		mexErrMsgIdAndTxt( "MATLAB:calcProfitLoss:NumInputs",
-		"Number of input arguments is not correct. Aborting (116).");
+		"Number of input arguments is not correct. Aborting (%d).", codeLine);
 
-	if (nlhs != 4)
+	if (nlhs != 4 && nlhs != 5)
 		mexErrMsgIdAndTxt( "MATLAB:calcProfitLoss:NumOutputs",
-		"Number of output assignments is not correct. Aborting (120).");
+		"Number of output assignments is not correct. Aborting (%d).", codeLine);
 
 	// Define constants (#define assigns a variable as either a constant or a macro)
 	// Inputs
@@ -125,58 +142,64 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 #define sig_IN		prhs[1]
 #define bigPoint_IN	prhs[2]
 #define cost_IN		prhs[3]
+#define minTick_IN	prhs[4]
 	// Outputs
 #define cash_OUT	plhs[0]
 #define openEQ_OUT	plhs[1]
 #define netLiq_OUT	plhs[2]
 #define returns_OUT	plhs[3]
+#define blotter_OUT	plhs[4]
 
 	// Init Global variables
 	mwSize rowsData, colsData, rowsSig, colsSig;
 	double *cashIdx, *openEQIdx, *netLiqIdx, *returnsIdx, *dataInPtr, *sigInPtr; // *bigPointPtr, *costPtr;
 
 	// Check type of supplied inputs
-	if (!isReal2DfullDouble(data_IN)) 
+	if (!isReal2DfullDouble(data_IN))
 		mexErrMsgIdAndTxt( "MATLAB:calcProfitLoss:BadInputType",
-		"Input 'data' must be a 2 dimensional full double array. Aborting (141).");
+		"Input 'data' must be a 2 dimensional full double array. Aborting (%d).", codeLine);
 
-	if (!isReal2DfullDouble(sig_IN)) 
+	if (!isReal2DfullDouble(sig_IN))
 		mexErrMsgIdAndTxt( "MATLAB:calcProfitLoss:BadInputType",
-		"Input 'sig' must be a 2 dimensional full double array. Aborting (145).");
+		"Input 'sig' must be a 2 dimensional full double array. Aborting (%d).", codeLine);
 
-	if (!isRealScalar(bigPoint_IN)) 
+	if (!isRealScalar(bigPoint_IN))
 		mexErrMsgIdAndTxt( "MATLAB:calcProfitLoss:BadInputType",
-		"Input 'bigPoint' must be a single scalar double. Aborting (149).");
+		"Input 'bigPoint' must be a single scalar double. Aborting (%d).", codeLine);
 
-	if (!isRealScalar(cost_IN)) 
+	if (!isRealScalar(cost_IN))
 		mexErrMsgIdAndTxt( "MATLAB:calcProfitLoss:BadInputType",
-		"Input 'cost' must be a single scalar double. Aborting (153).");
+		"Input 'cost' must be a single scalar double. Aborting (%d).", codeLine);
+
+	if (nrhs == 5 && !isRealScalar(minTick_IN))
+		mexErrMsgIdAndTxt( "MATLAB:calcProfitLoss:BadInputType",
+		"Input 'minTick' must be a single scalar double. Aborting (%d).", codeLine);
 
 	// Assign variables
 	rowsData = mxGetM(data_IN);
 	colsData = mxGetN(data_IN);
 	rowsSig = mxGetM(sig_IN);
-	colsSig = mxGetN(sig_IN);		
+	colsSig = mxGetN(sig_IN);
 
 	if (rowsData != rowsSig)
 		mexErrMsgIdAndTxt( "MATLAB:calcProfitLoss:ArrayMismatch",
-		"The number of rows in the data array and the signal array are different. Aborting (163).");
+		"The number of rows in the data array and the signal array are different. Aborting (%d).", codeLine);
 
-	if (colsSig > 1)
+	if (colsSig < 1)
 		mexErrMsgIdAndTxt( "MATLAB:calcProfitLoss:ArrayMismatch",
-		"Input 'sig' must be a single column array. Aborting (167).");
+		"Input 'sig' must have at least one column. Aborting (%d).", codeLine);
 
 	if (colsData != 2 && colsData != 4)
 		mexErrMsgIdAndTxt( "MATLAB:calcProfitLoss:ArrayMismatch",
-		"Input 'data' must be in the form of 'O | C'. Aborting (171).");
+		"Input 'data' must be in the form of 'O | C'. Aborting (%d).", codeLine);
 
-	if (!isRealScalar(bigPoint_IN)) 
+	if (!isRealScalar(bigPoint_IN))
 		mexErrMsgIdAndTxt( "MATLAB:calcProfitLoss:ScalarMismatch",
-		"Input 'bigPoint' must be a double scalar value. Aborting (175).");
+		"Input 'bigPoint' must be a double scalar value. Aborting (%d).", codeLine);
 
-	if (!isRealScalar(cost_IN))  
+	if (!isRealScalar(cost_IN))
 		mexErrMsgIdAndTxt( "MATLAB:calcProfitLoss:ScalarMismatch",
-		"Input 'cost' must be a double scalar value. Aborting (179).");
+		"Input 'cost' must be a double scalar value. Aborting (%d).", codeLine);
 
 	// Primarily for readability
 	int shifter = 1;
@@ -185,252 +208,79 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 		shifter = 3;
 	}
 
-	const int SHIFT_OPEN = 0;								// For readability
 	const int SHIFT_CLOSE = rowsData * shifter;
 
-	/* Create matrices for the return arguments */ 
+	/* Create matrices for the return arguments */
 	// http://www.mathworks.com/help/matlab/matlab_external/c-c-source-mex-files.html
-	cash_OUT = mxCreateDoubleMatrix(rowsData, 1, mxREAL);
-	openEQ_OUT = mxCreateDoubleMatrix(rowsData, 1, mxREAL); 
-	netLiq_OUT = mxCreateDoubleMatrix(rowsData, 1, mxREAL); 
-	returns_OUT = mxCreateDoubleMatrix(rowsData, 1, mxREAL); 
+	// Each column of the outputs corresponds to the same column of 'sig'
+	cash_OUT = mxCreateDoubleMatrix(rowsData, colsSig, mxREAL);
+	openEQ_OUT = mxCreateDoubleMatrix(rowsData, colsSig, mxREAL);
+	netLiq_OUT = mxCreateDoubleMatrix(rowsData, colsSig, mxREAL);
+	returns_OUT = mxCreateDoubleMatrix(rowsData, colsSig, mxREAL);
 
-	/* Assign pointers to the arrays */ 
+	/* Assign pointers to the arrays */
 	dataInPtr = mxGetPr(prhs[0]);
 	sigInPtr = mxGetPr(prhs[1]);
 
+	// O | H | L | C has the close shifted past High and Low
+	const double *highPtr = (colsData == 4) ? dataInPtr + rowsData : NULL;
+	const double *lowPtr = (colsData == 4) ? dataInPtr + 2 * rowsData : NULL;
+
 	// assign values to the two variables passed as arrays
 	const double BIG_POINT = mxGetScalar(bigPoint_IN);
 	const double COST = mxGetScalar(cost_IN);
+	const double MIN_TICK = (nrhs == 5) ? mxGetScalar(minTick_IN) : 0;		// Zero is floating point
 
-	// assign the index variables for manipulating the arrays 
+	if (nrhs == 5 && !(MIN_TICK > 0))
+		mexErrMsgIdAndTxt( "MATLAB:calcProfitLoss:minTickError",
+		"Input 'minTick' must be greater than zero. Aborting (%d).", codeLine);
+
+	// assign the index variables for manipulating the arrays
 	cashIdx = mxGetPr(cash_OUT);
 	openEQIdx = mxGetPr(openEQ_OUT);
 	netLiqIdx = mxGetPr(netLiq_OUT);
 	returnsIdx = mxGetPr(returns_OUT);
 
 	// START //
-	// Initialize variables
-	int	sigIdx;							// Iterator that will store the index of the referenced signal
-	int barIdx;							// Iterator that will store the index of the referenced bar
-	bool anyTrades = false;				// Variable that indicates if we have any trades
-
-	// Check that we have at least one signal (at least one trade)
-	for (sigIdx=0; sigIdx < rowsSig; sigIdx++)					// Remember C++ starts counting at '0'
+	// Each signal column is an independent P&L against the same 'data'.
+	// Columns are distributed across cores when compiled with OpenMP.
+	// Workers may not call back into Matlab so any failure is recorded and reported afterward.
+	const int numCols = (int)colsSig;
+	bool *colOK = (bool*)mxCalloc(numCols, sizeof(bool));
+	double *colBadSig = (double*)mxCalloc(numCols, sizeof(double));
+
+	// Round trips are only recorded when the blotter is requested
+	vector<vector<blotterEntry> > blotters(nlhs == 5 ? numCols : 0);
+
+#pragma omp parallel for schedule(dynamic) if (numCols > 1)
+	for (int col = 0; col < numCols; col++)
 	{
-		if (abs(sigInPtr[sigIdx]) >=1)		// See if we have a signal that generates a position
-		{
-			anyTrades=true;					// Trade found
-			break;							// Exit the for loop
-		}
-	}	
+		const mwSize offset = (mwSize)col * rowsData;
+		colOK[col] = calcColumnPL(dataInPtr, highPtr, lowPtr, dataInPtr + SHIFT_CLOSE, sigInPtr + offset, (int)rowsData,
+			BIG_POINT, COST, MIN_TICK, cashIdx + offset, openEQIdx + offset, netLiqIdx + offset, returnsIdx + offset,
+			colBadSig[col], blotters.empty() ? NULL : &blotters[col]);
+	}
 
-	// We have trades
-	// RETURN zeros if the signal is the last bar
-	if (anyTrades && sigIdx < rowsSig)
+	for (int col = 0; col < numCols; col++)
 	{
-		// Initialize a ledger for open positions
-		deque<tradeEntry> openLedger;
-
-		// Put first trade on ledger
-		// price is 'sigIdx+1' because execution price lags signal by one observation
-		// We only need the integer portion of the first trade
-		openLedger.push_back(createLineEntry(sigIdx, int(sigInPtr[sigIdx]), dataInPtr[sigIdx+1]));
-
-		// Initialize position trackers
-		int openPosition = int(sigInPtr[sigIdx]);
-
-		// ITERATE
-		// Start iterating at next observation
-		// Finish at observation before last in signal array
-		for (int ii = sigIdx+1; ii < rowsSig-1; ii++)
-		{
-			if (sigInPtr[ii] != 0)
-			{
-				// Is this an advanced signal?
-				if (fraction(sigInPtr[ii]))
-					// Advanced signal
-				{
-					// Check for known advanced signal type
-					if (knownAdvSig(sigInPtr[ii]))
-						// Known
-					{
-						// Check for additive or reductive
-						if ((openPosition <= 0 && sigInPtr[ii] <= -1) || (openPosition >= 0 && sigInPtr[ii] >= 1))
-							// Additive
-						{
-							// We ignore reverse advance instructions when they are additive
-						}
-						// Reductive
-						else
-						{
-							// Confirm instruction is fractional reverse
-							if (abs(sigInPtr[ii] - int(sigInPtr[ii])) == 0.5)			// Reverse instruction
-							{
-								// Liquidate any open position
-								while (!openLedger.empty())
-								{
-									// Aggregate cash for corresponding observations (signal + 1)
-									cashIdx[ii+1] = cashIdx[ii+1] + ((dataInPtr[ii+1] - openLedger.front().price) * openLedger.front().quantity * BIG_POINT) - 
-										(abs(openLedger.front().quantity)* COST);
-									openLedger.pop_front();
-								}
-
-								openPosition = 0;
-							}
-							else
-							{
-								//	This is here for ease of adding additional instructions later.
-								// Unknown advanced signal.  Throw an error.
-								mexErrMsgIdAndTxt( "calcProfitLoss:AdvancedSignal:fractionUnknown",
-									"A signal contained an advanced fractional instruction %f that we could not interpret. Aborting (286).",sigInPtr[ii]);
-							}
-						}
-					}
-					else
-						// Unknown instruction
-					{
-						// Unknown advanced signal.  Throw an error.
-						mexErrMsgIdAndTxt( "calcProfitLoss:AdvancedSignal:fractionUnknown",
-							"A signal contained an advanced fractional instruction %f that we could not interpret. Aborting (295).",sigInPtr[ii]);
-					}
-				}
-
-				// Any integer and if so Additive or reductive ?
-				if ((openPosition <= 0 && sigInPtr[ii] <= -1) || (openPosition >= 0 && sigInPtr[ii] >= 1))
-					// Additive
-				{
-					// Trade is additive. Add or create existing position --> openLedger
-					openLedger.push_back(createLineEntry(ii, int(sigInPtr[ii]), dataInPtr[ii+1]));
-					openPosition = openPosition + int(sigInPtr[ii]);
-				}
-				// Reductive
-				else
-				{
-					// Signal is effectively a reverse or liquidate
-					if (int(abs(sigInPtr[ii])) >= abs(openPosition))
-					{
-						// New trade is larger than or equal to existing position. Calculate cash on all ledger lines
-						while (!openLedger.empty())
-						{
-							// Aggregate cash for corresponding observations (signal + 1)
-							cashIdx[ii+1] = cashIdx[ii+1] + ((dataInPtr[ii+1] - openLedger.front().price) * openLedger.front().quantity * BIG_POINT) - 
-								(abs(openLedger.front().quantity)* COST);
-							openLedger.pop_front();
-						}
-
-						// update open position tracker
-						openPosition = int(sigInPtr[ii]) + openPosition;
-
-						// if there is a 'remainder', this is the new net open position
-						// put it on the openLedger
-						if (openPosition != 0)
-						{
-							openLedger.push_back(createLineEntry(ii,openPosition,dataInPtr[ii+1]));
-						}
-					}
-					// partial liquidation
-					else
-					{
-						// New trade is smaller than the current open position.
-						// How many do we need to reduce by?
-						int needQty = sigInPtr[ii];
-
-						// Prepare to iterate until we are satisfied
-						while (needQty !=0)
-						{
-							// Is the current line item quantity larger than what we need?
-							if (abs(openLedger.front().quantity) > needQty)
-							{
-								// If so we will P&L the quantity we need and reduce the open position size
-								cashIdx[ii+1] = cashIdx[ii+1] + ((dataInPtr[ii+1] - openLedger.front().price) * -needQty * BIG_POINT) - 
-									(abs(needQty) * COST);
-								// Reduce the position size.  We are aggregating so we add (e.g. 5 Purchases + 4 Sales = 1 Long)
-								openLedger.front().quantity = openLedger.front().quantity + needQty;
-								// We are satisfied and don't need any more contracts
-								needQty = 0;
-							}
-							// Current line item quantity is equal to or smaller than what we need.  Process P&L and remove.
-							else
-							{
-								// P&L entire quantity
-								cashIdx[ii+1] = cashIdx[ii+1] + ((dataInPtr[ii+1] - openLedger.front().price) * -openLedger.front().quantity * BIG_POINT) - 
-									(abs(openLedger.front().quantity) * COST);
-								// Reduce needed quantity by what we've been provided
-								needQty = needQty + openLedger.front().quantity;
-								// Remove the line item (FIFO)
-								openLedger.pop_front();
-							}
-						}
-						// update open position tracker
-						openPosition = openPosition + sigInPtr[ii];
-					}
-				}
-
-			}
-
-			// Calculate current openEQ if there are any positions
-			// !!!!!!!!!!!!!!!!!!!!!!
-			// !! IMPORTANT
-			// !!!!!!!!!!!!!!!!!!!!!!
-			// Because we are using virtual bars for calculations, we have introduced a known issue
-			// that a profit may occur within an observation High or Low.  To offset this we will
-			// clean certain openEQ calculations below. This will cause some invalid depictions
-			// of open equity between observations but would be effectively be a margining issue
-			if (openPosition != 0)
-			{
-				//// We will aggregate all line items
-				for (int jj = 0; jj < openLedger.size(); jj++)
-				{
-					openEQIdx[ii+1] = openEQIdx[ii+1] + ((dataInPtr[ii+1+SHIFT_CLOSE] - openLedger[jj].price) * openLedger[jj].quantity * BIG_POINT);
-				}
-			}
-		} // end for
-
-		// destroy the deque
-		openLedger.~deque();
-
-		// These are for convenience and could be removed for optimization
-
-		// Calculate a cumulative sum of closed trades and open equity per observation
-
-		// This loop is a 'dirty' cleaning of trades that were closed on the next observation.
-		// Because we are creating a vBar for profit objectives, if the openEquity is greater than the next
-		// observation's cash, we'll reduce openEquity to equal cash.  This should normalize some spikes.
-		for (int ll = 1; ll < rowsData - 1; ll++)
+		if (!colOK[col])
 		{
-			if (openEQIdx[ll] != cashIdx[ll+1] && openEQIdx[ll+1] == 0 && cashIdx[ll+1] > 0)
-			{
-				openEQIdx[ll] = cashIdx[ll+1];
-			}
+			double badSig = colBadSig[col];
+			mxFree(colOK);
+			mxFree(colBadSig);
+			vector<vector<blotterEntry> >().swap(blotters);		// mexErrMsgIdAndTxt does not unwind
+			// Unknown advanced signal.  Throw an error.
+			mexErrMsgIdAndTxt( "calcProfitLoss:AdvancedSignal:fractionUnknown",
+				"A signal in column %d contained an advanced fractional instruction %f that we could not interpret. Aborting (%d).", col + 1, badSig, codeLine);
 		}
+	}
 
-		double runSum = 0;
-		returnsIdx[0] = 0;
-		for (int kk=0; kk < rowsData; kk++)
-		{
-			runSum = runSum + cashIdx[kk];
-			netLiqIdx[kk] = runSum + openEQIdx[kk];
-
-			// Calculate a return from day to day based on the change in value observation to observation
-			if (kk>0)
-			{
-				returnsIdx[kk] = netLiqIdx[kk] - netLiqIdx[kk-1];
-			}
-
-		} //for
+	mxFree(colOK);
+	mxFree(colBadSig);
 
-	}
-	// No trades or signal on the last observation. Return zeros.
-	else
+	if (nlhs == 5)
 	{
-		for (int mm=0; mm < rowsData; mm++)
-		{
-			cashIdx[mm] = 0;
-			openEQIdx[mm]=0;
-			netLiqIdx[mm]=0;
-			returnsIdx[mm]=0;
-		}
+		blotter_OUT = createBlotter(&blotters[0], numCols);
 	}
 
 	return;
@@ -442,44 +292,42 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 //
 /////////////
 
-// Constructor for ledger line item creation
-tradeEntry createLineEntry(int ID, int qty, double price)
+// Build the 1 x K struct array of blotters.  Bars are reported 1 based.
+mxArray *createBlotter(const vector<blotterEntry> *blotters, int numCols)
 {
-	tradeEntry lineEntry;
-	lineEntry.index = ID;
-	lineEntry.quantity = qty;
-	lineEntry.price = price;
+	const char *fieldNames[] = {"entryBar", "exitBar", "quantity", "entryPrice", "exitPrice", "grossPL", "netPL", "MAE", "MFE"};
+	const int numFields = sizeof(fieldNames) / sizeof(fieldNames[0]);
 
-	return lineEntry;
-}
+	mxArray *blotterStruct = mxCreateStructMatrix(1, numCols, numFields, fieldNames);
 
-// Method to sum the quantity values in any struct of type tradeEntry
-int sumQty(const deque<tradeEntry>& x)
-{
-	int sumOfQty = 0;  // the sum is accumulated here
-	for (deque<tradeEntry>::const_iterator it=x.begin();it!=x.end();it++)
+	for (int col = 0; col < numCols; col++)
 	{
-		//sumOfQty += x[i].price;
-		sumOfQty += it->quantity;
-	}
-
-	return sumOfQty;
-}
-
-bool knownAdvSig(double advSig)
-{
-	// We can check for known advanced signals to help in debugging
-	// by registering them here.  This can be a searchable array when
-	// more than one advanced signal exists.
-	// For now we only need to check for |0.5|
+		const vector<blotterEntry> &trades = blotters[col];
+		const mwSize numTrades = trades.size();
 
-	double frac = abs(advSig - int(advSig));
+		double *fieldPtr[numFields];
+		for (int ff = 0; ff < numFields; ff++)
+		{
+			mxArray *field = mxCreateDoubleMatrix(numTrades, 1, mxREAL);
+			fieldPtr[ff] = mxGetPr(field);
+			mxSetFieldByNumber(blotterStruct, col, ff, field);
+		}
 
-	if (frac == 0.5)		// Close any opposing open position
-	{
-		return true;
+		for (mwSize tt = 0; tt < numTrades; tt++)
+		{
+			fieldPtr[0][tt] = trades[tt].entryBar + 1;
+			fieldPtr[1][tt] = trades[tt].exitBar + 1;
+			fieldPtr[2][tt] = trades[tt].quantity;
+			fieldPtr[3][tt] = trades[tt].entryPrice;
+			fieldPtr[4][tt] = trades[tt].exitPrice;
+			fieldPtr[5][tt] = trades[tt].grossPL;
+			fieldPtr[6][tt] = trades[tt].netPL;
+			fieldPtr[7][tt] = trades[tt].MAE;
+			fieldPtr[8][tt] = trades[tt].MFE;
+		}
 	}
-	return false;
+
+	return blotterStruct;
 }
 
 //
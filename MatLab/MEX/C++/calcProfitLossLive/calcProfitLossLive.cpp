@@ -0,0 +1,342 @@
+// calcProfitLossLive.cpp
+// Localized mex'ing: mex calcProfitLossLive.cpp myMath.cpp plEngine.cpp
+//
+// A stateful version of calcProfitLoss for live trading.  Rather than re-running calcProfitLoss over the
+// entire history each time an observation arrives, the ledger, open position, running cash and netLiq
+// are held in a plEngine between calls.  Each new observation costs O(1) amortized for fills and to value
+// open equity.
+// The results are identical to calcProfitLoss over the same history.
+//
+// nlhs Number of output variables nargout
+// plhs Array of mxArray pointers to the output variables varargout
+// nrhs Number of input variables nargin
+// prhs Array of mxArray pointers to the input variables varargin
+//
+// Matlab function:
+//			h = calcProfitLossLive('new',bigPoint,cost)
+//			h = calcProfitLossLive('new',bigPoint,cost,minTick)
+//			[cash,openEQ,netLiq,returns] = calcProfitLossLive('update',h,open,close,sig)
+//			[openPosition,cashSum,netLiq,numBars] = calcProfitLossLive('state',h)
+//			calcProfitLossLive('reset',h)
+//			calcProfitLossLive('delete',h)
+//
+// Inputs:
+//		h			Opaque handle returned from 'new'
+//		bigPoint	Double representing the full tick dollar value of the contract being P&L'd
+//		cost		Double representing the per contract commission
+//		minTick		(optional) Minimum tick increment.  When given the engine runs in fixed point (see calcProfitLoss).
+//		open		Open of the new observation(s).  A scalar or a column vector.
+//		close		Close of the new observation(s).  Same size as open.
+//		sig			Signal of the new observation(s).  Same size as open.  See calcProfitLoss for conventions.
+//
+// Outputs ('update'):
+//		cash, openEQ, netLiq, returns
+//					Column vectors with one more row than the number of observations given.
+//					The first row restates the observation preceding this call, which is final once the
+//					next observation is known (see the 'dirty' openEQ cleaning in calcProfitLoss).
+//					The remaining rows are the given observations.  Only the last row is provisional.
+//					Given no observations the single row is the preceding observation as it stands.
+//
+//	NOTE:	Signals execute at the open of the following observation exactly as in calcProfitLoss.
+//			A signal given on the current observation is held until the next update.
+//			If an update fails on an unknown advanced signal, observations before it remain applied.
+//
+
+#include "mex.h"
+#include <map>
+#include <string>
+#include "myMath.h"
+#include "plEngine.h"
+
+using namespace std;
+
+// Prototypes
+static plEngine* getEngine(const mxArray *handle);
+static void cleanupEngines();
+
+// Macros
+#define isReal2DfullDouble(P) (!mxIsComplex(P) && mxGetNumberOfDimensions(P) == 2 && !mxIsSparse(P) && mxIsDouble(P))
+#define isRealScalar(P) (isReal2DfullDouble(P) && mxGetNumberOfElements(P) == 1)
+#define isHandle(P) (mxIsUint64(P) && !mxIsComplex(P) && mxGetNumberOfElements(P) == 1)
+#define codeLine	__LINE__	// help error trapping in MatLab
+
+// Global variables
+// Engines persist between calls while the MEX file is loaded and are released on 'clear mex'
+static map<unsigned long long, plEngine*> s_engines;
+static unsigned long long s_nextHandle = 0;
+static bool s_registered = false;
+
+void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
+				 int nrhs, const mxArray *prhs[]) /* Input variables */
+{
+	// Make sure any outstanding engines are released when the MEX file is cleared
+	if (!s_registered)
+	{
+		mexAtExit(cleanupEngines);
+		s_registered = true;
+	}
+
+	// Check number of inputs
+	if (nrhs < 1 || !mxIsChar(prhs[0]))
+		mexErrMsgIdAndTxt( "MATLAB:calcProfitLossLive:NumInputs",
+		"The first input must be one of 'new', 'update', 'state', 'reset' or 'delete'. Aborting (%d).", codeLine);
+
+	// Define constants (#define assigns a variable as either a constant or a macro)
+	// Inputs
+#define cmd_IN		prhs[0]
+#define handle_IN	prhs[1]
+
+	/* Parse the command */
+	char cmdAsChars[16];
+	if (mxGetString(cmd_IN, cmdAsChars, sizeof(cmdAsChars)) != 0)
+		mexErrMsgIdAndTxt( "MATLAB:calcProfitLossLive:Parsing",
+		"Could not parse the given command. Aborting (%d).", codeLine);
+
+	string cmd(cmdAsChars);
+
+	// Create a new engine
+	if (cmd == "new")
+	{
+#define bigPoint_IN	prhs[1]
+#define cost_IN		prhs[2]
+#define minTick_IN	prhs[3]
+
+		if (nrhs != 3 && nrhs != 4)
+			mexErrMsgIdAndTxt( "MATLAB:calcProfitLossLive:NumInputs",
+			"Usage is h = calcProfitLossLive('new',bigPoint,cost[,minTick]). Aborting (%d).", codeLine);
+
+		if (!isRealScalar(bigPoint_IN))
+			mexErrMsgIdAndTxt( "MATLAB:calcProfitLossLive:BadInputType",
+			"Input 'bigPoint' must be a single scalar double. Aborting (%d).", codeLine);
+
+		if (!isRealScalar(cost_IN))
+			mexErrMsgIdAndTxt( "MATLAB:calcProfitLossLive:BadInputType",
+			"Input 'cost' must be a single scalar double. Aborting (%d).", codeLine);
+
+		double minTick = 0;
+		if (nrhs == 4)
+		{
+			if (!isRealScalar(minTick_IN) || !(mxGetScalar(minTick_IN) > 0))
+				mexErrMsgIdAndTxt( "MATLAB:calcProfitLossLive:BadInputType",
+				"Input 'minTick' must be a single scalar double greater than zero. Aborting (%d).", codeLine);
+			minTick = mxGetScalar(minTick_IN);
+		}
+
+		s_nextHandle++;
+		s_engines[s_nextHandle] = new plEngine(mxGetScalar(bigPoint_IN), mxGetScalar(cost_IN), minTick);
+
+		plhs[0] = mxCreateNumericMatrix(1, 1, mxUINT64_CLASS, mxREAL);
+		*((unsigned long long*)mxGetData(plhs[0])) = s_nextHandle;
+	}
+	// Process one or more new observations
+	else if (cmd == "update")
+	{
+#define open_IN		prhs[2]
+#define close_IN	prhs[3]
+#define sig_IN		prhs[4]
+
+		if (nrhs != 5)
+			mexErrMsgIdAndTxt( "MATLAB:calcProfitLossLive:NumInputs",
+			"Usage is [cash,openEQ,netLiq,returns] = calcProfitLossLive('update',h,open,close,sig). Aborting (%d).", codeLine);
+
+		if (nlhs > 4)
+			mexErrMsgIdAndTxt( "MATLAB:calcProfitLossLive:NumOutputs",
+			"Number of output assignments is not correct. Aborting (%d).", codeLine);
+
+		plEngine *engine = getEngine(handle_IN);
+
+		if (!isReal2DfullDouble(open_IN) || !isReal2DfullDouble(close_IN) || !isReal2DfullDouble(sig_IN))
+			mexErrMsgIdAndTxt( "MATLAB:calcProfitLossLive:BadInputType",
+			"Inputs 'open', 'close' and 'sig' must be full double arrays. Aborting (%d).", codeLine);
+
+		mwSize numNew = mxGetNumberOfElements(open_IN);
+
+		if (mxGetNumberOfElements(close_IN) != numNew || mxGetNumberOfElements(sig_IN) != numNew)
+			mexErrMsgIdAndTxt( "MATLAB:calcProfitLossLive:ArrayMismatch",
+			"Inputs 'open', 'close' and 'sig' must be the same length. Aborting (%d).", codeLine);
+
+		/* Assign pointers to the arrays */
+		double *openPtr = mxGetPr(open_IN);
+		double *closePtr = mxGetPr(close_IN);
+		double *sigPtr = mxGetPr(sig_IN);
+
+		/* Create matrices for the return arguments */
+		// Row 0 restates the observation preceding this call
+		mxArray *out[4];
+		double *outPtr[4];
+		for (int ii = 0; ii < 4; ii++)
+		{
+			out[ii] = mxCreateDoubleMatrix(numNew + 1, 1, mxREAL);
+			outPtr[ii] = mxGetPr(out[ii]);
+		}
+
+		// Without new observations the preceding observation is restated as it stands (still provisional)
+		if (numNew == 0)
+		{
+			engine->getBar(plEngine::CURRENT, outPtr[0][0], outPtr[1][0], outPtr[2][0], outPtr[3][0]);
+		}
+
+		double badSig, cashPrior;
+		for (mwSize ii = 0; ii < numNew; ii++)
+		{
+			if (!engine->addBar(openPtr[ii], closePtr[ii], sigPtr[ii], badSig))
+			{
+				for (int jj = 0; jj < 4; jj++)
+				{
+					mxDestroyArray(out[jj]);
+				}
+				mexErrMsgIdAndTxt( "calcProfitLoss:AdvancedSignal:fractionUnknown",
+					"A signal contained an advanced fractional instruction %f that we could not interpret. Aborting (%d).", badSig, codeLine);
+			}
+
+			// The prior observation is now final.  Cash does not change once recorded.
+			engine->getBar(plEngine::PRIOR, cashPrior, outPtr[1][ii], outPtr[2][ii], outPtr[3][ii]);
+			if (ii == 0)
+			{
+				outPtr[0][ii] = cashPrior;
+			}
+			engine->getBar(plEngine::CURRENT, outPtr[0][ii+1], outPtr[1][ii+1], outPtr[2][ii+1], outPtr[3][ii+1]);
+		}
+
+		// Assign what was requested
+		for (int ii = 0; ii < 4; ii++)
+		{
+			if (ii < nlhs || (ii == 0 && nlhs == 0))
+			{
+				plhs[ii] = out[ii];
+			}
+			else
+			{
+				mxDestroyArray(out[ii]);
+			}
+		}
+	}
+	// Report the current state
+	else if (cmd == "state")
+	{
+		if (nrhs != 2)
+			mexErrMsgIdAndTxt( "MATLAB:calcProfitLossLive:NumInputs",
+			"Usage is [openPosition,cashSum,netLiq,numBars] = calcProfitLossLive('state',h). Aborting (%d).", codeLine);
+
+		plEngine *engine = getEngine(handle_IN);
+
+		plhs[0] = mxCreateDoubleScalar(engine->openPosition());
+		if (nlhs > 1) plhs[1] = mxCreateDoubleScalar(engine->cashSum());
+		if (nlhs > 2) plhs[2] = mxCreateDoubleScalar(engine->netLiq());
+		if (nlhs > 3) plhs[3] = mxCreateDoubleScalar(engine->numBars());
+	}
+	// Start over with the same contract specifications
+	else if (cmd == "reset")
+	{
+		if (nrhs != 2)
+			mexErrMsgIdAndTxt( "MATLAB:calcProfitLossLive:NumInputs",
+			"Usage is calcProfitLossLive('reset',h). Aborting (%d).", codeLine);
+
+		getEngine(handle_IN)->reset();
+	}
+	// Release an engine
+	else if (cmd == "delete")
+	{
+		if (nrhs != 2)
+			mexErrMsgIdAndTxt( "MATLAB:calcProfitLossLive:NumInputs",
+			"Usage is calcProfitLossLive('delete',h). Aborting (%d).", codeLine);
+
+		plEngine *engine = getEngine(handle_IN);
+		s_engines.erase(*((unsigned long long*)mxGetData(handle_IN)));
+		delete engine;
+	}
+	else
+	{
+		mexErrMsgIdAndTxt( "MATLAB:calcProfitLossLive:Parsing",
+			"Unknown command '%s'. Aborting (%d).", cmd.c_str(), codeLine);
+	}
+
+	return;
+}
+
+/////////////
+//
+// FUNCTIONS & METHODS
+//
+/////////////
+
+// Validate a handle and return the engine it refers to
+static plEngine* getEngine(const mxArray *handle)
+{
+	if (!isHandle(handle))
+		mexErrMsgIdAndTxt( "MATLAB:calcProfitLossLive:BadInputType",
+		"Input 'h' must be a handle returned from calcProfitLossLive('new',...). Aborting (%d).", codeLine);
+
+	map<unsigned long long, plEngine*>::iterator iter = s_engines.find(*((unsigned long long*)mxGetData(handle)));
+
+	if (iter == s_engines.end())
+		mexErrMsgIdAndTxt( "MATLAB:calcProfitLossLive:BadHandle",
+		"Input 'h' does not refer to an active engine. It may have been deleted or the MEX file cleared. Aborting (%d).", codeLine);
+
+	return iter->second;
+}
+
+// Release all engines
+static void cleanupEngines()
+{
+	for (map<unsigned long long, plEngine*>::iterator iter = s_engines.begin(); iter != s_engines.end(); iter++)
+	{
+		delete iter->second;
+	}
+	s_engines.clear();
+}
+
+//
+//  -------------------------------------------------------------------------
+//                                  _    _ 
+//         ___  _ __   ___ _ __    / \  | | __ _  ___   ___  _ __ __ _ 
+//        / _ \| '_ \ / _ \ '_ \  / _ \ | |/ _` |/ _ \ / _ \| '__/ _` |
+//       | (_) | |_) |  __/ | | |/ ___ \| | (_| | (_) | (_) | | | (_| |
+//        \___/| .__/ \___|_| |_/_/   \_\_|\__, |\___(_)___/|_|  \__, |
+//             |_|                         |___/                 |___/
+//  -------------------------------------------------------------------------
+//        This code is distributed in the hope that it will be useful,
+//
+//                      	   WITHOUT ANY WARRANTY
+//
+//                  WITHOUT CLAIM AS TO MERCHANTABILITY
+//
+//                  OR FITNESS FOR A PARTICULAR PURPOSE
+//
+//                          expressed or implied.
+//
+//   Use of this code, pseudocode, algorithmic or trading logic contained
+//   herein, whether sound or faulty for any purpose is the sole
+//   responsibility of the USER. Any such use of these algorithms, coding
+//   logic or concepts in whole or in part carry no covenant of correctness
+//   or recommended usage from the AUTHOR or any of the possible
+//   contributors listed or unlisted, known or unknown.
+//
+//   Any reference of this code or to this code including any variants from
+//   this code, or any other credits due this AUTHOR from this code shall be
+//   clearly and unambiguously cited and evident during any use, whether in
+//   whole or in part.
+//
+//   The public sharing of this code does not relinquish, reduce, restrict or
+//   encumber any rights the AUTHOR has in respect to claims of intellectual
+//   property.
+//
+//   IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY
+//   DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+//   OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+//   STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//   ANY WAY OUT OF THE USE OF THIS SOFTWARE, CODE, OR CODE FRAGMENT(S), EVEN
+//   IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//   -------------------------------------------------------------------------
+//
+//                             ALL RIGHTS RESERVED
+//
+//   -------------------------------------------------------------------------
+//
+//   Author:	Mark Tompkins
+//   Revision:	4906.24976
+//   Copyright:	(c)2013
+//
\ No newline at end of file
@@ -0,0 +1,259 @@
+// calcProfitLossPortfolio.cpp
+// Localized mex'ing: mex COMPFLAGS="$COMPFLAGS /openmp" calcProfitLossPortfolio.cpp myMath.cpp plEngine.cpp
+//		(OpenMP is optional.  Without it instruments are processed serially.)
+//
+// nlhs Number of output variables nargout 
+// plhs Array of mxArray pointers to the output variables varargout
+// nrhs Number of input variables nargin
+// prhs Array of mxArray pointers to the input variables varargin
+//
+// Matlab function:
+// [cash,openEQ,netLiq,returns,portfolio] = calcProfitLossPortfolio(data,sig,bigPoint,cost)
+// [...] = calcProfitLossPortfolio(data,sig,bigPoint,cost,minTick)
+// 
+// A portfolio of instruments P&L'd with the same ledger logic as calcProfitLoss (see calcProfitLoss for the
+// signal conventions).  Each instrument is independent and processed on its own thread.  The portfolio
+// aggregate is reduced once all instruments are complete.
+//
+// Inputs:
+//		data		An N x M x 2 array of prices where the pages are Open | Close and each column is an instrument.
+//					An N x M x 4 array of Open | High | Low | Close is also accepted.
+//		sig			An N x M array of signals.  Column M is executed against instrument M.
+//		bigPoint	A vector of M doubles representing the full tick dollar value of each instrument.  A scalar applies to all.
+//		cost		A vector of M doubles representing the per contract commission of each instrument.  A scalar applies to all.
+//		minTick		(optional) A vector of M doubles representing the minimum tick of each instrument.  A scalar applies to all.
+//					A positive value P&L's that instrument in fixed point (see calcProfitLoss).  Zero is floating point.
+//
+// Outputs:
+//		cash		An N x M array of cash debts and credits per instrument
+//		openEQ		An N x M array of bar to bar openEQ values per instrument
+//		netLiq		An N x M array of aggregated cash transactions plus the current openEQ per instrument
+//		returns		An N x M array of bar to bar returns per instrument
+//		portfolio	(optional) An N x 4 array of the portfolio aggregate in the form of cash | openEQ | netLiq | returns
+//
+
+#include "mex.h"
+#include <cmath>
+#include "myMath.h"
+#include "plEngine.h"
+
+using namespace std;
+
+// Macros
+#define isRealFullDouble(P) (!mxIsComplex(P) && !mxIsSparse(P) && mxIsDouble(P))
+#define isReal2DfullDouble(P) (isRealFullDouble(P) && mxGetNumberOfDimensions(P) == 2)
+#define codeLine	__LINE__	// help error trapping in MatLab
+
+void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
+				 int nrhs, const mxArray *prhs[]) /* Input variables */
+{
+	// Check number of inputs
+	if (nrhs != 4 && nrhs != 5)
+		mexErrMsgIdAndTxt( "MATLAB:calcProfitLossPortfolio:NumInputs",
+		"Number of input arguments is not correct. Aborting (%d).", codeLine);
+
+	if (nlhs > 5)
+		mexErrMsgIdAndTxt( "MATLAB:calcProfitLossPortfolio:NumOutputs",
+		"Number of output assignments is not correct. Aborting (%d).", codeLine);
+
+	// Define constants (#define assigns a variable as either a constant or a macro)
+	// Inputs
+#define data_IN		prhs[0]
+#define sig_IN		prhs[1]
+#define bigPoint_IN	prhs[2]
+#define cost_IN		prhs[3]
+#define minTick_IN	prhs[4]
+	// Outputs
+#define cash_OUT		plhs[0]
+#define openEQ_OUT		plhs[1]
+#define netLiq_OUT		plhs[2]
+#define returns_OUT		plhs[3]
+#define portfolio_OUT	plhs[4]
+
+	// Check type of supplied inputs
+	if (!isRealFullDouble(data_IN) || mxGetNumberOfDimensions(data_IN) > 3)
+		mexErrMsgIdAndTxt( "MATLAB:calcProfitLossPortfolio:BadInputType",
+		"Input 'data' must be an N x M x 2 (Open | Close) or N x M x 4 (Open | High | Low | Close) full double array. Aborting (%d).", codeLine);
+
+	if (!isReal2DfullDouble(sig_IN))
+		mexErrMsgIdAndTxt( "MATLAB:calcProfitLossPortfolio:BadInputType",
+		"Input 'sig' must be a 2 dimensional full double array. Aborting (%d).", codeLine);
+
+	if (!isReal2DfullDouble(bigPoint_IN) || !isReal2DfullDouble(cost_IN) || (nrhs == 5 && !isReal2DfullDouble(minTick_IN)))
+		mexErrMsgIdAndTxt( "MATLAB:calcProfitLossPortfolio:BadInputType",
+		"Inputs 'bigPoint', 'cost' and 'minTick' must be full double vectors. Aborting (%d).", codeLine);
+
+	// Assign variables
+	const mwSize *dimsData = mxGetDimensions(data_IN);
+	const mwSize rowsData = dimsData[0];
+	const mwSize numInst = dimsData[1];
+	const mwSize pagesData = mxGetNumberOfDimensions(data_IN) == 3 ? dimsData[2] : 1;
+
+	if (pagesData != 2 && pagesData != 4)
+		mexErrMsgIdAndTxt( "MATLAB:calcProfitLossPortfolio:ArrayMismatch",
+		"Input 'data' must be in the form of 'O | C' or 'O | H | L | C' along the third dimension. Aborting (%d).", codeLine);
+
+	if (mxGetM(sig_IN) != rowsData || mxGetN(sig_IN) != numInst)
+		mexErrMsgIdAndTxt( "MATLAB:calcProfitLossPortfolio:ArrayMismatch",
+		"Input 'sig' must have the same number of rows and columns as 'data'. Aborting (%d).", codeLine);
+
+	if (numInst < 1)
+		mexErrMsgIdAndTxt( "MATLAB:calcProfitLossPortfolio:ArrayMismatch",
+		"Input 'data' must have at least one instrument. Aborting (%d).", codeLine);
+
+	// Per instrument parameters may be given once for all
+	const mwSize numBigPoint = mxGetNumberOfElements(bigPoint_IN);
+	const mwSize numCost = mxGetNumberOfElements(cost_IN);
+	const mwSize numMinTick = (nrhs == 5) ? mxGetNumberOfElements(minTick_IN) : 0;
+
+	if ((numBigPoint != 1 && numBigPoint != numInst) || (numCost != 1 && numCost != numInst) ||
+		(nrhs == 5 && numMinTick != 1 && numMinTick != numInst))
+		mexErrMsgIdAndTxt( "MATLAB:calcProfitLossPortfolio:ArrayMismatch",
+		"Inputs 'bigPoint', 'cost' and 'minTick' must be scalars or have one element per instrument. Aborting (%d).", codeLine);
+
+	const double *bigPointPtr = mxGetPr(bigPoint_IN);
+	const double *costPtr = mxGetPr(cost_IN);
+	const double *minTickPtr = (nrhs == 5) ? mxGetPr(minTick_IN) : NULL;
+
+	for (mwSize inst = 0; inst < numMinTick; inst++)
+	{
+		if (minTickPtr[inst] < 0)
+			mexErrMsgIdAndTxt( "MATLAB:calcProfitLossPortfolio:minTickError",
+			"Input 'minTick' must be greater than or equal to zero. Aborting (%d).", codeLine);
+	}
+
+	/* Create matrices for the return arguments */
+	cash_OUT = mxCreateDoubleMatrix(rowsData, numInst, mxREAL);
+	openEQ_OUT = mxCreateDoubleMatrix(rowsData, numInst, mxREAL);
+	netLiq_OUT = mxCreateDoubleMatrix(rowsData, numInst, mxREAL);
+	returns_OUT = mxCreateDoubleMatrix(rowsData, numInst, mxREAL);
+
+	/* Assign pointers to the arrays */
+	const double *dataInPtr = mxGetPr(data_IN);
+	const double *sigInPtr = mxGetPr(sig_IN);
+	double *cashIdx = mxGetPr(cash_OUT);
+	double *openEQIdx = mxGetPr(openEQ_OUT);
+	double *netLiqIdx = mxGetPr(netLiq_OUT);
+	double *returnsIdx = mxGetPr(returns_OUT);
+
+	// Open is the first page and Close the last
+	const mwSize pageSize = rowsData * numInst;
+	const mwSize SHIFT_CLOSE = pageSize * (pagesData - 1);
+
+	// START //
+	// Each instrument is an independent P&L distributed across cores when compiled with OpenMP.
+	// Workers may not call back into Matlab so any failure is recorded and reported afterward.
+	const int numCols = (int)numInst;
+	bool *colOK = (bool*)mxCalloc(numCols, sizeof(bool));
+	double *colBadSig = (double*)mxCalloc(numCols, sizeof(double));
+
+#pragma omp parallel for schedule(dynamic) if (numCols > 1)
+	for (int col = 0; col < numCols; col++)
+	{
+		const mwSize offset = (mwSize)col * rowsData;
+		colOK[col] = calcColumnPL(dataInPtr + offset, NULL, NULL, dataInPtr + offset + SHIFT_CLOSE, sigInPtr + offset,
+			(int)rowsData, bigPointPtr[numBigPoint == 1 ? 0 : col], costPtr[numCost == 1 ? 0 : col],
+			minTickPtr == NULL ? 0 : minTickPtr[numMinTick == 1 ? 0 : col],
+			cashIdx + offset, openEQIdx + offset, netLiqIdx + offset, returnsIdx + offset, colBadSig[col], NULL);
+	}
+
+	for (int col = 0; col < numCols; col++)
+	{
+		if (!colOK[col])
+		{
+			double badSig = colBadSig[col];
+			mxFree(colOK);
+			mxFree(colBadSig);
+			// Unknown advanced signal.  Throw an error.
+			mexErrMsgIdAndTxt( "calcProfitLossPortfolio:AdvancedSignal:fractionUnknown",
+				"A signal for instrument %d contained an advanced fractional instruction %f that we could not interpret. Aborting (%d).", col + 1, badSig, codeLine);
+		}
+	}
+
+	mxFree(colOK);
+	mxFree(colBadSig);
+
+	// Reduce the instruments to the portfolio
+	if (nlhs == 5)
+	{
+		portfolio_OUT = mxCreateDoubleMatrix(rowsData, 4, mxREAL);
+		double *portfolioIdx = mxGetPr(portfolio_OUT);
+		const int numRows = (int)rowsData;
+
+#pragma omp parallel for if (numRows * numCols > 100000)
+		for (int ii = 0; ii < numRows; ii++)
+		{
+			double sumCash = 0, sumOpenEQ = 0, sumNetLiq = 0, sumReturns = 0;
+
+			for (int col = 0; col < numCols; col++)
+			{
+				const mwSize idx = (mwSize)col * rowsData + ii;
+				sumCash = sumCash + cashIdx[idx];
+				sumOpenEQ = sumOpenEQ + openEQIdx[idx];
+				sumNetLiq = sumNetLiq + netLiqIdx[idx];
+				sumReturns = sumReturns + returnsIdx[idx];
+			}
+
+			portfolioIdx[ii] = sumCash;
+			portfolioIdx[ii + rowsData] = sumOpenEQ;
+			portfolioIdx[ii + 2 * rowsData] = sumNetLiq;
+			portfolioIdx[ii + 3 * rowsData] = sumReturns;
+		}
+	}
+
+	return;
+}
+//
+//  -------------------------------------------------------------------------
+//                                  _    _ 
+//         ___  _ __   ___ _ __    / \  | | __ _  ___   ___  _ __ __ _ 
+//        / _ \| '_ \ / _ \ '_ \  / _ \ | |/ _` |/ _ \ / _ \| '__/ _` |
+//       | (_) | |_) |  __/ | | |/ ___ \| | (_| | (_) | (_) | | | (_| |
+//        \___/| .__/ \___|_| |_/_/   \_\_|\__, |\___(_)___/|_|  \__, |
+//             |_|                         |___/                 |___/
+//  -------------------------------------------------------------------------
+//        This code is distributed in the hope that it will be useful,
+//
+//                      	   WITHOUT ANY WARRANTY
+//
+//                  WITHOUT CLAIM AS TO MERCHANTABILITY
+//
+//                  OR FITNESS FOR A PARTICULAR PURPOSE
+//
+//                          expressed or implied.
+//
+//   Use of this code, pseudocode, algorithmic or trading logic contained
+//   herein, whether sound or faulty for any purpose is the sole
+//   responsibility of the USER. Any such use of these algorithms, coding
+//   logic or concepts in whole or in part carry no covenant of correctness
+//   or recommended usage from the AUTHOR or any of the possible
+//   contributors listed or unlisted, known or unknown.
+//
+//   Any reference of this code or to this code including any variants from
+//   this code, or any other credits due this AUTHOR from this code shall be
+//   clearly and unambiguously cited and evident during any use, whether in
+//   whole or in part.
+//
+//   The public sharing of this code does not relinquish, reduce, restrict or
+//   encumber any rights the AUTHOR has in respect to claims of intellectual
+//   property.
+//
+//   IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY
+//   DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+//   OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+//   STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//   ANY WAY OUT OF THE USE OF THIS SOFTWARE, CODE, OR CODE FRAGMENT(S), EVEN
+//   IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//   -------------------------------------------------------------------------
+//
+//                             ALL RIGHTS RESERVED
+//
+//   -------------------------------------------------------------------------
+//
+//   Author:	Mark Tompkins
+//   Revision:	4906.24976
+//   Copyright:	(c)2013
+//
\ No newline at end of file
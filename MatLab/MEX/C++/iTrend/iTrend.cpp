@@ -0,0 +1,298 @@
+// iTrend.cpp
+// Localized mex'ing: mex COMPFLAGS="$COMPFLAGS /openmp" iTrend.cpp -output iTrend_mex
+//		(OpenMP is optional.  Without it instruments are processed serially.)
+//
+// Native replacement for the coder build of iTrend.m (iTrend_mex).  Results match iTrend.m exactly.
+//
+// Instantaneous trend after John Ehlers.  The in-phase and quadrature components of the price are used to
+// measure the phase, the phase change (deltaPhase) is summed until it completes a cycle (360 degrees) and the
+// number of bars required is the instantaneous period.  The trendline is a simple average over the smoothed period.
+//
+//	NOTE:	iTrend.m holds 13 full length arrays and sums up to 41 deltaPhases per bar.  This kernel makes a single
+//			pass and holds O(1) state per instrument: the last 8 values of value1, the last 64 deltaPhases and the
+//			prior values of each recursion.  The price is read in place.
+//			A rolling sum of the last 41 deltaPhases identifies bars where no cycle is completed (the period is
+//			carried forward) without a scan.  Otherwise the deltaPhases are summed newest first as iTrend.m does,
+//			stopping at the bar that completes the cycle, so the period is taken from identically rounded sums.
+//
+// nlhs Number of output variables nargout 
+// plhs Array of mxArray pointers to the output variables varargout
+// nrhs Number of input variables nargin
+// prhs Array of mxArray pointers to the input variables varargin
+//
+// Matlab function:
+// [tLine, iTrend] = iTrend_mex(price)
+// 
+// Inputs:
+//		price		An N x 1 array of pre-transformed price e.g. (H + L)/2, or an N x M array of M instruments
+//
+// Outputs:
+//		tLine		Trendline over the dominant cycle
+//		iTrend		Instantaneous trend
+//
+
+#include "mex.h"
+#include <cmath>
+
+using namespace std;
+
+// Macros
+#define isReal2DfullDouble(P) (!mxIsComplex(P) && mxGetNumberOfDimensions(P) == 2 && !mxIsSparse(P) && mxIsDouble(P))
+
+// deltaPhases summed to find the period (jj = 0:40)
+#define PHASE_SPAN	41
+// Ring buffers (powers of 2 so the index is masked)
+#define PHASE_RING	64
+#define VALUE_RING	8
+// Bars between exact recalculations of the rolling deltaPhase sum
+#define RESYNC_BARS	1024
+
+// Prototypes
+void iTrendKernel(const double *price, int rows, double *tLine, double *iTrend);
+
+void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
+				 int nrhs, const mxArray *prhs[]) /* Input variables */
+{
+	// Check number of inputs
+	if (nrhs != 1)
+		mexErrMsgIdAndTxt( "MATLAB:iTrend:NumInputs",
+		"Number of input arguments is not correct. Aborting.");
+
+	if (nlhs > 2)
+		mexErrMsgIdAndTxt( "MATLAB:iTrend:NumOutputs",
+		"Number of output assignments is not correct. Aborting.");
+
+	// Define constants (#define assigns a variable as either a constant or a macro)
+	// Inputs
+#define price_IN	prhs[0]
+
+	// Outputs
+#define tLine_OUT	plhs[0]
+#define iTrend_OUT	plhs[1]
+
+	// Check type of supplied inputs
+	if (!isReal2DfullDouble(price_IN)) 
+		mexErrMsgIdAndTxt( "MATLAB:iTrend:BadInputType",
+		"Input 'price' must be a 2 dimensional full double array. Aborting.");
+
+	// Init variables
+	int rows = int(mxGetM(price_IN));
+	int cols = int(mxGetN(price_IN));
+
+	if (rows < 55)
+		mexErrMsgIdAndTxt( "iTrend:dataSizeFailure",
+		"iTrend requires a minimum of 55 observations. Exiting.");
+
+	/* Assign pointers to the input array */ 
+	double *pricePtr = mxGetPr(price_IN);
+
+	/* Create matrices for the return arguments */ 
+	tLine_OUT = mxCreateDoubleMatrix(rows, cols, mxREAL);
+	iTrend_OUT = mxCreateDoubleMatrix(rows, cols, mxREAL);
+
+	double *tLinePtr = mxGetPr(tLine_OUT);
+	double *iTrendPtr = mxGetPr(iTrend_OUT);
+
+	/////////////
+	// START
+	/////////////
+
+	// Instruments are independent
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+	for (int col = 0; col < cols; col++)
+	{
+		iTrendKernel(pricePtr + col * rows, rows, tLinePtr + col * rows, iTrendPtr + col * rows);
+	}
+
+	// Only tLine requested
+	if (nlhs < 2)
+	{
+		mxDestroyArray(iTrend_OUT);
+	}
+
+	/////////////
+	// FINISHED
+	/////////////
+
+	return;
+}
+
+/////////////
+//
+// FUNCTIONS & METHODS
+//
+/////////////
+
+// One instrument in a single pass.  Expressions are evaluated in the same order as iTrend.m so that the
+// results are identical.  Indices are 0 based (ii here is ii - 1 in iTrend.m).
+void iTrendKernel(const double *price, int rows, double *tLine, double *iTrend)
+{
+	// atand(x) = 180/pi * atan(x)
+	const double radToDeg = 180 / 3.141592653589793;
+
+	double value1[VALUE_RING] = {0};
+	double deltaPhase[PHASE_RING] = {0};
+
+	double inPhase = 0, quad = 0, phase = 0;
+	double instPeriod = 0, value5 = 0, iTrendLast = 0;
+	double phaseSum = 0;			// Rolling sum of the last PHASE_SPAN deltaPhases
+
+	for (int ii = 0; ii < rows; ii++)
+	{
+		// {Compute InPhase and Quadrature components}
+		double v1 = (ii >= 6) ? price[ii] - price[ii - 6] : 0;
+		value1[ii & (VALUE_RING - 1)] = v1;
+
+		double inPhaseLast = inPhase;
+		double quadLast = quad;
+
+		if (ii >= 3)
+		{
+			double value2 = value1[(ii - 3) & (VALUE_RING - 1)];
+			inPhase = (.33 * value2) + (.67 * inPhase);
+		}
+
+		if (ii >= 6)
+		{
+			double value3 = (.75 * (v1 - value1[(ii - 6) & (VALUE_RING - 1)])) +
+				(.25 * (value1[(ii - 2) & (VALUE_RING - 1)] - value1[(ii - 4) & (VALUE_RING - 1)]));
+			quad = (.2 * value3) + (.8 * quad);
+		}
+
+		// {Use ArcTangent to compute the current phase}
+		double phaseLast = phase;
+		double dPhase = 0;
+
+		if (ii >= 1)
+		{
+			phase = 0;
+			if (fabs(inPhase + inPhaseLast) > 0)
+			{
+				phase = radToDeg * atan(fabs((quad + quadLast) / (inPhase + inPhaseLast)));
+			}
+			// {Resolve the ArcTangent ambiguity}
+			if (inPhase < 0 && quad > 0) phase = 180 - phase;
+			if (inPhase < 0 && quad < 0) phase = 180 + phase;
+			if (inPhase > 0 && quad < 0) phase = 360 - phase;
+
+			// {Compute a differential phase, resolve phase wraparound, and limit delta phase errors}
+			dPhase = phaseLast - phase;
+			if (phaseLast < 90 && phase > 270) dPhase = 360 + phaseLast - phase;
+			if (dPhase < 1) dPhase = 1;
+			if (dPhase > 60) dPhase = 60;
+		}
+
+		deltaPhase[ii & (PHASE_RING - 1)] = dPhase;
+
+		// Rolling sum over deltaPhase[ii - 40 .. ii]
+		if (ii % RESYNC_BARS == 0)
+		{
+			phaseSum = 0;
+			for (int jj = 0; jj < PHASE_SPAN && jj <= ii; jj++)
+			{
+				phaseSum = phaseSum + deltaPhase[(ii - jj) & (PHASE_RING - 1)];
+			}
+		}
+		else
+		{
+			phaseSum = phaseSum + dPhase;
+			if (ii >= PHASE_SPAN)
+				phaseSum = phaseSum - deltaPhase[(ii - PHASE_SPAN) & (PHASE_RING - 1)];
+		}
+
+		if (ii < PHASE_SPAN - 1)
+		{
+			tLine[ii] = price[ii];
+			iTrend[ii] = price[ii];
+			continue;
+		}
+
+		// {Sum DeltaPhases to reach 360 degrees. The sum is the instantaneous period.}
+		// The rolling sum only decides whether a scan is needed.  A sum clearly short of 360 completes no cycle
+		// and {Resolve Instantaneous Period errors} keeps the prior period.
+		if (phaseSum > 360 - 1e-6)
+		{
+			double value4 = 0;
+			for (int jj = 0; jj < PHASE_SPAN; jj++)
+			{
+				value4 = value4 + deltaPhase[(ii - jj) & (PHASE_RING - 1)];
+				if (value4 > 360)
+				{
+					instPeriod = jj;
+					break;
+				}
+			}
+		}
+
+		// {Smooth}
+		value5 = (.25 * instPeriod) + (.75 * value5);
+
+		// {Compute Trendline as simple average over the measured dominant cycle period}
+		int period = int(value5);
+		double tSum = 0;
+		for (int jj = 0; jj <= period + 1; jj++)
+		{
+			tSum = tSum + price[ii - jj];
+		}
+		if (period > 0) tSum = tSum / (period + 2);
+
+		iTrendLast = (.33 * (price[ii] + (.5 * (price[ii] - price[ii - 3])))) + (.67 * iTrendLast);
+
+		tLine[ii] = tSum;
+		iTrend[ii] = (ii < 54) ? price[ii] : iTrendLast;
+	}
+}
+//
+//  -------------------------------------------------------------------------
+//                                  _    _ 
+//         ___  _ __   ___ _ __    / \  | | __ _  ___   ___  _ __ __ _ 
+//        / _ \| '_ \ / _ \ '_ \  / _ \ | |/ _` |/ _ \ / _ \| '__/ _` |
+//       | (_) | |_) |  __/ | | |/ ___ \| | (_| | (_) | (_) | | | (_| |
+//        \___/| .__/ \___|_| |_/_/   \_\_|\__, |\___(_)___/|_|  \__, |
+//             |_|                         |___/                 |___/
+//  -------------------------------------------------------------------------
+//        This code is distributed in the hope that it will be useful,
+//
+//                      	   WITHOUT ANY WARRANTY
+//
+//                  WITHOUT CLAIM AS TO MERCHANTABILITY
+//
+//                  OR FITNESS FOR A PARTICULAR PURPOSE
+//
+//                          expressed or implied.
+//
+//   Use of this code, pseudocode, algorithmic or trading logic contained
+//   herein, whether sound or faulty for any purpose is the sole
+//   responsibility of the USER. Any such use of these algorithms, coding
+//   logic or concepts in whole or in part carry no covenant of correctness
+//   or recommended usage from the AUTHOR or any of the possible
+//   contributors listed or unlisted, known or unknown.
+//
+//   Any reference of this code or to this code including any variants from
+//   this code, or any other credits due this AUTHOR from this code shall be
+//   clearly and unambiguously cited and evident during any use, whether in
+//   whole or in part.
+//
+//   The public sharing of this code does not relinquish, reduce, restrict or
+//   encumber any rights the AUTHOR has in respect to claims of intellectual
+//   property.
+//
+//   IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY
+//   DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+//   OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+//   STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//   ANY WAY OUT OF THE USE OF THIS SOFTWARE, CODE, OR CODE FRAGMENT(S), EVEN
+//   IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//   -------------------------------------------------------------------------
+//
+//                             ALL RIGHTS RESERVED
+//
+//   -------------------------------------------------------------------------
+//
+//   Author:	Mark Tompkins
+//   Revision:	4906.24976
+//   Copyright:	(c)2013
+//
\ No newline at end of file
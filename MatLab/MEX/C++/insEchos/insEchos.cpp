@@ -0,0 +1,195 @@
+// insEchos.cpp
+// Localized mex'ing: mex COMPFLAGS="$COMPFLAGS /openmp" insEchos.cpp -output insEchos_mex
+//		(OpenMP is optional.  Without it columns are processed serially.)
+//
+// Native equivalent of insEchos.m, the inverse of remEchos.  Transforms a SIGNAL into a STATE by replicating
+// the last non-zero value until the next non-zero value.
+//		in	[0 0 0 1 0 0 0 -1  0  0  0 -1  0  0  0 1 0 0]
+//		out	[0 0 0 1 1 1 1 -1 -1 -1 -1 -1 -1 -1 -1 1 1 1]
+//
+//	NOTE:	Columns are scanned in blocks of SCAN_BLOCK observations.  A vectorized compare-and-mask counts the
+//			zeros in a block.  A block without zeros is copied as is and only blocks holding zeros are
+//			filled serially.
+//
+// nlhs Number of output variables nargout 
+// plhs Array of mxArray pointers to the output variables varargout
+// nrhs Number of input variables nargin
+// prhs Array of mxArray pointers to the input variables varargin
+//
+// Matlab function:
+// dirtyS = insEchos_mex(s)
+// 
+// Inputs:
+//		s			An N x K array of SIGNALS, one column per vector
+//
+// Outputs:
+//		dirtyS		The N x K STATE array
+//
+
+#include "mex.h"
+
+using namespace std;
+
+// Macros
+#define isReal2DfullDouble(P) (!mxIsComplex(P) && mxGetNumberOfDimensions(P) == 2 && !mxIsSparse(P) && mxIsDouble(P))
+
+// Observations per compare-and-mask block
+#define SCAN_BLOCK	8
+
+// Prototypes
+void insEchosKernel(const double *s, int rows, double *dirtyS);
+
+void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
+				 int nrhs, const mxArray *prhs[]) /* Input variables */
+{
+	// Check number of inputs
+	if (nrhs != 1)
+		mexErrMsgIdAndTxt( "MATLAB:insEchos:NumInputs",
+		"Number of input arguments is not correct. Aborting.");
+
+	if (nlhs > 1)
+		mexErrMsgIdAndTxt( "MATLAB:insEchos:NumOutputs",
+		"Number of output assignments is not correct. Aborting.");
+
+	// Define constants (#define assigns a variable as either a constant or a macro)
+	// Inputs
+#define s_IN		prhs[0]
+
+	// Outputs
+#define dirtyS_OUT	plhs[0]
+
+	// Check type of supplied inputs
+	if (!isReal2DfullDouble(s_IN)) 
+		mexErrMsgIdAndTxt( "MATLAB:insEchos:BadInputType",
+		"Input 's' must be a 2 dimensional full double array. Aborting.");
+
+	int rows = int(mxGetM(s_IN));
+	int cols = int(mxGetN(s_IN));
+
+	/* Assign pointers to the input array */ 
+	double *sPtr = mxGetPr(s_IN);
+
+	/* Create matrices for the return arguments */ 
+	dirtyS_OUT = mxCreateDoubleMatrix(rows, cols, mxREAL);
+	double *dirtySPtr = mxGetPr(dirtyS_OUT);
+
+	/////////////
+	// START
+	/////////////
+
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+	for (int col = 0; col < cols; col++)
+	{
+		insEchosKernel(sPtr + col * rows, rows, dirtySPtr + col * rows);
+	}
+
+	/////////////
+	// FINISHED
+	/////////////
+
+	return;
+}
+
+/////////////
+//
+// FUNCTIONS & METHODS
+//
+/////////////
+
+// One column
+void insEchosKernel(const double *s, int rows, double *dirtyS)
+{
+	if (rows == 0)
+		return;
+
+	double last = s[0];
+	dirtyS[0] = s[0];
+
+	int ii = 1;
+	while (ii < rows)
+	{
+		int len = rows - ii;
+		if (len > SCAN_BLOCK) len = SCAN_BLOCK;
+
+		int zeros = 0;
+		for (int jj = 0; jj < len; jj++)
+		{
+			zeros += (s[ii + jj] == 0);
+		}
+
+		if (zeros == 0)
+		{
+			// Nothing to fill
+			for (int jj = 0; jj < len; jj++)
+			{
+				dirtyS[ii + jj] = s[ii + jj];
+			}
+			last = s[ii + len - 1];
+		}
+		else
+		{
+			for (int jj = 0; jj < len; jj++)
+			{
+				if (s[ii + jj] != 0)
+					last = s[ii + jj];
+				dirtyS[ii + jj] = last;
+			}
+		}
+
+		ii = ii + len;
+	}
+}
+//
+//  -------------------------------------------------------------------------
+//                                  _    _ 
+//         ___  _ __   ___ _ __    / \  | | __ _  ___   ___  _ __ __ _ 
+//        / _ \| '_ \ / _ \ '_ \  / _ \ | |/ _` |/ _ \ / _ \| '__/ _` |
+//       | (_) | |_) |  __/ | | |/ ___ \| | (_| | (_) | (_) | | | (_| |
+//        \___/| .__/ \___|_| |_/_/   \_\_|\__, |\___(_)___/|_|  \__, |
+//             |_|                         |___/                 |___/
+//  -------------------------------------------------------------------------
+//        This code is distributed in the hope that it will be useful,
+//
+//                      	   WITHOUT ANY WARRANTY
+//
+//                  WITHOUT CLAIM AS TO MERCHANTABILITY
+//
+//                  OR FITNESS FOR A PARTICULAR PURPOSE
+//
+//                          expressed or implied.
+//
+//   Use of this code, pseudocode, algorithmic or trading logic contained
+//   herein, whether sound or faulty for any purpose is the sole
+//   responsibility of the USER. Any such use of these algorithms, coding
+//   logic or concepts in whole or in part carry no covenant of correctness
+//   or recommended usage from the AUTHOR or any of the possible
+//   contributors listed or unlisted, known or unknown.
+//
+//   Any reference of this code or to this code including any variants from
+//   this code, or any other credits due this AUTHOR from this code shall be
+//   clearly and unambiguously cited and evident during any use, whether in
+//   whole or in part.
+//
+//   The public sharing of this code does not relinquish, reduce, restrict or
+//   encumber any rights the AUTHOR has in respect to claims of intellectual
+//   property.
+//
+//   IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY
+//   DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+//   OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+//   STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//   ANY WAY OUT OF THE USE OF THIS SOFTWARE, CODE, OR CODE FRAGMENT(S), EVEN
+//   IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//   -------------------------------------------------------------------------
+//
+//                             ALL RIGHTS RESERVED
+//
+//   -------------------------------------------------------------------------
+//
+//   Author:	Mark Tompkins
+//   Revision:	4906.24976
+//   Copyright:	(c)2013
+//
\ No newline at end of file
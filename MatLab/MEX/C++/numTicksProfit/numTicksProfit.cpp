@@ -1,4 +1,5 @@
 // numTicksProfit.cpp
+// Localized mex'ing: mex numTicksProfit.cpp myMath.cpp numTicksEngine.cpp
 //
 // nlhs Number of output variables nargout 
 // plhs Array of mxArray pointers to the output variables varargout
@@ -7,20 +8,45 @@
 //
 // Matlab MEX function:
 // [barsOut,sigOut,sharpeOut] = numTicksProfit(barsIn,sigIn,sharpeIn,minTick,numTicks,openAvg)
+// [barsOut,sigOut] = numTicksProfit(barsIn,sigIn,minTick,numTicks,openAvg,fixedPoint)
+// [barsOut,sigOut] = numTicksProfit(barsIn,sigIn,minTick,numTicks,openAvg,fixedPoint,stopTicks,trailTicks)
+// [pftSig,pftPrice] = numTicksProfit(barsIn,sigIn,minTick,numTicksVec,openAvg,fixedPoint)
+// [pftSig,pftPrice,stopSig,stopPrice] = numTicksProfit(barsIn,sigIn,minTick,numTicksVec,openAvg,fixedPoint,stopTicks,trailTicks)
 // 
 // Inputs:
 //		barsIn		A matrix array of prices in the form of Open | High | Low | Close
 //		sigIn		An 1-D array the same length as barsIn, which gives the quantity bought or sold on a given bar.  Consider Matlab remEchosMEX
 //		minTick		Double representing the per contract minimum tick increment
 //		numTicks	Double representing the number of ticks for the open position price to take a profit
+//					or a vector of K candidate targets to sweep.  The inputs are validated and prepared once and the
+//					K targets are advanced together, but each keeps its own ledgers (a target's exits change the
+//					position later observations see) so the cost is that of K evaluations.
 //		openAvg		One of two ways to handle multiple entries in the open ledger.
 //						0	Each trade individually
 //						1	Average the open position	(only logically useful when there is more than a 1 lot open position)
+//		fixedPoint	(optional) 1 to evaluate profit targets in whole ticks.  Default is 0.
+//					Prices are converted once to integer tick counts using minTick so every comparison against a
+//					profit target is exact, and virtual bar prices are converted back (ticks * minTick) at output.
+//					Signals are snapped to the nearest half unit so |0.5| instructions are recognized exactly.
+//		stopTicks	(optional) Number of ticks from the entry price to a fixed stop.  Default is 0 (none).
+//		trailTicks	(optional) Number of ticks a trailing stop follows the most favorable extreme.  Default is 0 (none).
+//					Stop exits are returned as virtual bars in the same manner as profit exits.  When a stop and
+//					the profit target are both reached within one observation the stop is filled first.
+//					An open beyond a stop fills at the open.  Use a numTicks of Inf for stops without a target.
 //
 // Outputs:
 //		barsOut		A 2-D array of prices with the addition of any virtual bars where a profit is taken in the form of Open | High | Low | Close
 //		sigOut		An array the same length as barsOut which includes any profit taking signals generated by numTicksProfitCPP
 //
+// Outputs when numTicks is a vector:
+//		pftSig		An N x K array of the profit taking quantity filled on each observation for each target
+//					(0 where no profit was taken).  Virtual bars are not inserted.
+//		pftPrice	An N x K array of the price the profit was taken at on each observation (0 where none)
+//		stopSig		An N x K array of the stop quantity filled on each observation for each target.  Required when
+//					stopTicks or trailTicks is given so stop and profit fills on one observation keep their own prices.
+//		stopPrice	An N x K array of the stop fill price.  Several stops on one observation are given their quantity
+//					weighted average price so stopSig .* stopPrice is the value traded.
+//
 //	NOTES			We will assume the following standard:	+/- 1 lot is additive	+/- 2 lots is a reverse
 //					This is the version that should be used with a SIGNAL input.
 //					There is (will be) a version that should be used when a STATE input is supplied to allow for continued reentry
@@ -54,9 +80,8 @@ plhs[0] = getMexArray(v);
 
 
 #include "mex.h"
-#include <list>
-#include <iterator>
-#include "myMath.h"
+#include <vector>
+#include "numTicksEngine.h"
 
 // Declare external reference to undocumented C function
 #ifdef __cplusplus
@@ -76,63 +101,10 @@ using namespace std;
 /* Add this declaration because it does not exist in the "mex.h" header */
 // http://www.mathworks.com/support/solutions/en/data/1-6NU359/index.html
 
-
-// Typedefs
-// Create a struct for open position
-typedef struct openEntry
-{
-	int sigIndex;								//	Array index of signal that created open position
-	int qtyOpen;								//	Quantity of created open position
-	double openPrice;							//	Entry price of open position
-	double profitPrice;							//	Price where position will be closed with a profit
-} openEntry;
-
-// Create struct for profit ledger
-typedef struct profitEntry
-{
-	int barIndex;								//	Array index of observation that create the profit taking
-	int qtyProfit;								//	Quantity bought or sold at the profit taking price
-	double profitPrice;							//	Profit price
-} profitEntry;
-
-
-// Prototypes
-openEntry createOpenLedgerEntry(int ID, int qty, double price);
-profitEntry createProfitLedgerEntry(int ID, int qty, double price);
-
-bool isTrade(double isSig);
-bool knownAdvSig(double advSig);
-int sumQty(const list<openEntry> &theList);
-double getAvgPftPrice(const list<openEntry> &openLedger);
-void shrinkProfitLedger(list<profitEntry> &profitLedger);
-//void moveOpenLedger(list<openEntry> &openLedger, const int ID, int qty, int &openPosition);
-void moveProfitLedger(list<profitEntry> &profitLedger, const int ID, int qty, double price);
-void checkOpen(list<openEntry> &openLedger, list<profitEntry> &profitLedger, const int ID, int &openPosition);
-void newAvgChk(list<openEntry> &openLedger, list<profitEntry> &profitLedger, const int ID, int &openPosition, double &minMax);
-void newMinMax(list<openEntry> &openLedger,  list<profitEntry> &profitLedger, const int ID, int &openPosition, double &minMax);
-void checkMinMax(list<openEntry> &openLedger, list<profitEntry> &profitLedger, const int ID, int &openPosition, double &minMax);
-void chkOpenMethod(int &openPosition, const int curBar, double &minMax, list<openEntry> &openLedger, list<profitEntry> &profitLedger);
-void sameBarProfitCheck(list<openEntry> &openLedger, list<profitEntry> &profitLedger, const int ID, int qty, int &openPosition, double &minMax);
-
 // Macros
 #define isReal2DfullDouble(P) (!mxIsComplex(P) && mxGetNumberOfDimensions(P) == 2 && !mxIsSparse(P) && mxIsDouble(P))
 #define isRealScalar(P) (isReal2DfullDouble(P) && mxGetNumberOfElements(P) == 1)
 
-// Global Variables
-double PROFIT_TGT;								// Calculated profit target (for readability)
-double numTicks;								// Number of ticks (representing $ multiples) in which to take a profit
-double minTick;									// What a single tick increment is for a given contract
-double openAvg;									// Should we manage profit taking on a per contract basis or average the net position (0 = atomic | 1 = average)
-
-double *barsInPtr;								// Pointer for the price matrix
-double *sigInPtr;								// Pointer for the signal array
-int shiftOpen;									// used for readability 
-int shiftHigh;
-int shiftLow;
-int shiftClose;
-
-
-
 void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				 int nrhs, const mxArray *prhs[]) /* Input variables */
 {
@@ -146,11 +118,11 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 	// mexPrintf("Hello, world!");
 
 	// Check number of inputs
-	if (nrhs != 5)
+	if (nrhs < 5 || nrhs > 8)
 		mexErrMsgIdAndTxt( "MATLAB:numTicksProfit:NumInputs",
 		"Number of input arguments is not correct. Aborting.");
 	// Check number of output assignments
-	if (nlhs != 2)
+	if (nlhs != 2 && nlhs != 4)
 		mexErrMsgIdAndTxt( "MATLAB:numTicksProfit:NumOutputs",
 		"Number of output assignments is not correct. Aborting.");
 
@@ -161,13 +133,24 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 #define minTick_IN	prhs[2]
 #define numTicks_IN	prhs[3]
 #define openAvg_IN	prhs[4]
+#define fixedPoint_IN	prhs[5]
+#define stopTicks_IN	prhs[6]
+#define trailTicks_IN	prhs[7]
 	// Outputs
 #define bars_OUT	plhs[0]
 #define sig_OUT		plhs[1]
+#define pftSig_OUT		plhs[0]
+#define pftPrice_OUT	plhs[1]
+#define stopSig_OUT		plhs[2]
+#define stopPrice_OUT	plhs[3]
 
 	// Init variables
 	mwSize rowsPrice, colsPrice, rowsSig, colsSig;
-	double  *barsOutPtr, *sigOutPtr;
+	double *barsInPtr, *sigInPtr;
+	double minTick, openAvg, stopTicks, trailTicks;
+	double *numTicksPtr;
+	int numTgts;
+	bool fixedPoint;
 
 
 	// Check type of supplied inputs
@@ -183,27 +166,32 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 		mexErrMsgIdAndTxt( "MATLAB:numTicksProfit:BadInputType",
 		"Input 'minTick' must be a single scalar double. Aborting.");
 
-	if (!isRealScalar(numTicks_IN)) 
+	if (!isReal2DfullDouble(numTicks_IN) || mxGetNumberOfElements(numTicks_IN) < 1 ||
+		(mxGetM(numTicks_IN) > 1 && mxGetN(numTicks_IN) > 1)) 
 		mexErrMsgIdAndTxt( "MATLAB:numTicksProfit:BadInputType",
-		"Input 'numTicks' must be a single scalar double. Aborting.");
+		"Input 'numTicks' must be a scalar or a vector of doubles. Aborting.");
 
 	if (!isRealScalar(openAvg_IN)) 
 		mexErrMsgIdAndTxt( "MATLAB:numTicksProfit:BadInputType",
 		"Input 'openAvg_IN' must be a single scalar double. Aborting.");
 
+	if (nrhs >= 6 && !isRealScalar(fixedPoint_IN)) 
+		mexErrMsgIdAndTxt( "MATLAB:numTicksProfit:BadInputType",
+		"Input 'fixedPoint' must be a single scalar double. Aborting.");
+
+	if (nrhs >= 7 && !isRealScalar(stopTicks_IN)) 
+		mexErrMsgIdAndTxt( "MATLAB:numTicksProfit:BadInputType",
+		"Input 'stopTicks' must be a single scalar double. Aborting.");
+
+	if (nrhs == 8 && !isRealScalar(trailTicks_IN)) 
+		mexErrMsgIdAndTxt( "MATLAB:numTicksProfit:BadInputType",
+		"Input 'trailTicks' must be a single scalar double. Aborting.");
+
 	// Assign variables
 	rowsPrice = mxGetM(bars_IN);
 	colsPrice = mxGetN(bars_IN);
 	rowsSig = mxGetM(sig_IN);
 	colsSig = mxGetN(sig_IN);
-	const double mxLINEAR_SIZE = rowsPrice * colsPrice;					// mxArray is passed as a continuous 1 dimensional array
-
-	//	Assign shift variables
-	//	This allows up to properly traverse the mxArray which is in an N x 1 form concatenating all columns
-	shiftOpen = 0;							// used for readability 
-	shiftHigh = rowsPrice;
-	shiftLow = 2 * rowsPrice;
-	shiftClose = 3 * rowsPrice;				
 
 	// Additional check of inputs
 	if (rowsPrice != rowsSig)
@@ -218,10 +206,6 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 		mexErrMsgIdAndTxt( "MATLAB:numTicksProfit:ScalarMismatch",
 		"Input 'minTick' must be a double scalar value. Aborting.");
 
-	if (!isRealScalar(numTicks_IN)) 
-		mexErrMsgIdAndTxt( "MATLAB:numTicksProfit:ScalarMismatch",
-		"Input 'numTicks' must be a double scalar value. Aborting.");
-
 	if (colsPrice != 4)
 		mexErrMsgIdAndTxt( "MATLAB:numTicksProfit:ArrayMismatch",
 		"Input 'barsIn' must be a 2 dimensional full double array of type Open | High | Low | Close. Aborting.");
@@ -232,8 +216,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 
 	/* Assign scalar values */
 	minTick =	mxGetScalar(minTick_IN);
-	numTicks =	mxGetScalar(numTicks_IN);
+	numTicksPtr = mxGetPr(numTicks_IN);
+	numTgts = int(mxGetNumberOfElements(numTicks_IN));
 	openAvg =	mxGetScalar(openAvg_IN);
+	fixedPoint = (nrhs >= 6) && (mxGetScalar(fixedPoint_IN) != 0);
+	stopTicks = (nrhs >= 7) ? mxGetScalar(stopTicks_IN) : 0;
+	trailTicks = (nrhs == 8) ? mxGetScalar(trailTicks_IN) : 0;
 
 	// Final check of inputs
 	if ((openAvg != 0) && (openAvg != 1))
@@ -248,666 +236,128 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 			"Input 'minTick' must be an integer greater than or equal to zero. \nInput was given as %d. Aborting.", minTick);
 	}
 
-	PROFIT_TGT = (minTick * numTicks);
+	if (stopTicks < 0 || trailTicks < 0)
+	{
+		mexErrMsgIdAndTxt( "MATLAB:numTicksProfit:stopError",
+			"Inputs 'stopTicks' and 'trailTicks' must be greater than or equal to zero. Aborting.");
+	}
 
-	// START //
-	// Initialize variables
-	int	sigIndex;							// Iterator that will store the index of the referenced signal
-	bool anyTrades = false;					// Trade logical
+	// All state for the evaluation is held by the engine.  It is scoped so it is released before any error is raised.
+	bool ok = true;
+	double badSig = 0;
 
-	// Check that we have at least one signal (at least one trade)
-	for (sigIndex=0; sigIndex < int(rowsSig); sigIndex++)					// Remember C++ starts counting at '0'
+	if (nlhs == 4 && numTgts == 1)
 	{
-		if (isTrade(sigInPtr[sigIndex]))	// See if we have a signal
-		{
-			anyTrades = true;
-			break;							// Exit the for loop
-		}
-	}	
+		mexErrMsgIdAndTxt( "MATLAB:numTicksProfit:NumOutputs",
+			"Stop fills are returned separately only when 'numTicks' is a vector. Aborting.");
+	}
 
-	// If there are no trades or the minTick is zero indicating no profit taking then return the original input.
-	// Otherwise start the check for profit targets reached per open position
-	// We have no trades
-	if (!anyTrades || minTick == 0)						
+	if (numTgts > 1 && nlhs != 4 && (stopTicks > 0 || trailTicks > 0))
 	{
-		// http://www.mathworks.com/support/solutions/en/data/1-6NU359/index.html
-		// Return what we were given
-		bars_OUT	= mxCreateSharedDataCopy(bars_IN);
-		sig_OUT		= mxCreateSharedDataCopy(sig_IN);
+		mexErrMsgIdAndTxt( "MATLAB:numTicksProfit:NumOutputs",
+			"A sweep with stops returns [pftSig,pftPrice,stopSig,stopPrice]. Aborting.");
 	}
-	// We have trades
-	else									
-	{
-		double minMax;									// Current minimum | maximum to optimize (minimize) checks
-
-		/////////////
-		//
-		// FIRST SIGNAL PROCESSING
-		//
-		/////////////	
-		
-		// Initialize ledgers for open positions and profits
-		list<openEntry> openLedger;
-		list<profitEntry> profitLedger;
-
-		// Put first detected trade on openLedger
-		openLedger.push_back(createOpenLedgerEntry(sigIndex, int(sigInPtr[sigIndex]), barsInPtr[sigIndex + 1 + shiftOpen]));
-
-		// Short signal.  Assign minMax to LOW
-		if (sigInPtr[sigIndex] < 0)		
-		{
-			minMax = barsInPtr[sigIndex + 1 + shiftLow];
-		}
-		// Long signal. Assign minMax to HIGH
-		else if (sigInPtr[sigIndex] > 0)	
-		{
-			minMax = barsInPtr[sigIndex + 1 + shiftHigh];
-		}
 
-		// Check for profit on same observation
-		// 'minMax' has been updated so we can safely call 'sameBarProfitCheck'
-		int openPosition = int(sigInPtr[sigIndex]);
-		sameBarProfitCheck(openLedger, profitLedger, sigIndex, int(sigInPtr[sigIndex]), openPosition, minMax);
-
-		// FIRST BAR END
+	// Sweep of profit targets
+	if (numTgts > 1)
+	{
+		pftSig_OUT = mxCreateDoubleMatrix(rowsPrice, numTgts, mxREAL);
+		pftPrice_OUT = mxCreateDoubleMatrix(rowsPrice, numTgts, mxREAL);
 
-		/////////////
-		//
-		// ITERATE SECTION
-		//
-		/////////////
+		// Without stops there is nothing to fill these but they are returned when asked for
+		mxArray *stopSig = mxCreateDoubleMatrix(rowsPrice, numTgts, mxREAL);
+		mxArray *stopPrice = mxCreateDoubleMatrix(rowsPrice, numTgts, mxREAL);
 
-		// ITERATE REMAINING BARS
-		// sigIndex = first signal index
-		for (int curBar=sigIndex + 1; curBar < int(rowsSig)-1; curBar++)
 		{
+			// The shared engine prepares the prices and signals once (fixed point) for every target
+			numTicksEngine shared(barsInPtr, sigInPtr, int(rowsPrice), minTick, numTicksPtr[0], openAvg != 0, fixedPoint);
+			shared.setStops(stopTicks, trailTicks);
+			vector<numTicksEngine> engines;
+			engines.reserve(numTgts);
+			for (int tgt = 0; tgt < numTgts; tgt++)
+			{
+				engines.push_back(numTicksEngine(shared, numTicksPtr[tgt]));
+			}
 
-		// ORDER OF SIGNIFICANCE from a signal with an existing position
-			// REVERSE
-			if (fraction(sigInPtr[curBar]))
+			// Every target opens on the same first trade.  Advance them in lockstep so each observation is read once.
+			bool anyTrades = true;
+			for (int tgt = 0; tgt < numTgts; tgt++)
 			{
-				// Is fraction the same sign (additive in nature) ?
-				// Additive
-				if (sign(sigInPtr[curBar] == sign(openPosition)))
-				{
-					// Nothing to do with the current logic
-					// The only fraction currently in use is |0.5| to liquidate entire opposing openPosition
-				}
-				// Reductive (liquidate)
-				else
-				{
-					// Adding logic here for prevention of 'other' fractions or surprising inputs
-					if (knownAdvSig(sigInPtr[curBar]))
-					{
-						// Liquidate any open position
-						openLedger.clear();
-						openPosition = 0;
-					}
-					// Unknown advanced instruction
-					else
-					{
-						mexErrMsgIdAndTxt( "MATLAB:AdvancedSignal:fractionUnknown",
-							"A signal contained an advanced fractional instruction that we could not interpret. Aborting.");
-					}
-				}
+				anyTrades = engines[tgt].start();
 			}
 
-			// REDUCE or ADD
-			// Do we have a signal with an integer portion ?
-			if (abs(int(sigInPtr[curBar])) >= 1)
+			if (anyTrades)
 			{
-				// Signal is reductive
-				if ((int(sigInPtr[curBar]) > 0 && openPosition < 0) || (int(sigInPtr[curBar]) < 0 && openPosition > 0))					
-				{
-					// Signal is effectively a reverse or liquidate
-					if (int(sigInPtr[curBar]) >= openPosition)
-					{
-						openPosition = int(sigInPtr[curBar]) + openPosition;
-						openLedger.clear();
-						if (openPosition != 0)
-						{
-							openLedger.push_back(createOpenLedgerEntry(curBar, openPosition, barsInPtr[curBar + 1 + shiftOpen]));
-						}
-					}
-					else
-					{
-						// How many do we need to reduce by?
-						int needQty = int(sigInPtr[curBar]);
-						// Prepare to iterate until we are satisfied
-						while (needQty !=0)
-						{
-							// Is the current line item quantity larger than what we need?
-							if (abs(openLedger.front().qtyOpen) > needQty)
-							{
-								// Reduce the position size.  We are aggregating so we add (e.g. 5 Purchases + 4 Sales = 1 Long)
-								openLedger.front().qtyOpen = openLedger.front().qtyOpen + needQty;
-								// We are satisfied and don't need any more contracts
-								needQty = 0;
-							}
-							// Current line item quantity is equal to or smaller than what we need.  Process P&L and remove.
-							else
-							{
-								// Reduce needed quantity by what we've been provided
-								needQty = needQty + openLedger.front().qtyOpen;
-								// Remove the line item (FIFO)
-								openLedger.pop_front();
-							}
-						}
-						openPosition = openPosition + int(sigInPtr[curBar]);
-					}
-				}
-				// Signal is additive
-				else
+				for (int curBar = engines[0].firstBar(); ok && curBar < int(rowsPrice) - 1; curBar++)
 				{
-					// Before adding, check if the open qualifies to liquidate any existing position
-					if (openPosition != 0)
+					for (int tgt = 0; ok && tgt < numTgts; tgt++)
 					{
-						chkOpenMethod(openPosition, curBar, minMax, openLedger, profitLedger);
+						ok = engines[tgt].step(curBar, badSig);
 					}
-					
-					// Process addition
-					// Put trade on openLedger
-					openLedger.push_back(createOpenLedgerEntry(curBar, int(sigInPtr[curBar]), barsInPtr[curBar + 1 + shiftOpen]));
-					openPosition = openPosition + int(sigInPtr[curBar]);
-					sameBarProfitCheck(openLedger, profitLedger, curBar, int(sigInPtr[curBar]), openPosition, minMax);
 				}
-			}
-			// NONE
-			else
-			{
-				// We can just check against the open and leave the range check for all entries on the openLedger below
-				// Only check if necessary
-				if (openPosition !=0)
+
+				for (int tgt = 0; ok && tgt < numTgts; tgt++)
 				{
-					chkOpenMethod(openPosition, curBar, minMax, openLedger, profitLedger);
+					engines[tgt].finish();
+					engines[tgt].getProfits(mxGetPr(pftSig_OUT) + tgt * rowsPrice, mxGetPr(pftPrice_OUT) + tgt * rowsPrice,
+						mxGetPr(stopSig) + tgt * rowsPrice, mxGetPr(stopPrice) + tgt * rowsPrice);
 				}
-				
-			}
-
-			// Check for extremes that result in a profit for any openPosition
-			if (openPosition != 0)
-			{
-				checkMinMax(openLedger, profitLedger, curBar, openPosition, minMax);
 			}
 		}
 
-		/////////////
-		//
-		// OUTPUT PROCESSING
-		//
-		/////////////
-		if (!profitLedger.empty())
+		if (nlhs == 4)
 		{
-			shrinkProfitLedger(profitLedger);
-			int numNewObsv = profitLedger.size();				// number of new signals and virtual profit bars to add
-
-			/* Create matrices for the return arguments */ 
-			// http://www.mathworks.com/help/matlab/matlab_external/c-c-source-mex-files.html
-			// http://www.mathworks.com/help/matlab/apiref/mxcreatedoublematrix.html
-			mwSize numNewRows = rowsPrice + (mwSize)numNewObsv;
-
-			bars_OUT = mxCreateDoubleMatrix(numNewRows, 4, mxREAL);
-			sig_OUT = mxCreateDoubleMatrix(numNewRows, 1, mxREAL);
-
-			// assign the variables for manipulating the arrays (by pointer reference)
-			barsOutPtr = mxGetPr(bars_OUT);
-			sigOutPtr = mxGetPr(sig_OUT);
-
-			// Temporary lists
-			list<double> signals;
-			list<double> vBars;
-
-			// List iterators
-			list<double>::const_iterator signalsIter		= signals.begin();
-			list<double>::const_iterator vBarsIter			= vBars.begin();
-			list<double>::const_iterator vBarsOpenIter		= vBars.begin();
-			list<double>::const_iterator vBarsHighIter		= vBars.begin();
-			list<double>::const_iterator vBarsLowIter		= vBars.begin();
-			list<double>::const_iterator vBarsCloseIter		= vBars.begin();
-
-			// Preposition pointers
-			advance(vBarsHighIter, shiftHigh);
-			advance(vBarsLowIter, shiftLow);
-			advance(vBarsCloseIter, shiftClose);
-
-			// deep copy mxArray --> myDblList
-			for (int iter = 0; iter < mxLINEAR_SIZE; iter++)
-			{
-				vBars.push_back(barsInPtr[iter]);
-			}
-
-			for (int iter = 0; iter < int(rowsSig); iter++)
-			{
-				signals.push_back(sigInPtr[iter]);
-			}
-
-			// Inserts based on profitLedger
-			list<profitEntry>::iterator pftIter;
-			int shiftAdd = 0;
-			int lastLoc = 0;
-
-			// Reset pointers
-			signalsIter		= signals.begin();
-			vBarsOpenIter	= vBars.begin();
-			vBarsHighIter	= vBars.begin();
-			vBarsLowIter	= vBars.begin();
-			vBarsCloseIter	= vBars.begin();
-
-			advance(vBarsHighIter, shiftHigh);
-			advance(vBarsLowIter, shiftLow);
-			advance(vBarsCloseIter, shiftClose);
-
-			// Move price pointer to sync with signal pointer (signal lags price by one bar)
-			vBarsOpenIter++;
-			vBarsHighIter++;
-			vBarsLowIter++;
-			vBarsCloseIter++;
-
-			// At this point we should have pointers as
-			// signals[0]
-			// vBarsOpenIter[1]
-			// vBarsHighIter[1 + shiftHigh] ...
-
-			// Because we insert before the current index we move all pointers 'in front' of the insertion point
-			signalsIter++;
-			vBarsOpenIter++;
-			vBarsHighIter++;
-			vBarsLowIter++;
-			vBarsCloseIter++;
-
-			while (!profitLedger.empty())
-			{
-				pftIter = profitLedger.begin();
-
-				shiftAdd = pftIter->barIndex - lastLoc;
-
-				// Advance the pointers to insert location
-				advance(signalsIter, shiftAdd);
-				advance(vBarsOpenIter, shiftAdd);
-				advance(vBarsHighIter, shiftAdd);
-				advance(vBarsLowIter, shiftAdd);
-				advance(vBarsCloseIter, shiftAdd);
-
-				signals.insert(signalsIter, pftIter->qtyProfit);
-				vBars.insert (vBarsOpenIter,pftIter->profitPrice);
-				vBars.insert (vBarsHighIter,pftIter->profitPrice);
-				vBars.insert (vBarsLowIter,pftIter->profitPrice);
-				vBars.insert (vBarsCloseIter,pftIter->profitPrice);
-
-				lastLoc = pftIter->barIndex;
-
-				profitLedger.pop_front();
-			}
-
-			// Reset pointer
-			int outIter = 0;
-
-			for (vBarsIter	= vBars.begin(); vBarsIter != vBars.end(); vBarsIter++)
-			{
-				barsOutPtr[outIter] = *vBarsIter;
-				outIter++;
-			}
-
-			// Reset index
-			outIter = 0;
-			for (signalsIter = signals.begin(); signalsIter != signals.end(); signalsIter++)
-			{
-				sigOutPtr[outIter] = *signalsIter;
-				outIter++;
-			}
-		}
-		else // return inputs
-		{
-			// http://www.mathworks.com/support/solutions/en/data/1-6NU359/index.html
-			// Return what we were given
-
-			bars_OUT = mxCreateSharedDataCopy(bars_IN);
-			sig_OUT = mxCreateSharedDataCopy(sig_IN);
-		}
-		
-	}
-
-	return;
-}
-
-/////////////
-//
-// FUNCTIONS & METHODS
-//
-/////////////
-
-// Constructor for ledger line item creation
-openEntry createOpenLedgerEntry(int ID, int qty, double price)
-{
-	openEntry OpenLedgerEntry;
-	OpenLedgerEntry.sigIndex = ID;
-	OpenLedgerEntry.qtyOpen = qty;
-	OpenLedgerEntry.openPrice = price;
-	if (qty < 0)
-	{
-		OpenLedgerEntry.profitPrice = price - (minTick * numTicks);
-	}
-	else
-	{
-		OpenLedgerEntry.profitPrice = price + (minTick * numTicks);
-	}
-
-	return OpenLedgerEntry;
-}
-
-profitEntry createProfitLedgerEntry(int ID, int qty, double price)
-{
-	profitEntry ProfitLedgerEntry;
-	ProfitLedgerEntry.barIndex = ID;
-	ProfitLedgerEntry.qtyProfit = qty;												// Quantity already transformed at calling function
-	ProfitLedgerEntry.profitPrice = price;
-
-	return ProfitLedgerEntry;
-}
-
-void moveProfitLedger(list<profitEntry> &profitLedger, const int ID, int qty, double price)
-{
-	// We take the price of the next observation for the generated signal
-	// We reverse the quantity to reflect closing of the positions
-	profitLedger.push_back(createProfitLedgerEntry(ID, qty * -1, price));	
-}
-
-void sameBarProfitCheck(list<openEntry> &openLedger, list<profitEntry> &profitLedger, const int ID, int qty, int &openPosition, double &minMax)
-{
-	if (openAvg == 0)
-	{
-		// Is there a profit on the bar of the trade? 
-		// Short signal - check LOW
-		if ((qty < 0) && (barsInPtr[ID + 1 + shiftLow] < barsInPtr[ID + 1 + shiftOpen] - PROFIT_TGT))
-		{
-			// We have a profit on the same observation.  Move the entry in the profit ledger
-			moveProfitLedger(profitLedger, ID, qty, barsInPtr[ID + 1 + shiftOpen] - PROFIT_TGT);
-			openPosition = openPosition - qty;
-			openLedger.pop_back();
+			stopSig_OUT = stopSig;
+			stopPrice_OUT = stopPrice;
 		}
-		// Long signal - check HIGH
-		else if ((qty > 0) && (barsInPtr[ID + 1 + shiftHigh] > barsInPtr[ID + 1 + shiftOpen] + PROFIT_TGT))	
-		{
-			// We have a profit on the same observation.  Put entry in the profit ledger
-			moveProfitLedger(profitLedger, ID, qty, barsInPtr[ID + 1 + shiftOpen] + PROFIT_TGT);
-			openPosition = openPosition - qty;
-			openLedger.pop_back();
-		} 
 		else
 		{
-			openPosition = openPosition + qty;
+			mxDestroyArray(stopSig);
+			mxDestroyArray(stopPrice);
 		}
-	}
-	else
-	{
-
-		// Check same bar using new average
-		// Requires minMax already updated !!
-		newAvgChk(openLedger, profitLedger, ID, openPosition, minMax);
 
-	}
-}
-
-// A new High | Low has occurred and we have determined that we have an openPosition
-// Check if profit targets have been reached
-void newMinMax(list<openEntry> &openLedger,  list<profitEntry> &profitLedger, const int ID, int &openPosition, double &minMax)
-{
-	if (!openLedger.empty())
-	{
-		if (openAvg == 0)
-		{
-			list<openEntry>::iterator iter;
-			for (iter = openLedger.begin(); iter != openLedger.end(); iter++)
-			{
-				// Short. Check minMax <= profitPrice
-				if (openPosition < 0)				
-				{
-					if (minMax <= iter->profitPrice)
-					{
-						moveProfitLedger(profitLedger, ID, iter->qtyOpen, iter->profitPrice);
-						openLedger.erase(iter);
-					}
-				}
-				// Long. Check minMax >= profitPrice
-				else if (openPosition > 0)		
-				{
-					if (minMax >= iter->profitPrice)
-					{
-						moveProfitLedger(profitLedger, ID, iter->qtyOpen, iter->profitPrice);
-						openLedger.erase(iter);
-					}
-				}
-			}
-			openPosition = sumQty(openLedger);
-		}
-		// Using the average price approach 
-		else
-		{
-			newAvgChk(openLedger, profitLedger, ID, openPosition, minMax);
-		}
-	}
-}
-
-void newAvgChk(list<openEntry> &openLedger, list<profitEntry> &profitLedger, const int ID, int &openPosition, double &minMax)
-{
-	double profitPrice = getAvgPftPrice(openLedger);
-
-	if (openPosition < 0)				// Short. Check minMax <= profitPrice
-	{
-		if (minMax <= profitPrice)
-		{
-			while (!openLedger.empty())
-			{
-				moveProfitLedger(profitLedger, openLedger.front().sigIndex, openLedger.front().qtyOpen, profitPrice);
-				profitLedger.pop_front();
-			}
-			openPosition = 0;
-		}
-	}
-	else if (openPosition > 0)			// Long. Check minMax >= profitPrice
-	{
-		if (minMax >= profitPrice)
+		if (!ok)
 		{
-			while (!openLedger.empty())
-			{
-				moveProfitLedger(profitLedger, openLedger.front().sigIndex, openLedger.front().qtyOpen, profitPrice);
-				profitLedger.pop_front();
-			}
-			openPosition = 0;
+			mexErrMsgIdAndTxt( "MATLAB:AdvancedSignal:fractionUnknown",
+				"A signal contained an advanced fractional instruction that we could not interpret (%f). Aborting.", badSig);
 		}
-	}
-}
-
-double getAvgPftPrice(const list<openEntry> &openLedger)
-{
-	int netQty = 0;
-	double wghtPrices = 0;
-	double sumWghts = 0;
-	double wghtAvg = 0;
-	double profitPrice = 0;
 
-
-	list<openEntry>::const_iterator iter;
-	for (iter = openLedger.begin(); iter != openLedger.end(); iter++)
-	{
-		netQty = netQty + iter->qtyOpen;
-		sumWghts = sumWghts + (abs(iter->qtyOpen) * iter->openPrice);
+		return;
 	}
 
-	wghtAvg = sumWghts / abs(netQty);
-
-	// Short objective
-	if (netQty < 0)
 	{
-		profitPrice = wghtAvg - PROFIT_TGT;
-	}
-	// Long objective
-	else
-	{
-		profitPrice = wghtAvg + PROFIT_TGT;
-	}
-
-	return profitPrice;
-}
+		numTicksEngine engine(barsInPtr, sigInPtr, int(rowsPrice), minTick, numTicksPtr[0], openAvg != 0, fixedPoint);
+		engine.setStops(stopTicks, trailTicks);
+		ok = engine.run(badSig);
 
-void checkOpen(list<openEntry> &openLedger, list<profitEntry> &profitLedger, const int ID, int &openPosition)
-{
-	if (openAvg == 0)
-	{
-		for (list<openEntry>::iterator iter = openLedger.begin(); iter != openLedger.end(); iter++)
+		if (ok && engine.numProfits() > 0)
 		{
-			// Short
-			if (openPosition < 0)
-			{
-				if (barsInPtr[ID + 1 + shiftOpen] <= iter->profitPrice)
-				{
-					// Open satisfies profit threshold
-					moveProfitLedger(profitLedger, ID, iter->qtyOpen, barsInPtr[ID + 1 + shiftOpen]);
-					openLedger.erase(iter);
-					openPosition = sumQty(openLedger);
-				}
-			}
-			// Long
-			else
-			{
-				if (barsInPtr[ID + 1 + shiftOpen] >= iter->profitPrice)
-				{
-					// Open satisfies profit threshold
-					moveProfitLedger(profitLedger, ID, iter->qtyOpen, barsInPtr[ID + 1 + shiftOpen]);
-					openLedger.erase(iter);
-					openPosition = sumQty(openLedger);
-				}
-			}
-		}
-	}
-	else
-	{
-		double profitPrice = getAvgPftPrice(openLedger);
+			/* Create matrices for the return arguments */ 
+			// http://www.mathworks.com/help/matlab/matlab_external/c-c-source-mex-files.html
+			// http://www.mathworks.com/help/matlab/apiref/mxcreatedoublematrix.html
+			mwSize numNewRows = rowsPrice + (mwSize)engine.numProfits();
 
-		if (openPosition < 0)
-		{
-			if (barsInPtr[ID + 1 + shiftOpen] <= profitPrice)
-			{
-				// Open satisfies profit threshold
-				while (!openLedger.empty())
-				{
-					moveProfitLedger(profitLedger, openLedger.front().sigIndex, openLedger.front().qtyOpen, barsInPtr[ID + 1 + shiftOpen]);
-					profitLedger.pop_front();
-				}
-				openPosition = 0;
-			}
-		}
-		else
-		{
-			if (barsInPtr[ID + 1 + shiftOpen] >= profitPrice)
-			{
-				// Open satisfies profit threshold
-				while (!openLedger.empty())
-				{
-					moveProfitLedger(profitLedger, openLedger.front().sigIndex, openLedger.front().qtyOpen, barsInPtr[ID + 1 + shiftOpen]);
-					profitLedger.pop_front();
-				}
-			}
-			openPosition = 0;
-		}
-	}
-};
+			bars_OUT = mxCreateDoubleMatrix(numNewRows, 4, mxREAL);
+			sig_OUT = mxCreateDoubleMatrix(numNewRows, 1, mxREAL);
 
-void checkMinMax(list<openEntry> &openLedger, list<profitEntry> &profitLedger, const int ID, int &openPosition, double &minMax)
-{
-	if (openPosition < 0)								// Short.  Check minMax to LOW
-	{
-		if (barsInPtr[ID + 1 + shiftLow] < minMax)		//New minMax
-		{
-			minMax = barsInPtr[ID + 1 + shiftLow];
-			newMinMax(openLedger, profitLedger, ID, openPosition, minMax);
+			engine.getOutput(mxGetPr(bars_OUT), mxGetPr(sig_OUT));
 		}
-	}
-	else if (openPosition > 0)							// Long.  Check minMax to HIGH
-	{
-		if (barsInPtr[ID + 1 + shiftHigh] > minMax)		//New minMax
-		{
-			minMax = barsInPtr[ID + 1 + shiftHigh];
-			newMinMax(openLedger, profitLedger, ID, openPosition, minMax);
-		}			
-	}
-}
-
-void shrinkProfitLedger(list<profitEntry> &profitLedger)
-{
-	list<profitEntry>::iterator iterMain, iterPlusOne;
-
-	iterPlusOne = profitLedger.begin();		// Instantiate look ahead iterator first
-
-	for (iterMain = profitLedger.begin(); iterMain != profitLedger.end(); iterMain++)
-	{
-		++iterPlusOne;						// Advance the look ahead pointer so it is always iterMain+1;
-		if ((iterMain->barIndex == iterPlusOne->barIndex) &&
-			(sign(iterMain->qtyProfit) == sign(iterPlusOne->qtyProfit)))
+		else if (ok) // return inputs
 		{
-			iterPlusOne->qtyProfit = iterPlusOne->qtyProfit + iterMain->qtyProfit;
-			profitLedger.erase(iterMain);
+			// http://www.mathworks.com/support/solutions/en/data/1-6NU359/index.html
+			// Return what we were given
+			bars_OUT = mxCreateSharedDataCopy(bars_IN);
+			sig_OUT = mxCreateSharedDataCopy(sig_IN);
 		}
 	}
-}
-
-bool isTrade(double isSig)
-{
-	if (abs(isSig)>=1)
-	{
-		return true;
-	}
-	return false;
-}
-
-bool knownAdvSig(double advSig)
-{
-	// We can check for known advanced signals to help in debugging
-	// by registering them here.  This can be a searchable array when
-	// more than one advanced signal exists.
-	// For now we only need to check for |0.5|
-
-	double frac = abs(advSig - int(advSig));
-
-	if (frac == 0.5)		// Close any opposing open position
-	{
-		return true;
-	}
-	return false;
-}
 
-// Method to sum the quantity values in any struct of type tradeEntry
-int sumQty(const list<openEntry>& theList)
-{
-	int sumOfQty = 0;  // the sum is accumulated here
-	// for (int i=0; i<x.size(); i++)
-	for (list<openEntry>::const_iterator it=theList.begin(); it!=theList.end(); it++)
+	if (!ok)
 	{
-		sumOfQty += it->qtyOpen;
+		mexErrMsgIdAndTxt( "MATLAB:AdvancedSignal:fractionUnknown",
+			"A signal contained an advanced fractional instruction that we could not interpret (%f). Aborting.", badSig);
 	}
 
-	return sumOfQty;
-}
-
-void chkOpenMethod(int &openPosition, const int curBar, double &minMax, list<openEntry> &openLedger, list<profitEntry> &profitLedger )
-{
-	if (openPosition < 0)
-	{
-		// We can add a check to reduce calls to the function unless necessary
-		if(barsInPtr[curBar + 1 + shiftOpen] < minMax)
-		{
-			checkOpen(openLedger, profitLedger, curBar, openPosition);
-			minMax = barsInPtr[curBar + 1 + shiftOpen];
-		}
-	}
-	else if (openPosition > 0)
-	{
-		if(barsInPtr[curBar + 1 + shiftOpen] > minMax)
-		{
-			checkOpen(openLedger, profitLedger, curBar, openPosition);
-			minMax = barsInPtr[curBar + 1 + shiftOpen];
-		}
-	}	
+	return;
 }
 
 //
@@ -0,0 +1,334 @@
+// ravi.cpp
+// Localized mex'ing: mex COMPFLAGS="$COMPFLAGS /openmp" ravi.cpp -output ravi_mex
+//		(OpenMP is optional.  Without it (lead, lag) pairs are processed serially.)
+//
+// Native replacement for the coder build of ravi.m (ravi_mex).
+//
+// Range Action Verification Index after Tushar S. Chande.  The distance between a fast and a slow harmonic mean
+// of the close, relative to the slow mean (D = 0) or to the average true range (D = 1), scaled so the mean of
+// the result is M.
+//
+//	NOTE:	ravi.m calls slidefun('harmmean', ...) which evaluates every window in full: O(n * window).
+//			The harmonic mean of a window is its length over the sum of the reciprocals in it.  The reciprocals
+//			are accumulated once into a cumulative sum shared by every lead and lag so each harmonic mean is
+//			O(1) per bar.  The sum is kept relative to the first reciprocal to limit rounding.
+//			As with slidefun's 'backward' window the first (window - 1) bars use the observations available.
+//
+// nlhs Number of output variables nargout 
+// plhs Array of mxArray pointers to the output variables varargout
+// nrhs Number of input variables nargin
+// prhs Array of mxArray pointers to the input variables varargin
+//
+// Matlab function:
+// ind = ravi_mex(price, lead, lag, D, M)
+// 
+// Inputs:
+//		price		O | H | L | C
+//		lead		Lookback of the fast harmonic mean (default 5), or a vector of K leads
+//		lag			Lookback of the slow harmonic mean (default 65), or a vector of K lags
+//		D			Detrender option (default 0):
+//						0	-	Ravi
+//						1	-	ATR (exponential, 20 bars)
+//		M			Mean ravi shift used to calibrate the returned vector (default 20)
+//
+//		lead and lag form K pairs (lead(k), lag(k)).  A scalar is paired with every value of the other.
+//
+// Outputs:
+//		ind			The RAVI.  N x K, one column per (lead, lag) pair.
+//
+
+#include "mex.h"
+#include <cmath>
+
+using namespace std;
+
+// Macros
+#define isReal2DfullDouble(P) (!mxIsComplex(P) && mxGetNumberOfDimensions(P) == 2 && !mxIsSparse(P) && mxIsDouble(P))
+#define isRealScalar(P) (isReal2DfullDouble(P) && mxGetNumberOfElements(P) == 1)
+#define isRealVector(P) (isReal2DfullDouble(P) && mxGetNumberOfElements(P) > 0 && (mxGetM(P) == 1 || mxGetN(P) == 1))
+
+// Lookback of the ATR used by D = 1 (atr_mex default)
+#define ATR_LOOKBACK	20
+
+// Prototypes
+void raviRecipSums(const double *closePtr, int rows, double *cumRecip, double &ref);
+double raviHarmMean(const double *cumRecip, double ref, int ii, int window);
+void raviATR(const double *highPtr, const double *lowPtr, const double *closePtr, int rows, int lookback, double *atr);
+void raviKernel(const double *cumRecip, double ref, int rows, int lead, int lag, const double *atr, double M, double *ind);
+
+void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
+				 int nrhs, const mxArray *prhs[]) /* Input variables */
+{
+	// Check number of inputs
+	if (nrhs < 1 || nrhs > 5)
+		mexErrMsgIdAndTxt( "MATLAB:ravi:NumInputs",
+		"Number of input arguments is not correct. Aborting.");
+
+	if (nlhs > 1)
+		mexErrMsgIdAndTxt( "MATLAB:ravi:NumOutputs",
+		"Number of output assignments is not correct. Aborting.");
+
+	// Define constants (#define assigns a variable as either a constant or a macro)
+	// Inputs
+#define price_IN	prhs[0]
+#define lead_IN		prhs[1]
+#define lag_IN		prhs[2]
+#define D_IN		prhs[3]
+#define M_IN		prhs[4]
+
+	// Outputs
+#define ind_OUT		plhs[0]
+
+	// Check type of supplied inputs
+	if (!isReal2DfullDouble(price_IN) || mxGetN(price_IN) != 4) 
+		mexErrMsgIdAndTxt( "RAVI:tooFewInputs",
+		"We call ATR to normalize price data therefore we need O | H | L | C as price input. Exiting.");
+
+	int rows = int(mxGetM(price_IN));
+
+	// Defaults
+	double leadDefault = 5, lagDefault = 65;
+	const double *leadPtr = &leadDefault, *lagPtr = &lagDefault;
+	int numLead = 1, numLag = 1, D = 0;
+	double M = 20;
+
+	if (nrhs > 1)
+	{
+		if (!isRealVector(lead_IN))
+			mexErrMsgIdAndTxt( "RAVI:inputArgs",
+			"Input 'lead' must be a scalar or a vector. Aborting.");
+		leadPtr = mxGetPr(lead_IN);
+		numLead = int(mxGetNumberOfElements(lead_IN));
+	}
+
+	if (nrhs > 2)
+	{
+		if (!isRealVector(lag_IN))
+			mexErrMsgIdAndTxt( "RAVI:inputArgs",
+			"Input 'lag' must be a scalar or a vector. Aborting.");
+		lagPtr = mxGetPr(lag_IN);
+		numLag = int(mxGetNumberOfElements(lag_IN));
+	}
+
+	if (nrhs > 3)
+	{
+		if (!isRealScalar(D_IN))
+			mexErrMsgIdAndTxt( "RAVI:inputArg",
+			"Input 'D' must be a scalar. Aborting.");
+		D = int(mxGetScalar(D_IN));
+	}
+
+	if (nrhs > 4)
+	{
+		if (!isRealScalar(M_IN))
+			mexErrMsgIdAndTxt( "RAVI:inputArgs",
+			"Input 'M' must be a scalar. Aborting.");
+		M = mxGetScalar(M_IN);
+	}
+
+	if (D != 0 && D != 1)
+		mexErrMsgIdAndTxt( "RAVI:inputArg",
+		"Unknown input in value 'D'. Aborting.");
+
+	if (M < 1)
+		mexErrMsgIdAndTxt( "RAVI:inputArgs",
+		"Lookback M must be a postive integer. Aborting");
+
+	if (numLead != numLag && numLead != 1 && numLag != 1)
+		mexErrMsgIdAndTxt( "RAVI:inputArgs",
+		"Inputs 'lead' and 'lag' must have the same number of elements or one must be a scalar. Aborting.");
+
+	int numPairs = (numLead > numLag) ? numLead : numLag;
+
+	for (int kk = 0; kk < numLead; kk++)
+	{
+		if (int(leadPtr[kk]) < 1)
+			mexErrMsgIdAndTxt( "RAVI:inputArgs",
+			"The lead lookback must be a positive integer. Aborting.");
+	}
+
+	for (int kk = 0; kk < numLag; kk++)
+	{
+		if (int(lagPtr[kk]) < 1)
+			mexErrMsgIdAndTxt( "RAVI:inputArgs",
+			"The lag lookback must be a positive integer. Aborting.");
+	}
+
+	/* Assign pointers to the input array */ 
+	double *pricePtr = mxGetPr(price_IN);
+	double *highPtr = pricePtr + rows;
+	double *lowPtr = pricePtr + 2 * rows;
+	double *closePtr = pricePtr + 3 * rows;
+
+	/* Create matrices for the return arguments */ 
+	ind_OUT = mxCreateDoubleMatrix(rows, numPairs, mxREAL);
+	double *indPtr = mxGetPr(ind_OUT);
+
+	// Shared by every pair.  mxMalloc'd memory is released by Matlab even on an error.
+	double *cumRecip = (double*)mxMalloc((rows + 1) * sizeof(double));
+	double *atr = NULL;
+	double ref;
+
+	/////////////
+	// START
+	/////////////
+
+	raviRecipSums(closePtr, rows, cumRecip, ref);
+
+	if (D == 1)
+	{
+		atr = (double*)mxMalloc(rows * sizeof(double));
+		raviATR(highPtr, lowPtr, closePtr, rows, ATR_LOOKBACK, atr);
+	}
+
+#pragma omp parallel for schedule(dynamic) if (numPairs > 1)
+	for (int kk = 0; kk < numPairs; kk++)
+	{
+		int lead = int(leadPtr[numLead > 1 ? kk : 0]);
+		int lag = int(lagPtr[numLag > 1 ? kk : 0]);
+
+		raviKernel(cumRecip, ref, rows, lead, lag, atr, M, indPtr + kk * rows);
+	}
+
+	mxFree(cumRecip);
+	if (atr != NULL)
+	{
+		mxFree(atr);
+	}
+
+	/////////////
+	// FINISHED
+	/////////////
+
+	return;
+}
+
+/////////////
+//
+// FUNCTIONS & METHODS
+//
+/////////////
+
+// cumRecip[i] is the sum of (1 / close - ref) over the first i observations where ref is the first reciprocal
+void raviRecipSums(const double *closePtr, int rows, double *cumRecip, double &ref)
+{
+	ref = (rows > 0) ? 1 / closePtr[0] : 0;
+
+	cumRecip[0] = 0;
+	for (int ii = 0; ii < rows; ii++)
+	{
+		cumRecip[ii + 1] = cumRecip[ii] + (1 / closePtr[ii] - ref);
+	}
+}
+
+// Harmonic mean of the (backward) window ending at bar ii.  Early bars use the observations available.
+double raviHarmMean(const double *cumRecip, double ref, int ii, int window)
+{
+	int count = (ii + 1 < window) ? ii + 1 : window;
+	double sumRecip = (cumRecip[ii + 1] - cumRecip[ii + 1 - count]) + count * ref;
+
+	return count / sumRecip;
+}
+
+// Average true range as atr_mex: the true range smoothed by an exponential average seeded with the first value
+void raviATR(const double *highPtr, const double *lowPtr, const double *closePtr, int rows, int lookback, double *atr)
+{
+	double alpha = 2.0 / (lookback + 1);
+
+	for (int ii = 0; ii < rows; ii++)
+	{
+		double tr = highPtr[ii] - lowPtr[ii];
+
+		if (ii > 0)
+		{
+			double hmc = fabs(highPtr[ii] - closePtr[ii - 1]);
+			double lmc = fabs(lowPtr[ii] - closePtr[ii - 1]);
+			if (hmc > tr) tr = hmc;
+			if (lmc > tr) tr = lmc;
+
+			atr[ii] = atr[ii - 1] + alpha * (tr - atr[ii - 1]);
+		}
+		else
+			atr[ii] = tr;
+	}
+}
+
+// One (lead, lag) pair.  The raw index is written first and its mean taken in the same pass, then it is scaled.
+void raviKernel(const double *cumRecip, double ref, int rows, int lead, int lag, const double *atr, double M, double *ind)
+{
+	double indSum = 0;
+
+	for (int ii = 0; ii < rows; ii++)
+	{
+		double raviF = raviHarmMean(cumRecip, ref, ii, lead);
+		double raviS = raviHarmMean(cumRecip, ref, ii, lag);
+
+		// Determine divisor for measuring the rate of change
+		double divisor = (atr == NULL) ? raviS : atr[ii];
+
+		ind[ii] = fabs(raviF - raviS) / divisor;
+		indSum = indSum + ind[ii];
+	}
+
+	// Normalize so the mean of the index is M
+	double norm = M / (indSum / rows);
+
+	for (int ii = 0; ii < rows; ii++)
+	{
+		ind[ii] = ind[ii] * norm;
+	}
+}
+//
+//  -------------------------------------------------------------------------
+//                                  _    _ 
+//         ___  _ __   ___ _ __    / \  | | __ _  ___   ___  _ __ __ _ 
+//        / _ \| '_ \ / _ \ '_ \  / _ \ | |/ _` |/ _ \ / _ \| '__/ _` |
+//       | (_) | |_) |  __/ | | |/ ___ \| | (_| | (_) | (_) | | | (_| |
+//        \___/| .__/ \___|_| |_/_/   \_\_|\__, |\___(_)___/|_|  \__, |
+//             |_|                         |___/                 |___/
+//  -------------------------------------------------------------------------
+//        This code is distributed in the hope that it will be useful,
+//
+//                      	   WITHOUT ANY WARRANTY
+//
+//                  WITHOUT CLAIM AS TO MERCHANTABILITY
+//
+//                  OR FITNESS FOR A PARTICULAR PURPOSE
+//
+//                          expressed or implied.
+//
+//   Use of this code, pseudocode, algorithmic or trading logic contained
+//   herein, whether sound or faulty for any purpose is the sole
+//   responsibility of the USER. Any such use of these algorithms, coding
+//   logic or concepts in whole or in part carry no covenant of correctness
+//   or recommended usage from the AUTHOR or any of the possible
+//   contributors listed or unlisted, known or unknown.
+//
+//   Any reference of this code or to this code including any variants from
+//   this code, or any other credits due this AUTHOR from this code shall be
+//   clearly and unambiguously cited and evident during any use, whether in
+//   whole or in part.
+//
+//   The public sharing of this code does not relinquish, reduce, restrict or
+//   encumber any rights the AUTHOR has in respect to claims of intellectual
+//   property.
+//
+//   IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY
+//   DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+//   OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+//   STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//   ANY WAY OUT OF THE USE OF THIS SOFTWARE, CODE, OR CODE FRAGMENT(S), EVEN
+//   IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//   -------------------------------------------------------------------------
+//
+//                             ALL RIGHTS RESERVED
+//
+//   -------------------------------------------------------------------------
+//
+//   Author:	Mark Tompkins
+//   Revision:	4906.24976
+//   Copyright:	(c)2013
+//
\ No newline at end of file
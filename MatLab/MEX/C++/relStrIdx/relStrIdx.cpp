@@ -1,4 +1,6 @@
 // relStrIdx.cpp 
+// Localized mex'ing: mex COMPFLAGS="$COMPFLAGS /openmp" relStrIdx.cpp rsiEngine.cpp
+//		(OpenMP is optional.  Without it instruments are processed serially.)
 //
 // Description available: http://en.wikipedia.org/wiki/Relative_strength_index
 //
@@ -10,6 +12,9 @@
 //						------------------------------------------
 //						(((Avg Loss[-1]*(N-1)) + Avg Loss[0]) / N)
 //
+//			The seed average is accumulated oldest first as the observations arrive.  The same Wilder
+//			primitives back the incremental rsiEngine, so a bar by bar replay matches this batch result.
+//
 //	NOTE:	The RS value has a weighting effect as it uses historical values in the ratio.
 //			As a consequence, "the more data" the more "tuned" an RSI will be.  This is also
 //			important to consider when comparing calculated RSI values across datasets.
@@ -23,16 +28,25 @@
 // rsi = relStrIdx_mex(data,N)
 // 
 // Inputs:
-//		data		A 1-D array of prices in the form of PRICE
-//		N			A scalar that defines the lookback period
+//		data		A 1-D array of prices in the form of PRICE, or an N x M array of M instruments
+//		N			A scalar that defines the lookback period, or a vector of K lookbacks
 //
 // Outputs:
-//		rsi			The calculated relative strength index (RSI)
+//		rsi			The calculated relative strength index (RSI).  When N is a vector, an array of K columns,
+//					one per lookback.  Advances and declines are computed once and the K recursions are
+//					advanced together in a single pass over the observations.
+//					Given M instruments the result is N x M, or N x M x K for K lookbacks.
+//
+//	NOTE:	Instruments are processed in blocks of adjacent columns.  Within a block the recursions of every
+//			instrument are advanced together so the update is vectorized across instruments.  Blocks are
+//			distributed across cores when compiled with OpenMP.  A single instrument's K lookbacks are
+//			advanced together instead, so a sweep is vectorized across lookbacks.
 //
 
 #include "mex.h"
 #include <cmath>
 #include <limits>
+#include "rsiEngine.h"
 
 using namespace std;
 
@@ -40,9 +54,8 @@ using namespace std;
 #define isReal2DfullDouble(P) (!mxIsComplex(P) && mxGetNumberOfDimensions(P) == 2 && !mxIsSparse(P) && mxIsDouble(P))
 #define isRealScalar(P) (isReal2DfullDouble(P) && mxGetNumberOfElements(P) == 1)
 
-// Global variables
-int obsvIn;
-double *barsInPtr;								// Pointer for the price matrix
+// Number of instruments advanced together
+#define BLOCK_COLS	8
 
 void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				 int nrhs, const mxArray *prhs[]) /* Input variables */
@@ -73,11 +86,6 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 	// Outputs
 #define rsi_OUT		plhs[0]
 
-	// Create a NaN value
-	// mxArray *nanvalue;
-	// nanvalue = mxCreateDoubleScalar(mxGetNaN());
-	double m_Nan = std::numeric_limits<double>::quiet_NaN(); 
-
 	// Init variables
 	mwSize rowsData, colsData;
 
@@ -90,117 +98,86 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 		mexErrMsgIdAndTxt( "MATLAB:relStrIdx:BadInputType",
 		"Input 'data' must be a 2 dimensional full double array. Aborting.");
 
-	if (!isRealScalar(obsv_IN)) 
-		mexErrMsgIdAndTxt( "MATLAB:relStrIdx:BadInputType",
-		"Input 'N' must be a single integer input. Aborting.");
-
-	if (colsData > 1)
+	if (!isReal2DfullDouble(obsv_IN) || mxGetNumberOfElements(obsv_IN) < 1 ||
+		(mxGetM(obsv_IN) > 1 && mxGetN(obsv_IN) > 1)) 
 		mexErrMsgIdAndTxt( "MATLAB:relStrIdx:BadInputType",
-		"We should only be given a 1-D price vector. Aborting.");
+		"Input 'N' must be an integer or a vector of integers. Aborting.");
 
 	/* Assign pointers to the input array */ 
-	barsInPtr =	mxGetPr(bars_IN);
+	double *barsInPtr =	mxGetPr(bars_IN);
 
-	/* Assign scalar values */
-	obsvIn =	int(mxGetScalar(obsv_IN));
+	/* Assign lookbacks */
+	int numObsv = int(mxGetNumberOfElements(obsv_IN));
+	double *obsvPtr = mxGetPr(obsv_IN);
 
-	if (obsvIn < 1)
-		mexErrMsgIdAndTxt( "MATLAB:relStrIdx:BadInputType",
-		"The observation lookback must be a positive integer >= 1. Aborting.");
+	// Validate before anything is allocated
+	int maxObsv = 0;
+	for (int kk = 0; kk < numObsv; kk++)
+	{
+		int obsv = int(obsvPtr[kk]);
 
-	if (obsvIn > rowsData)
-		mexErrMsgIdAndTxt( "MATLAB:relStrIdx:BadInputType",
-		"The lookback cannot be greater than the number of observations. Aborting.");
+		if (obsv < 1)
+			mexErrMsgIdAndTxt( "MATLAB:relStrIdx:BadInputType",
+			"The observation lookback must be a positive integer >= 1. Aborting.");
+
+		if (mwSize(obsv) > rowsData)
+			mexErrMsgIdAndTxt( "MATLAB:relStrIdx:BadInputType",
+			"The lookback cannot be greater than the number of observations. Aborting.");
+
+		if (obsv > maxObsv)
+		{
+			maxObsv = obsv;
+		}
+	}
 
 	/* Create matrices for the return arguments */ 
 	// http://www.mathworks.com/help/matlab/matlab_external/c-c-source-mex-files.html
-	rsi_OUT = mxCreateDoubleMatrix(rowsData, 1, mxREAL);
+	if (colsData > 1 && numObsv > 1)
+	{
+		mwSize dims[3] = {rowsData, colsData, (mwSize)numObsv};
+		rsi_OUT = mxCreateNumericArray(3, dims, mxDOUBLE_CLASS, mxREAL);
+	}
+	else
+	{
+		rsi_OUT = mxCreateDoubleMatrix(rowsData, colsData * numObsv, mxREAL);
+	}
 
 	// assign the variables for manipulating the arrays (by pointer reference)
 	double *RSI = mxGetPr(rsi_OUT);
 
-	// Create temporary arrays for calculations
-	double *advances = new double[rowsData];
-	double *declines = new double[rowsData];
-	double *avgGain = new double[rowsData];
-	double *avgLoss = new double[rowsData];
+	// Scratch is O(K) per instrument: the Wilder state per lookback.
+	// It is allocated here for every block as workers do not call the Matlab API.
+	// mxMalloc'd memory is released by Matlab even on an error.
+	int numCols = int(colsData);
+	int numBlocks = (numCols + BLOCK_COLS - 1) / BLOCK_COLS;
+	int blockScratch = BLOCK_COLS * (2 * numObsv + 2) + 3 * numObsv;
+	double *scratch = (double*)mxMalloc(numBlocks * blockScratch * sizeof(double));
+	double *obsvIn = (double*)mxMalloc(numObsv * sizeof(double));
+
+	for (int kk = 0; kk < numObsv; kk++)
+	{
+		obsvIn[kk] = double(int(obsvPtr[kk]));
+	}
 
 	/////////////
 	// START
 	/////////////
 
-	// Calculate advances & declines
-	advances[0] = 0;
-	declines[0] = 0;
+	// Lookback kk of instrument mm is column (mm + kk * numCols)
+	int lookbackStride = int(rowsData) * numCols;
 
-	for (int ii=1;ii != rowsData; ii++)					// starting at one because we are doing a difference of the observation prior
+#pragma omp parallel for schedule(dynamic) if (numBlocks > 1)
+	for (int block = 0; block < numBlocks; block++)
 	{
-		if (barsInPtr[ii] - barsInPtr[ii-1] > 0)
-		{
-			advances[ii] = abs(barsInPtr[ii] - barsInPtr[ii-1]);
-			declines[ii] = 0;
-		}
-		else
-		{
-			advances[ii] = 0;
-			declines[ii] = abs(barsInPtr[ii] - barsInPtr[ii-1]);
-		}
-	}
-
-	// Calculate avgGains & avgLosses
-	// Note: these are not averages in the formal sense
-	for (int ii = (obsvIn); ii != rowsData; ii++)
-	{
-		if (ii == (obsvIn))
-		{
-			double sumAdv = 0;
-			double sumDec = 0;
-
-			for (int jj = 0; jj != obsvIn; jj++)
-			{
-				sumAdv = sumAdv + advances[ii-jj];
-				sumDec = sumDec + declines[ii-jj];
-			}
-
-			avgGain[ii] = sumAdv / obsvIn;
-			avgLoss[ii] = sumDec / obsvIn;
-		}
-		else
-		{
-			avgGain[ii] = ((avgGain[ii-1] * (obsvIn - 1)) + advances[ii]) / obsvIn;
-			avgLoss[ii] = ((avgLoss[ii-1] * (obsvIn - 1)) + declines[ii]) / obsvIn;
-		}
-	}
+		int firstCol = block * BLOCK_COLS;
+		int blockCols = (numCols - firstCol < BLOCK_COLS) ? numCols - firstCol : BLOCK_COLS;
 
-	// Assign RSI values to output array
-	for (int ii = 0; ii != rowsData; ii++)
-	{
-		if (ii < (obsvIn))
-		{
-			RSI[ii] = m_Nan;
-		}
-		else
-		{
-			if (avgLoss[ii] == 0)
-			{
-				RSI[ii] = 100;
-			}
-			else
-			{
-				RSI[ii] = 100 - (100 / (1 + avgGain[ii] / avgLoss[ii]));
-			}
-		}
+		rsiKernel(barsInPtr + firstCol * rowsData, int(rowsData), blockCols, obsvIn, numObsv, maxObsv,
+			scratch + block * blockScratch, RSI + firstCol * rowsData, lookbackStride);
 	}
 
-	delete []advances;
-	delete []declines;
-	delete []avgGain;
-	delete []avgLoss;
-
-	advances = NULL;
-	declines = NULL;
-	avgGain = NULL;
-	avgLoss = NULL;
+	mxFree(scratch);
+	mxFree(obsvIn);
 
 	/////////////
 	// FINISHED
@@ -0,0 +1,226 @@
+// remEchos.cpp
+// Localized mex'ing: mex COMPFLAGS="$COMPFLAGS /openmp" remEchos.cpp -output remEchos_mex
+//		(OpenMP is optional.  Without it columns are processed serially.)
+//
+// Native replacement for the coder build of remEchos.m (remEchos_mex).
+//
+// Transforms a STATE into a SIGNAL by zeroing every repeat of the active (last non-zero) value.
+//		in	[1 1 1 1 1 1 -1 -1 -1 -1 -1 1 1 1 1]	<-- STATE INPUT
+//		out	[1 0 0 0 0 0 -1  0  0  0  0 1 0 0 0]	<-- SIGNAL OUTPUT
+//
+//	NOTE:	Where the previous observation is non-zero it is the active signal, so an echo is simply equal to
+//			its predecessor.  Columns are scanned in blocks of SCAN_BLOCK observations.  A block which holds no
+//			zeros (the usual case for a STATE) is a compare-and-mask of each observation against its
+//			predecessor with no loop carried dependency, which the compiler vectorizes.  Blocks holding zeros
+//			fall back to the scalar scan of remEchos.m.
+//
+// nlhs Number of output variables nargout 
+// plhs Array of mxArray pointers to the output variables varargout
+// nrhs Number of input variables nargin
+// prhs Array of mxArray pointers to the input variables varargin
+//
+// Matlab function:
+// cleanS = remEchos_mex(s)
+// 
+// Inputs:
+//		s			An N x K array of STATES, one column per vector
+//
+// Outputs:
+//		cleanS		The N x K SIGNAL array
+//
+
+#include "mex.h"
+
+using namespace std;
+
+// Macros
+#define isReal2DfullDouble(P) (!mxIsComplex(P) && mxGetNumberOfDimensions(P) == 2 && !mxIsSparse(P) && mxIsDouble(P))
+
+// Observations per compare-and-mask block
+#define SCAN_BLOCK	8
+
+// Prototypes
+void remEchosKernel(const double *s, int rows, double *cleanS);
+
+void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
+				 int nrhs, const mxArray *prhs[]) /* Input variables */
+{
+	// Check number of inputs
+	if (nrhs != 1)
+		mexErrMsgIdAndTxt( "MATLAB:remEchos:NumInputs",
+		"Number of input arguments is not correct. Aborting.");
+
+	if (nlhs > 1)
+		mexErrMsgIdAndTxt( "MATLAB:remEchos:NumOutputs",
+		"Number of output assignments is not correct. Aborting.");
+
+	// Define constants (#define assigns a variable as either a constant or a macro)
+	// Inputs
+#define s_IN		prhs[0]
+
+	// Outputs
+#define cleanS_OUT	plhs[0]
+
+	// Check type of supplied inputs
+	if (!isReal2DfullDouble(s_IN)) 
+		mexErrMsgIdAndTxt( "MATLAB:remEchos:BadInputType",
+		"Input 's' must be a 2 dimensional full double array. Aborting.");
+
+	int rows = int(mxGetM(s_IN));
+	int cols = int(mxGetN(s_IN));
+
+	/* Assign pointers to the input array */ 
+	double *sPtr = mxGetPr(s_IN);
+
+	/* Create matrices for the return arguments */ 
+	cleanS_OUT = mxCreateDoubleMatrix(rows, cols, mxREAL);
+	double *cleanSPtr = mxGetPr(cleanS_OUT);
+
+	/////////////
+	// START
+	/////////////
+
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+	for (int col = 0; col < cols; col++)
+	{
+		remEchosKernel(sPtr + col * rows, rows, cleanSPtr + col * rows);
+	}
+
+	/////////////
+	// FINISHED
+	/////////////
+
+	return;
+}
+
+/////////////
+//
+// FUNCTIONS & METHODS
+//
+/////////////
+
+// One column
+void remEchosKernel(const double *s, int rows, double *cleanS)
+{
+	if (rows == 0)
+		return;
+
+	// Active signal starts at the first position
+	double actSig = s[0];
+	cleanS[0] = s[0];
+
+	// blk[0] is the (original) observation preceding the block
+	double blk[SCAN_BLOCK + 1];
+	blk[0] = s[0];
+
+	int ii = 1;
+	while (ii < rows)
+	{
+		int len = rows - ii;
+		if (len > SCAN_BLOCK) len = SCAN_BLOCK;
+
+		// Read the block before anything in it is written
+		for (int jj = 0; jj < len; jj++)
+		{
+			blk[jj + 1] = s[ii + jj];
+		}
+
+		int zeros = 0;
+		if (len == SCAN_BLOCK)
+		{
+			for (int jj = 0; jj <= SCAN_BLOCK; jj++)
+			{
+				zeros += (blk[jj] == 0);
+			}
+		}
+
+		if (len == SCAN_BLOCK && zeros == 0)
+		{
+			// Every predecessor is the active signal: compare-and-mask
+			double masked[SCAN_BLOCK];
+			for (int jj = 0; jj < SCAN_BLOCK; jj++)
+			{
+				masked[jj] = (blk[jj + 1] == blk[jj]) ? 0.0 : blk[jj + 1];
+			}
+			for (int jj = 0; jj < SCAN_BLOCK; jj++)
+			{
+				cleanS[ii + jj] = masked[jj];
+			}
+			actSig = blk[SCAN_BLOCK];
+		}
+		else
+		{
+			for (int jj = 0; jj < len; jj++)
+			{
+				double x = blk[jj + 1];
+				if (x == actSig)				// If the next line is the same, it is an echo. Zero it out.
+				{
+					cleanS[ii + jj] = 0;
+				}
+				else
+				{
+					cleanS[ii + jj] = x;
+					if (x != 0)				// Zeros are not new signals
+						actSig = x;
+				}
+			}
+		}
+
+		blk[0] = blk[len];
+		ii = ii + len;
+	}
+}
+//
+//  -------------------------------------------------------------------------
+//                                  _    _ 
+//         ___  _ __   ___ _ __    / \  | | __ _  ___   ___  _ __ __ _ 
+//        / _ \| '_ \ / _ \ '_ \  / _ \ | |/ _` |/ _ \ / _ \| '__/ _` |
+//       | (_) | |_) |  __/ | | |/ ___ \| | (_| | (_) | (_) | | | (_| |
+//        \___/| .__/ \___|_| |_/_/   \_\_|\__, |\___(_)___/|_|  \__, |
+//             |_|                         |___/                 |___/
+//  -------------------------------------------------------------------------
+//        This code is distributed in the hope that it will be useful,
+//
+//                      	   WITHOUT ANY WARRANTY
+//
+//                  WITHOUT CLAIM AS TO MERCHANTABILITY
+//
+//                  OR FITNESS FOR A PARTICULAR PURPOSE
+//
+//                          expressed or implied.
+//
+//   Use of this code, pseudocode, algorithmic or trading logic contained
+//   herein, whether sound or faulty for any purpose is the sole
+//   responsibility of the USER. Any such use of these algorithms, coding
+//   logic or concepts in whole or in part carry no covenant of correctness
+//   or recommended usage from the AUTHOR or any of the possible
+//   contributors listed or unlisted, known or unknown.
+//
+//   Any reference of this code or to this code including any variants from
+//   this code, or any other credits due this AUTHOR from this code shall be
+//   clearly and unambiguously cited and evident during any use, whether in
+//   whole or in part.
+//
+//   The public sharing of this code does not relinquish, reduce, restrict or
+//   encumber any rights the AUTHOR has in respect to claims of intellectual
+//   property.
+//
+//   IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY
+//   DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+//   OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+//   STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//   ANY WAY OUT OF THE USE OF THIS SOFTWARE, CODE, OR CODE FRAGMENT(S), EVEN
+//   IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//   -------------------------------------------------------------------------
+//
+//                             ALL RIGHTS RESERVED
+//
+//   -------------------------------------------------------------------------
+//
+//   Author:	Mark Tompkins
+//   Revision:	4906.24976
+//   Copyright:	(c)2013
+//
\ No newline at end of file
@@ -0,0 +1,292 @@
+// sigSharpe.cpp
+// Localized mex'ing: mex COMPFLAGS="$COMPFLAGS /openmp" sigSharpe.cpp myMath.cpp plEngine.cpp
+//		(OpenMP is optional.  Without it multiple state columns are processed serially.)
+//
+// nlhs Number of output variables nargout 
+// plhs Array of mxArray pointers to the output variables varargout
+// nrhs Number of input variables nargin
+// prhs Array of mxArray pointers to the input variables varargin
+//
+// Matlab function:
+// SH = sigSharpe(data,STA,bigPoint,cost,scaling)
+// SH = sigSharpe(data,STA,bigPoint,cost,scaling,warmUp)
+//
+// The SIGnal functions (e.g. ma2inputsSIG, wprSIG) finish with the same chain of calls:
+//
+//		SIG(STA < 0) = -1.5;
+//		SIG(STA > 0) =  1.5;
+//		SIG(1:warmUp) = 0;
+//		SIG = remEchos_mex(SIG);
+//		[~,~,~,R] = calcProfitLoss([fOpen fClose],SIG,bigPoint,cost);
+//		SH = scaling*sharpe(R,0);
+//
+// sigSharpe performs the chain in a single streaming pass over the observations.  No intermediate
+// arrays are created.  The signal mapping and echo removal are applied as each observation is read,
+// P&L is calculated with the same plEngine used by calcProfitLoss, and the returns are accumulated
+// in a running mean and variance.  When no signal is generated SH is 0 as in the SIGnal functions.
+// 
+// Inputs:
+//		data		A 2-D array of prices in the form of Open | Close or Open | High | Low | Close
+//		STA			A state array the same length as data.  Negative is short, positive is long and zero is no state.
+//					May be an N x K matrix where each column is an independent state (e.g. a parametric sweep).
+//		bigPoint	Double representing the full tick dollar value of the contract being P&L'd
+//		cost		Double representing the per contract commission
+//		scaling		Double Sharpe ratio adjuster
+//		warmUp		(optional) Number of leading observations where the signal is cleared (e.g. S-1 in ma2inputsSIG).
+//					A scalar or one value per column of STA.  Default is 0.
+//
+// Outputs:
+//		SH			A 1 x K array of scaled Sharpe ratios, one per column of STA
+//
+
+#include "mex.h"
+#include <cmath>
+#include "myMath.h"
+#include "plEngine.h"
+
+using namespace std;
+
+// Prototypes
+double calcColumnSharpe(const double *openPtr, const double *closePtr, const double *staInPtr, int rowsData, int warmUp,
+						double BIG_POINT, double COST, double SCALING);
+
+// Macros
+#define isReal2DfullDouble(P) (!mxIsComplex(P) && mxGetNumberOfDimensions(P) == 2 && !mxIsSparse(P) && mxIsDouble(P))
+#define isRealScalar(P) (isReal2DfullDouble(P) && mxGetNumberOfElements(P) == 1)
+#define codeLine	__LINE__	// help error trapping in MatLab
+
+void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
+				 int nrhs, const mxArray *prhs[]) /* Input variables */
+{
+	// Check number of inputs
+	if (nrhs != 5 && nrhs != 6)
+		mexErrMsgIdAndTxt( "MATLAB:sigSharpe:NumInputs",
+		"Number of input arguments is not correct. Aborting (%d).", codeLine);
+
+	if (nlhs > 1)
+		mexErrMsgIdAndTxt( "MATLAB:sigSharpe:NumOutputs",
+		"Number of output assignments is not correct. Aborting (%d).", codeLine);
+
+	// Define constants (#define assigns a variable as either a constant or a macro)
+	// Inputs
+#define data_IN		prhs[0]
+#define sta_IN		prhs[1]
+#define bigPoint_IN	prhs[2]
+#define cost_IN		prhs[3]
+#define scaling_IN	prhs[4]
+#define warmUp_IN	prhs[5]
+	// Outputs
+#define sharpe_OUT	plhs[0]
+
+	// Check type of supplied inputs
+	if (!isReal2DfullDouble(data_IN))
+		mexErrMsgIdAndTxt( "MATLAB:sigSharpe:BadInputType",
+		"Input 'data' must be a 2 dimensional full double array. Aborting (%d).", codeLine);
+
+	if (!isReal2DfullDouble(sta_IN))
+		mexErrMsgIdAndTxt( "MATLAB:sigSharpe:BadInputType",
+		"Input 'STA' must be a 2 dimensional full double array. Aborting (%d).", codeLine);
+
+	if (!isRealScalar(bigPoint_IN) || !isRealScalar(cost_IN) || !isRealScalar(scaling_IN))
+		mexErrMsgIdAndTxt( "MATLAB:sigSharpe:BadInputType",
+		"Inputs 'bigPoint', 'cost' and 'scaling' must be single scalar doubles. Aborting (%d).", codeLine);
+
+	if (nrhs == 6 && !isReal2DfullDouble(warmUp_IN))
+		mexErrMsgIdAndTxt( "MATLAB:sigSharpe:BadInputType",
+		"Input 'warmUp' must be a full double scalar or vector. Aborting (%d).", codeLine);
+
+	// Assign variables
+	const mwSize rowsData = mxGetM(data_IN);
+	const mwSize colsData = mxGetN(data_IN);
+	const mwSize colsSta = mxGetN(sta_IN);
+	const mwSize numWarmUp = (nrhs == 6) ? mxGetNumberOfElements(warmUp_IN) : 0;
+
+	if (mxGetM(sta_IN) != rowsData)
+		mexErrMsgIdAndTxt( "MATLAB:sigSharpe:ArrayMismatch",
+		"The number of rows in the data array and the state array are different. Aborting (%d).", codeLine);
+
+	if (colsData != 2 && colsData != 4)
+		mexErrMsgIdAndTxt( "MATLAB:sigSharpe:ArrayMismatch",
+		"Input 'data' must be in the form of 'O | C' or 'O | H | L | C'. Aborting (%d).", codeLine);
+
+	if (nrhs == 6 && numWarmUp != 1 && numWarmUp != colsSta)
+		mexErrMsgIdAndTxt( "MATLAB:sigSharpe:ArrayMismatch",
+		"Input 'warmUp' must be a scalar or have one element per column of 'STA'. Aborting (%d).", codeLine);
+
+	const double BIG_POINT = mxGetScalar(bigPoint_IN);
+	const double COST = mxGetScalar(cost_IN);
+	const double SCALING = mxGetScalar(scaling_IN);
+
+	/* Assign pointers to the arrays */
+	const double *dataInPtr = mxGetPr(data_IN);
+	const double *staInPtr = mxGetPr(sta_IN);
+	const double *warmUpPtr = (nrhs == 6) ? mxGetPr(warmUp_IN) : NULL;
+
+	// Close is the last column
+	const mwSize SHIFT_CLOSE = rowsData * (colsData - 1);
+
+	sharpe_OUT = mxCreateDoubleMatrix(1, colsSta, mxREAL);
+	double *sharpeIdx = mxGetPr(sharpe_OUT);
+
+	// START //
+	// Each state column is independent and distributed across cores when compiled with OpenMP
+	const int numCols = (int)colsSta;
+
+#pragma omp parallel for schedule(dynamic) if (numCols > 1)
+	for (int col = 0; col < numCols; col++)
+	{
+		int warmUp = (warmUpPtr == NULL) ? 0 : (int)warmUpPtr[numWarmUp == 1 ? 0 : col];
+		sharpeIdx[col] = calcColumnSharpe(dataInPtr, dataInPtr + SHIFT_CLOSE, staInPtr + (mwSize)col * rowsData, (int)rowsData,
+			warmUp, BIG_POINT, COST, SCALING);
+	}
+
+	return;
+}
+
+/////////////
+//
+// FUNCTIONS & METHODS
+//
+/////////////
+
+// State --> signal --> remEchos --> P&L --> Sharpe for a single state column in one pass.
+// Memory is constant; with +/- 1.5 signals the ledger never holds more than one line item.
+// Does not call back into Matlab so it is safe to run concurrently on separate columns.
+double calcColumnSharpe(const double *openPtr, const double *closePtr, const double *staInPtr, int rowsData, int warmUp,
+						double BIG_POINT, double COST, double SCALING)
+{
+	plEngine engine(BIG_POINT, COST);
+	double badSig;						// Reversals are always known advanced signals
+	double cash, openEQ, netLiq, returns;
+
+	double actSig = 0;					// Active signal for echo removal
+	bool anySig = false;
+
+	// Running mean and variance of the returns (Welford)
+	int numRet = 0;
+	double meanRet = 0;
+	double sumSqDev = 0;
+
+	for (int ii = 0; ii < rowsData; ii++)
+	{
+		// State to signal
+		double sig = 0;
+		if (ii >= warmUp)
+		{
+			if (staInPtr[ii] < 0)
+			{
+				sig = -1.5;
+			}
+			else if (staInPtr[ii] > 0)
+			{
+				sig = 1.5;
+			}
+		}
+
+		// Remove echos.  The first observation sets the active signal.
+		if (ii == 0)
+		{
+			actSig = sig;
+		}
+		else if (sig == actSig)
+		{
+			sig = 0;
+		}
+		else if (sig != 0)
+		{
+			actSig = sig;
+		}
+
+		if (sig != 0)
+		{
+			anySig = true;
+		}
+
+		engine.addBar(openPtr[ii], closePtr[ii], sig, badSig);
+
+		// The prior observation's return is final once the current observation is added
+		if (ii > 0)
+		{
+			engine.getBar(plEngine::PRIOR, cash, openEQ, netLiq, returns);
+
+			numRet++;
+			double delta = returns - meanRet;
+			meanRet = meanRet + delta / numRet;
+			sumSqDev = sumSqDev + delta * (returns - meanRet);
+		}
+	}
+
+	// No signals - no sharpe
+	if (!anySig)
+	{
+		return 0;
+	}
+
+	// The last observation is final at the end of the data
+	engine.getBar(plEngine::CURRENT, cash, openEQ, netLiq, returns);
+
+	numRet++;
+	double delta = returns - meanRet;
+	meanRet = meanRet + delta / numRet;
+	sumSqDev = sumSqDev + delta * (returns - meanRet);
+
+	// sharpe(R,0) = mean(R) / std(R) with std normalized by N-1
+	double stdRet = numRet > 1 ? sqrt(sumSqDev / (numRet - 1)) : 0;
+
+	return SCALING * (meanRet / stdRet);
+}
+
+//
+//  -------------------------------------------------------------------------
+//                                  _    _ 
+//         ___  _ __   ___ _ __    / \  | | __ _  ___   ___  _ __ __ _ 
+//        / _ \| '_ \ / _ \ '_ \  / _ \ | |/ _` |/ _ \ / _ \| '__/ _` |
+//       | (_) | |_) |  __/ | | |/ ___ \| | (_| | (_) | (_) | | | (_| |
+//        \___/| .__/ \___|_| |_/_/   \_\_|\__, |\___(_)___/|_|  \__, |
+//             |_|                         |___/                 |___/
+//  -------------------------------------------------------------------------
+//        This code is distributed in the hope that it will be useful,
+//
+//                      	   WITHOUT ANY WARRANTY
+//
+//                  WITHOUT CLAIM AS TO MERCHANTABILITY
+//
+//                  OR FITNESS FOR A PARTICULAR PURPOSE
+//
+//                          expressed or implied.
+//
+//   Use of this code, pseudocode, algorithmic or trading logic contained
+//   herein, whether sound or faulty for any purpose is the sole
+//   responsibility of the USER. Any such use of these algorithms, coding
+//   logic or concepts in whole or in part carry no covenant of correctness
+//   or recommended usage from the AUTHOR or any of the possible
+//   contributors listed or unlisted, known or unknown.
+//
+//   Any reference of this code or to this code including any variants from
+//   this code, or any other credits due this AUTHOR from this code shall be
+//   clearly and unambiguously cited and evident during any use, whether in
+//   whole or in part.
+//
+//   The public sharing of this code does not relinquish, reduce, restrict or
+//   encumber any rights the AUTHOR has in respect to claims of intellectual
+//   property.
+//
+//   IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY
+//   DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+//   OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+//   STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//   ANY WAY OUT OF THE USE OF THIS SOFTWARE, CODE, OR CODE FRAGMENT(S), EVEN
+//   IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//   -------------------------------------------------------------------------
+//
+//                             ALL RIGHTS RESERVED
+//
+//   -------------------------------------------------------------------------
+//
+//   Author:	Mark Tompkins
+//   Revision:	4906.24976
+//   Copyright:	(c)2013
+//
\ No newline at end of file
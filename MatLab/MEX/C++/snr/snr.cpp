@@ -0,0 +1,279 @@
+// snr.cpp
+// Localized mex'ing: mex snr.cpp -output snr_mex
+//
+// Native replacement for the coder build of snr.m (snr_mex).  Results match snr.m exactly.
+//
+// Signal-to-Noise ratio after John Ehlers.  The noise is the smoothed range of the bars and the signal is the
+// smoothed amplitude of the Hilbert transform (inPhase, quad) of the detrended midpoint price.
+//
+//	NOTE:	snr.m copies the price with OHLCSplitter and makes four passes over full length arrays.  This kernel
+//			reads H and L in place and runs every recursion in one fused pass with O(1) state.
+//			Given vectors of multipliers value1 and range are computed once, inPhase once per iMult and quad
+//			once per qMult.  Only the amplitude is computed per (iMult, qMult) pair.
+//
+// nlhs Number of output variables nargout 
+// plhs Array of mxArray pointers to the output variables varargout
+// nrhs Number of input variables nargin
+// prhs Array of mxArray pointers to the input variables varargin
+//
+// Matlab function:
+// amp = snr_mex(price, iMult, qMult)
+// 
+// Inputs:
+//		price		O | H | L | C with a minimum of 8 observations
+//		iMult		In-phase multiplier (default 0.635), or a vector of KI multipliers
+//		qMult		Quadrature multiplier (default 0.338), or a vector of KQ multipliers
+//
+// Outputs:
+//		amp			The Signal-to-Noise ratio in decibels.  Given vectors an N x (KI * KQ) array with iMult varying
+//					fastest: column k is iMult(mod(k-1,KI)+1), qMult(floor((k-1)/KI)+1)
+//
+
+#include "mex.h"
+#include <cmath>
+
+using namespace std;
+
+// Macros
+#define isReal2DfullDouble(P) (!mxIsComplex(P) && mxGetNumberOfDimensions(P) == 2 && !mxIsSparse(P) && mxIsDouble(P))
+#define isRealVector(P) (isReal2DfullDouble(P) && mxGetNumberOfElements(P) > 0 && (mxGetM(P) == 1 || mxGetN(P) == 1))
+
+// Recursion history (powers of 2 so the index is masked)
+#define VALUE_RING	8
+#define HILBERT_RING	4
+
+// Prototypes
+void snrKernel(const double *highPtr, const double *lowPtr, int rows, const double *iMult, int numI,
+	const double *qMult, int numQ, double *scratch, double *amp);
+
+void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
+				 int nrhs, const mxArray *prhs[]) /* Input variables */
+{
+	// Check number of inputs
+	if (nrhs < 1 || nrhs > 3)
+		mexErrMsgIdAndTxt( "MATLAB:snr:NumInputs",
+		"Number of input arguments is not correct. Aborting.");
+
+	if (nlhs > 1)
+		mexErrMsgIdAndTxt( "MATLAB:snr:NumOutputs",
+		"Number of output assignments is not correct. Aborting.");
+
+	// Define constants (#define assigns a variable as either a constant or a macro)
+	// Inputs
+#define price_IN	prhs[0]
+#define iMult_IN	prhs[1]
+#define qMult_IN	prhs[2]
+
+	// Outputs
+#define amp_OUT		plhs[0]
+
+	// Check type of supplied inputs
+	if (!isReal2DfullDouble(price_IN) || mxGetN(price_IN) != 4) 
+		mexErrMsgIdAndTxt( "MATLAB:snr:BadInputType",
+		"Input 'price' must be a full double array of O | H | L | C. Aborting.");
+
+	int rows = int(mxGetM(price_IN));
+
+	if (rows < 8)
+		mexErrMsgIdAndTxt( "snr:dataSizeFailure",
+		"snr requires a minimum of 8 observations. Exiting.");
+
+	double iDefault = .635, qDefault = .338;
+	const double *iMult = &iDefault, *qMult = &qDefault;
+	int numI = 1, numQ = 1;
+
+	if (nrhs > 1)
+	{
+		if (!isRealVector(iMult_IN))
+			mexErrMsgIdAndTxt( "MATLAB:snr:BadInputType",
+			"Input 'iMult' must be a scalar or a vector. Aborting.");
+		iMult = mxGetPr(iMult_IN);
+		numI = int(mxGetNumberOfElements(iMult_IN));
+	}
+
+	if (nrhs > 2)
+	{
+		if (!isRealVector(qMult_IN))
+			mexErrMsgIdAndTxt( "MATLAB:snr:BadInputType",
+			"Input 'qMult' must be a scalar or a vector. Aborting.");
+		qMult = mxGetPr(qMult_IN);
+		numQ = int(mxGetNumberOfElements(qMult_IN));
+	}
+
+	/* Assign pointers to the input array */ 
+	double *pricePtr = mxGetPr(price_IN);
+
+	/* Create matrices for the return arguments */ 
+	amp_OUT = mxCreateDoubleMatrix(rows, numI * numQ, mxREAL);
+
+	// Scratch is the recursion state: HILBERT_RING values of inPhase per iMult and of quad per qMult,
+	// value2 and amp per pair.  mxMalloc'd memory is released by Matlab even on an error.
+	double *scratch = (double*)mxMalloc((HILBERT_RING * (numI + numQ) + 2 * numI * numQ) * sizeof(double));
+
+	/////////////
+	// START
+	/////////////
+
+	snrKernel(pricePtr + rows, pricePtr + 2 * rows, rows, iMult, numI, qMult, numQ, scratch, mxGetPr(amp_OUT));
+
+	mxFree(scratch);
+
+	/////////////
+	// FINISHED
+	/////////////
+
+	return;
+}
+
+/////////////
+//
+// FUNCTIONS & METHODS
+//
+/////////////
+
+// All recursions of snr.m in one forward pass.  Expressions are evaluated in the same order as snr.m so that
+// the results are identical.  Indices are 0 based (ii here is ii - 1 in snr.m).
+// Pair (ki, kq) is written to amp[ii + (kq * numI + ki) * rows].
+void snrKernel(const double *highPtr, const double *lowPtr, int rows, const double *iMult, int numI,
+	const double *qMult, int numQ, double *scratch, double *amp)
+{
+	int numPairs = numI * numQ;
+
+	// inPhase of iMult ki at bar ii is inPhase[ki * HILBERT_RING + (ii & (HILBERT_RING - 1))].  Likewise quad.
+	double *inPhase = scratch;
+	double *quad = inPhase + HILBERT_RING * numI;
+	double *value2 = quad + HILBERT_RING * numQ;
+	double *ampLast = value2 + numPairs;
+
+	for (int state = 0; state < HILBERT_RING * (numI + numQ) + 2 * numPairs; state++)
+	{
+		scratch[state] = 0;
+	}
+
+	double value1[VALUE_RING] = {0};
+	double range = 0;
+	const double log10Base = log(10.0);
+
+	// The first bar is 0 for every pair
+	for (int kk = 0; kk < numPairs; kk++)
+	{
+		amp[kk * rows] = 0;
+	}
+
+	for (int ii = 1; ii < rows; ii++)
+	{
+		// {Compute "Noise" as the average range}
+		// {Detrend Price}
+		double v1 = 0;
+		if (ii >= 7)
+		{
+			v1 = (highPtr[ii] + lowPtr[ii]) / 2 - (highPtr[ii - 7] + lowPtr[ii - 7]) / 2;
+		}
+		value1[ii & (VALUE_RING - 1)] = v1;
+		range = .2 * (highPtr[ii] - lowPtr[ii]) + .8 * range;
+
+		int slot = ii & (HILBERT_RING - 1);
+
+		// {Compute Hilbert Transform outputs}
+		if (ii >= 4)
+		{
+			double v1Lag2 = value1[(ii - 2) & (VALUE_RING - 1)];
+			double v1Lag4 = value1[(ii - 4) & (VALUE_RING - 1)];
+
+			for (int ki = 0; ki < numI; ki++)
+			{
+				double *inPhaseK = inPhase + ki * HILBERT_RING;
+				inPhaseK[slot] = 1.25 * v1Lag4 - iMult[ki] * v1Lag2 + iMult[ki] * inPhaseK[(ii - 3) & (HILBERT_RING - 1)];
+			}
+
+			for (int kq = 0; kq < numQ; kq++)
+			{
+				double *quadK = quad + kq * HILBERT_RING;
+				quadK[slot] = v1Lag2 - qMult[kq] * v1 + qMult[kq] * quadK[(ii - 2) & (HILBERT_RING - 1)];
+			}
+		}
+
+		// {Compute smoothed signal amplitude}
+		double rangeSq = range * range;
+
+		for (int kq = 0; kq < numQ; kq++)
+		{
+			double q = quad[kq * HILBERT_RING + slot];
+
+			for (int ki = 0; ki < numI; ki++)
+			{
+				int pair = kq * numI + ki;
+				double i = inPhase[ki * HILBERT_RING + slot];
+
+				double v2 = .2 * (i * i + q * q) + .8 * value2[pair];
+				// Prevent a divide by 0
+				if (v2 < .001) v2 = .001;
+				value2[pair] = v2;
+
+				// {Compute smoothed SNR in Decibels, guarding against a divide by zero error, and compensating for filter loss}
+				double a = 0;
+				if (range > 0)
+				{
+					a = .25 * (10 * log(v2 / rangeSq) / log10Base + 1.9) + .75 * ampLast[pair];
+					if (a < 0) a = 0;
+				}
+				ampLast[pair] = a;
+				amp[ii + pair * rows] = a;
+			}
+		}
+	}
+}
+//
+//  -------------------------------------------------------------------------
+//                                  _    _ 
+//         ___  _ __   ___ _ __    / \  | | __ _  ___   ___  _ __ __ _ 
+//        / _ \| '_ \ / _ \ '_ \  / _ \ | |/ _` |/ _ \ / _ \| '__/ _` |
+//       | (_) | |_) |  __/ | | |/ ___ \| | (_| | (_) | (_) | | | (_| |
+//        \___/| .__/ \___|_| |_/_/   \_\_|\__, |\___(_)___/|_|  \__, |
+//             |_|                         |___/                 |___/
+//  -------------------------------------------------------------------------
+//        This code is distributed in the hope that it will be useful,
+//
+//                      	   WITHOUT ANY WARRANTY
+//
+//                  WITHOUT CLAIM AS TO MERCHANTABILITY
+//
+//                  OR FITNESS FOR A PARTICULAR PURPOSE
+//
+//                          expressed or implied.
+//
+//   Use of this code, pseudocode, algorithmic or trading logic contained
+//   herein, whether sound or faulty for any purpose is the sole
+//   responsibility of the USER. Any such use of these algorithms, coding
+//   logic or concepts in whole or in part carry no covenant of correctness
+//   or recommended usage from the AUTHOR or any of the possible
+//   contributors listed or unlisted, known or unknown.
+//
+//   Any reference of this code or to this code including any variants from
+//   this code, or any other credits due this AUTHOR from this code shall be
+//   clearly and unambiguously cited and evident during any use, whether in
+//   whole or in part.
+//
+//   The public sharing of this code does not relinquish, reduce, restrict or
+//   encumber any rights the AUTHOR has in respect to claims of intellectual
+//   property.
+//
+//   IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY
+//   DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+//   DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+//   OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+//   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+//   STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+//   ANY WAY OUT OF THE USE OF THIS SOFTWARE, CODE, OR CODE FRAGMENT(S), EVEN
+//   IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//   -------------------------------------------------------------------------
+//
+//                             ALL RIGHTS RESERVED
+//
+//   -------------------------------------------------------------------------
+//
+//   Author:	Mark Tompkins
+//   Revision:	4906.24976
+//   Copyright:	(c)2013
+//
\ No newline at end of file
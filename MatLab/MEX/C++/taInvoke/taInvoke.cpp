@@ -1,21 +1,31 @@
 ﻿// taInvoke.cpp
-// Localized mex'ing: mex taInvoke.cpp @mexOpts.txt
+// Localized mex'ing: mex COMPFLAGS="$COMPFLAGS /openmp" taInvoke.cpp @mexOpts.txt
+//		(OpenMP is optional.  Without it instruments are processed serially.)
 // Matlab function: 
 //			taInvoke()										This will return a list of available TA-LIB functions to the MatLab command window
 //			[varout] = taInvoke(taFunction, varin)
+//			h = taInvoke('@resolve', taFunction)			Resolve a function name to a handle once
+//			[varout] = taInvoke(h, varin)					Call through a handle.  No string is parsed.
+//			[out1, ...] = taInvoke('@pipeline', data, stages)	Chain single series functions natively (see taPipeline)
 //
 // Inputs:
-//		taFunction	The name of the TA-Lib function to call
+//		taFunction	The name of the TA-Lib function to call, or a handle returned by '@resolve'
 //		varin		The input variable(s) as necessary for the called taFunction
+//					Series inputs (e.g. H | L | C) may be N x M matrices with one column per instrument.
+//					Columns are processed in parallel when compiled with OpenMP.
 //
 // Outputs:
 //		varout		The output(s) as produced from the call to the taFunction
+//					Each output has the same N x M shape as the series inputs.
+//					Functions taking a single lookback (e.g. SMA, RSI, MA, STDDEV) also accept a vector of K
+//					lookbacks, returning N x K (or N x M x K).
 
 #include "mex.h"
 #include "ta_libc.h"
-#include <map>
 #include <algorithm>	// So we can transform the function name string input ...
 #include <string>		// from char to string ensuring lowercase
+#include <cstring>
+#include <cmath>
 #include "myMath.h"
 
 using namespace std;
@@ -40,22 +50,62 @@ static enum StringValue { taNotDefined, ta_accbands, ta_acos, ta_ad, ta_add, ta_
 							ta_sin, ta_sinh, ta_sma, ta_sqrt, ta_stddev, ta_stoch, ta_stochf, ta_stochrsi, ta_sub, ta_sum, ta_t3, ta_tan, ta_tanh, ta_tema, ta_trange, ta_trima, ta_trix, 
 							ta_tsf, ta_typprice, ta_ultosc, ta_var, ta_wclprice, ta_willr, ta_wma};
 
+// Function names indexed by StringValue.  Names are in the same (sorted) order as the enum so a name is
+// resolved by a binary search of a constant table and a handle is simply the enum value.
+static const char *taFuncNames[] = { "",
+	"ta_accbands", "ta_acos", "ta_ad", "ta_add", "ta_adosc", "ta_adx", "ta_adxr", "ta_apo",
+	"ta_aroon", "ta_aroonosc", "ta_asin", "ta_atan", "ta_atr", "ta_avgdev", "ta_avgprice", "ta_bbands",
+	"ta_beta", "ta_bop", "ta_cci", "ta_cdl2crows", "ta_cdl3blackcrows", "ta_cdl3inside", "ta_cdl3linestrike", "ta_cdl3outside",
+	"ta_cdl3starsinsouth", "ta_cdl3whitesoldiers", "ta_cdlabandonedbaby", "ta_cdladvanceblock", "ta_cdlbelthold", "ta_cdlbreakaway", "ta_cdlclosingmarubozu", "ta_cdlconcealbabyswall",
+	"ta_cdlcounterattack", "ta_cdldarkcloudcover", "ta_cdldoji", "ta_cdldojistar", "ta_cdldragonflydoji", "ta_cdlengulfing", "ta_cdleveningdojistar", "ta_cdleveningstar",
+	"ta_cdlgapsidesidewhite", "ta_cdlgravestonedoji", "ta_cdlhammer", "ta_cdlhangingman", "ta_cdlharami", "ta_cdlharamicross", "ta_cdlhighwave", "ta_cdlhikkake",
+	"ta_cdlhikkakemod", "ta_cdlhomingpigeon", "ta_cdlidentical3crows", "ta_cdlinneck", "ta_cdlinvertedhammer", "ta_cdlkicking", "ta_cdlkickingbylength", "ta_cdlladderbottom",
+	"ta_cdllongleggeddoji", "ta_cdllongline", "ta_cdlmarubozu", "ta_cdlmatchinglow", "ta_cdlmathold", "ta_cdlmorningdojistar", "ta_cdlmorningstar", "ta_cdlonneck",
+	"ta_cdlpiercing", "ta_cdlrickshawman", "ta_cdlrisefall3methods", "ta_cdlseparatinglines", "ta_cdlshootingstar", "ta_cdlshortline", "ta_cdlspinningtop", "ta_cdlstalledpattern",
+	"ta_cdlsticksandwich", "ta_cdltakuri", "ta_cdltasukigap", "ta_cdlthrusting", "ta_cdltristar", "ta_cdlunique3river", "ta_cdlupsidegap2crows", "ta_cdlxsidegap3methods",
+	"ta_ceil", "ta_cmo", "ta_correl", "ta_cos", "ta_cosh", "ta_dema", "ta_div", "ta_dx",
+	"ta_ema", "ta_exp", "ta_floor", "ta_ht_dcperiod", "ta_ht_dcphase", "ta_ht_phasor", "ta_ht_sine", "ta_ht_trendline",
+	"ta_ht_trendmode", "ta_kama", "ta_linearreg", "ta_linearreg_angle", "ta_linearreg_intercept", "ta_linearreg_slope", "ta_ln", "ta_log10",
+	"ta_ma", "ta_macd", "ta_macdext", "ta_macdfix", "ta_mama", "ta_mavp", "ta_max", "ta_maxindex",
+	"ta_medprice", "ta_mfi", "ta_midpoint", "ta_midprice", "ta_min", "ta_minindex", "ta_minmax", "ta_minmaxindex",
+	"ta_minus_di", "ta_minus_dm", "ta_mom", "ta_mult", "ta_natr", "ta_obv", "ta_plus_di", "ta_plus_dm",
+	"ta_ppo", "ta_roc", "ta_rocp", "ta_rocr", "ta_rocr100", "ta_rsi", "ta_sar", "ta_sarext",
+	"ta_sin", "ta_sinh", "ta_sma", "ta_sqrt", "ta_stddev", "ta_stoch", "ta_stochf", "ta_stochrsi",
+	"ta_sub", "ta_sum", "ta_t3", "ta_tan", "ta_tanh", "ta_tema", "ta_trange", "ta_trima",
+	"ta_trix", "ta_tsf", "ta_typprice", "ta_ultosc", "ta_var", "ta_wclprice", "ta_willr", "ta_wma"};
+#define taNumFuncs	int(sizeof(taFuncNames) / sizeof(taFuncNames[0]))
+
 // Prototypes
-// Map to associate the strings with the enum values
-static map<string, StringValue> s_mapStringValues;
+static StringValue taResolve(const char *taFuncName);
 void taInvokeInfoOnly();
 void taInvokeFuncInfo(string taFuncNameIn);
-void chkSingleVec(int colsD, int lineNum);
-void chkSingleVec(int colsH, int colsL, int lineNum);
-void chkSingleVec(int colsH, int colsL, int colsC, int lineNum);
-void chkSingleVec(int colsO, int colsH, int colsL, int colsC, int lineNum);
+int chkSameCols(int colsA, int lineNum);
+int chkSameCols(int colsA, int colsB, int lineNum);
+int chkSameCols(int colsA, int colsB, int colsC, int lineNum);
+int chkSameCols(int colsA, int colsB, int colsC, int colsD, int lineNum);
 void printToMatLab(char *para1, char *form);
 void printToMatLab(char *para1, char *para2, char *form);
 void printToMatLab(char *para1, char *para2, char *para3, char *form);
 void printToMatLab(char *para1, char *para2, char *para3, char *para4, char *form);
 void typeMAcheck(string taFuncNameIn, string taFuncDesc, string taFuncOptName, int typeMA);
+double *taAllocOut(mxArray *&outArray, int rows, int cols, int lookback);
+int *taAllocIntOut(mxArray *&outArray, int rows, int cols, int lookback);
+void taColCode(TA_RetCode &retCode, TA_RetCode colCode);
+int taGetParams(const mxArray *paramIn, int *&params);
+double *taAllocGridOut(mxArray *&outArray, int rows, int cols, int numParams, const int *outBeg);
+void taRollSums(const double *data, int rows, int lookback, int rollType, double numDev, double *out);
+void taPipeline(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]);
+
+// TA-Lib functions of a single series and a lookback period
+typedef TA_RetCode (*taPeriodFunc)(int, int, const double[], int, int *, int *, double[]);
+typedef int (*taPeriodLookback)(int);
 
-static void InitSwitchMapping();
+// TA-Lib functions of a single series without parameters (vector transforms)
+typedef TA_RetCode (*taUnaryFunc)(int, int, const double[], int *, int *, double[]);
+typedef int (*taUnaryLookback)(void);
+
+// Statistics served by taRollSums
+enum taRollType { taRollSum, taRollMean, taRollVar, taRollStdDev };
 
 // Macros
 #define isReal2DfullDouble(P) (!mxIsComplex(P) && mxGetNumberOfDimensions(P) == 2 && !mxIsSparse(P) && mxIsDouble(P))
@@ -79,27 +129,75 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 	// Inputs
 	#define taFuncName_IN		prhs[0]
 
-	/* Assign pointers to the function string */ 
-	int funcNumChars = (int)mxGetN(taFuncName_IN)+1;	// +1 for the NULL added at the end
-	char *funcAsChars = (char*)mxCalloc(funcNumChars, sizeof(char));	// Allocate space on the heap to store the name
+	string taFuncNameIn;
+	string taFuncDesc;						// Descriptive name of function for user feedback
+	string taFuncOptName = "typeMA";		// Descriptive name for the optional input being validated (default to 'typeMA')
+	StringValue taFunc;
 
-	if (funcAsChars == NULL) mexErrMsgTxt("Not enough heap space to hold converted string.");
+	// Pre-resolved handle
+	if (!mxIsChar(taFuncName_IN))
+	{
+		if (!isRealScalar(taFuncName_IN))
+			mexErrMsgIdAndTxt("MATLAB:taInvoke:Parsing",
+			"The function must be given as a name or a handle from taInvoke('@resolve', name). Aborting (%d).", codeLine);
 
-	int status = mxGetString(taFuncName_IN, funcAsChars, funcNumChars); 
-	if (status != 0) mexErrMsgIdAndTxt("MATLAB:taInvoke:Parsing",
-						"Could not parse the given function. Aborting (%d).", codeLine);
+		int handle = (int)mxGetScalar(taFuncName_IN);
+		if (handle < 1 || handle >= taNumFuncs || handle != mxGetScalar(taFuncName_IN))
+			mexErrMsgIdAndTxt("MATLAB:taInvoke:Parsing",
+			"The function handle is not valid. Aborting (%d).", codeLine);
 
-	string taFuncNameIn((funcAsChars));
-	string taFuncDesc;						// Descriptive name of function for user feedback
-	string taFuncOptName = "typeMA";		// Descriptive name for the optional input being validated (default to 'typeMA')
+		taFunc = (StringValue)handle;
+		taFuncNameIn = taFuncNames[handle];
+	}
+	else
+	{
+		/* Assign pointers to the function string */ 
+		int funcNumChars = (int)mxGetN(taFuncName_IN)+1;	// +1 for the NULL added at the end
+		char *funcAsChars = (char*)mxCalloc(funcNumChars, sizeof(char));	// Allocate space on the heap to store the name
+
+		if (funcAsChars == NULL) mexErrMsgTxt("Not enough heap space to hold converted string.");
+
+		int status = mxGetString(taFuncName_IN, funcAsChars, funcNumChars); 
+		if (status != 0) mexErrMsgIdAndTxt("MATLAB:taInvoke:Parsing",
+							"Could not parse the given function. Aborting (%d).", codeLine);
 
-	transform(taFuncNameIn.begin(), taFuncNameIn.end(), taFuncNameIn.begin(), ::tolower);
+		taFuncNameIn = funcAsChars;
+
+		// Quick cleanup
+		mxFree(funcAsChars);
+
+		transform(taFuncNameIn.begin(), taFuncNameIn.end(), taFuncNameIn.begin(), ::tolower);
+
+		// Resolve a name to a handle that may be used in place of the name
+		if (taFuncNameIn.compare("@resolve") == 0)
+		{
+			if (nrhs != 2 || !mxIsChar(prhs[1]))
+				mexErrMsgIdAndTxt("MATLAB:taInvoke:Parsing",
+				"Usage is h = taInvoke('@resolve', 'ta_function'). Aborting (%d).", codeLine);
+
+			char *resolveAsChars = mxArrayToString(prhs[1]);
+			string resolveName(resolveAsChars);
+			mxFree(resolveAsChars);
+			transform(resolveName.begin(), resolveName.end(), resolveName.begin(), ::tolower);
+
+			StringValue handle = taResolve(resolveName.c_str());
+			if (handle == taNotDefined)
+				mexErrMsgIdAndTxt( "MATLAB:taInvoke:UnknownFunction",
+				"Unable to find a matching function to: '%s'. Aborting (%d).", resolveName.c_str(), codeLine);
+
+			plhs[0] = mxCreateDoubleScalar(handle);
+			return;
+		}
 
-	// Quick cleanup
-	mxFree(funcAsChars);
+		// Chained single series functions evaluated without returning intermediates to MatLab
+		if (taFuncNameIn.compare("@pipeline") == 0)
+		{
+			taPipeline(nlhs, plhs, nrhs, prhs);
+			return;
+		}
 
-	// Init the switch function string mapping to the enum
-	InitSwitchMapping();
+		taFunc = taResolve(taFuncNameIn.c_str());
+	}
 
 	// If we have no parameters the user is requesting information about a given function.
 	// Provide and exit.
@@ -109,7 +207,7 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 		return;
 	}
 
-	switch (s_mapStringValues[taFuncNameIn])
+	switch (taFunc)
 	{
 		// Acceleration Bands
 		case ta_accbands:
@@ -162,13 +260,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsC		= (int)mxGetN(close_IN);
 
 				// Validate
-				chkSingleVec(colsH, colsL, colsC, codeLine);
+				int cols = chkSameCols(colsH, colsL, colsC, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int accIdx, outElements;
 				double *accUpper, *accMid, *accLower;
 
 				// Parse optional inputs if given, else default 
@@ -188,49 +285,26 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					lookback = 14;
 				}
 
-				// Preallocate heap
-				accUpper	= (double*)mxCalloc(rows, sizeof(double));
-				accMid		= (double*)mxCalloc(rows, sizeof(double));
-				accLower	= (double*)mxCalloc(rows, sizeof(double));
-
-				retCode = TA_ACCBANDS(startIdx, endIdx, highPtr, lowPtr, closePtr, lookback, &accIdx, &outElements, accUpper, accMid, accLower);
+				// Allocate the outputs up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				int outBeg = TA_ACCBANDS_Lookback(lookback);
+				accUpper = taAllocOut(accUpper_OUT, rows, cols, outBeg);
+				accMid = taAllocOut(accMid_OUT, rows, cols, outBeg);
+				accLower = taAllocOut(accLower_OUT, rows, cols, outBeg);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_ACCBANDS(startIdx, endIdx, highPtr + colOff, lowPtr + colOff, closePtr + colOff, lookback, &colBegIdx, &colElements, accUpper + colOff, accMid + colOff, accLower + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(accUpper);
-					mxFree(accMid);
-					mxFree(accLower);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				accUpper_OUT = mxCreateDoubleMatrix(accIdx + outElements,1, mxREAL);
-				accMid_OUT = mxCreateDoubleMatrix(accIdx + outElements,1, mxREAL);
-				accLower_OUT = mxCreateDoubleMatrix(accIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(accUpper_OUT)) + accIdx, accUpper, outElements * mxGetElementSize(accUpper_OUT));
-				memcpy(((double *) mxGetData(accMid_OUT)) + accIdx, accMid, outElements * mxGetElementSize(accMid_OUT));
-				memcpy(((double *) mxGetData(accLower_OUT)) + accIdx, accLower, outElements * mxGetElementSize(accLower_OUT));
-
-				// Cleanup
-				mxFree(accUpper); 
-				mxFree(accMid); 
-				mxFree(accLower); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *uBandPtr = mxGetPr(accUpper_OUT);
-				double *mBandPtr = mxGetPr(accMid_OUT);
-				double *lBandPtr = mxGetPr(accLower_OUT);
-
-				for (int iter = 0; iter < lookback; iter++)
-				{
-					uBandPtr[iter] = m_Nan;
-					mBandPtr[iter] = m_Nan;
-					lBandPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 			
@@ -293,57 +367,88 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				rows		= (int)mxGetM(vec_IN);
 
 				// Validate
-				chkSingleVec(colsVec, codeLine);
+				int cols = chkSameCols(colsVec, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int vecIdx, outElements;
 				double *outReal;
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
-
+				// Outputs are allocated with each invocation below.  TA-Lib writes from outBegIdx (the lookback) onward
 				// Invoke with error catch
-				switch (s_mapStringValues[taFuncNameIn])
+				switch (taFunc)
 				{
 					case ta_acos:
-						retCode = TA_ACOS(startIdx, endIdx, vecPtr, &vecIdx, &outElements, outReal);
+						outReal = taAllocOut(vec_OUT, rows, cols, TA_ACOS_Lookback());
+						retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+						for (int col = 0; col < cols; col++)
+						{
+							int colOff = col * rows, colBegIdx, colElements;
+							taColCode(retCode, TA_ACOS(startIdx, endIdx, vecPtr + colOff, &colBegIdx, &colElements, outReal + colOff));
+						}
 					break;
 					case ta_sin:
-						retCode = TA_SIN(startIdx, endIdx, vecPtr, &vecIdx, &outElements, outReal);
+						outReal = taAllocOut(vec_OUT, rows, cols, TA_SIN_Lookback());
+						retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+						for (int col = 0; col < cols; col++)
+						{
+							int colOff = col * rows, colBegIdx, colElements;
+							taColCode(retCode, TA_SIN(startIdx, endIdx, vecPtr + colOff, &colBegIdx, &colElements, outReal + colOff));
+						}
 					break;
 					case ta_sinh:
-						retCode = TA_SINH(startIdx, endIdx, vecPtr, &vecIdx, &outElements, outReal);
+						outReal = taAllocOut(vec_OUT, rows, cols, TA_SINH_Lookback());
+						retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+						for (int col = 0; col < cols; col++)
+						{
+							int colOff = col * rows, colBegIdx, colElements;
+							taColCode(retCode, TA_SINH(startIdx, endIdx, vecPtr + colOff, &colBegIdx, &colElements, outReal + colOff));
+						}
 					break;
 					case ta_sqrt:
-						retCode = TA_SQRT(startIdx, endIdx, vecPtr, &vecIdx, &outElements, outReal);
+						outReal = taAllocOut(vec_OUT, rows, cols, TA_SQRT_Lookback());
+						retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+						for (int col = 0; col < cols; col++)
+						{
+							int colOff = col * rows, colBegIdx, colElements;
+							taColCode(retCode, TA_SQRT(startIdx, endIdx, vecPtr + colOff, &colBegIdx, &colElements, outReal + colOff));
+						}
 						break;
 					case ta_tan:
-						retCode = TA_TAN(startIdx, endIdx, vecPtr, &vecIdx, &outElements, outReal);
+						outReal = taAllocOut(vec_OUT, rows, cols, TA_TAN_Lookback());
+						retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+						for (int col = 0; col < cols; col++)
+						{
+							int colOff = col * rows, colBegIdx, colElements;
+							taColCode(retCode, TA_TAN(startIdx, endIdx, vecPtr + colOff, &colBegIdx, &colElements, outReal + colOff));
+						}
 						break;
 					case ta_tanh:
-						retCode = TA_TANH(startIdx, endIdx, vecPtr, &vecIdx, &outElements, outReal);
+						outReal = taAllocOut(vec_OUT, rows, cols, TA_TANH_Lookback());
+						retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+						for (int col = 0; col < cols; col++)
+						{
+							int colOff = col * rows, colBegIdx, colElements;
+							taColCode(retCode, TA_TANH(startIdx, endIdx, vecPtr + colOff, &colBegIdx, &colElements, outReal + colOff));
+						}
 						break;
 				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt( "MATLAB:taInvoke:invokeErr",
 						"Invocation to '%s' failed.. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				vec_OUT = mxCreateDoubleMatrix(vecIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(vec_OUT)) + vecIdx, outReal, outElements * mxGetElementSize(vec_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
 				break;
 			}
 			
@@ -398,41 +503,33 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsV		= (int)mxGetN(vol_IN);
 
 				// Input validation
-				chkSingleVec(colsH, colsL, colsC, codeLine);
-
-				if (colsV != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_ad:InputErr",
-						"Volume data should be a single vector array. Aborting (%d).",codeLine);
-				}
+				int cols = chkSameCols(colsH, colsL, colsC, colsV, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int adIdx, outElements;
 				double *outReal;
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));			// added cast
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(ad_OUT, rows, cols, TA_AD_Lookback());
 
 				// Invoke with error catch
-				retCode = TA_AD(startIdx, endIdx, highPtr, lowPtr, closePtr, volPtr, &adIdx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_AD(startIdx, endIdx, highPtr + colOff, lowPtr + colOff, closePtr + colOff, volPtr + colOff, &colBegIdx, &colElements, outReal + colOff));
+				}
 		
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgTxt("Invocation to 'ta_ad' failed. Aborting.");
 				}
 
-				// Populate Output
-				ad_OUT = mxCreateDoubleMatrix(adIdx + outElements,1, mxREAL);
-				memcpy(((double*) mxGetData(ad_OUT)) + adIdx, outReal, outElements * mxGetElementSize(ad_OUT));
-		
-				// Cleanup
-				mxFree(outReal);  
 				break;
 			}
 
@@ -480,44 +577,46 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsTwo			= (int)mxGetN(secondVec_IN);
 
 				// Validate
-				chkSingleVec(colsOne, codeLine);
-				chkSingleVec(colsTwo, codeLine);
+				int cols = chkSameCols(colsOne, colsTwo, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int outIdx, outElements;
 				double *outReal;
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
-
-				switch (s_mapStringValues[taFuncNameIn])
+				// Outputs are allocated with each invocation below.  TA-Lib writes from outBegIdx (the lookback) onward
+				switch (taFunc)
 				{
 					case ta_add:
-						retCode = TA_ADD(startIdx, endIdx, firstVecPtr, secondVecPtr, &outIdx, &outElements, outReal);
+						outReal = taAllocOut(vector_OUT, rows, cols, TA_ADD_Lookback());
+						retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+						for (int col = 0; col < cols; col++)
+						{
+							int colOff = col * rows, colBegIdx, colElements;
+							taColCode(retCode, TA_ADD(startIdx, endIdx, firstVecPtr + colOff, secondVecPtr + colOff, &colBegIdx, &colElements, outReal + colOff));
+						}
 					break;
 					case ta_sub:
-						retCode = TA_SUB(startIdx, endIdx, firstVecPtr, secondVecPtr, &outIdx, &outElements, outReal);
+						outReal = taAllocOut(vector_OUT, rows, cols, TA_SUB_Lookback());
+						retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+						for (int col = 0; col < cols; col++)
+						{
+							int colOff = col * rows, colBegIdx, colElements;
+							taColCode(retCode, TA_SUB(startIdx, endIdx, firstVecPtr + colOff, secondVecPtr + colOff, &colBegIdx, &colElements, outReal + colOff));
+						}
 					break;
 				}
 				
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				vector_OUT = mxCreateDoubleMatrix(outIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(vector_OUT)) + outIdx, outReal, outElements * mxGetElementSize(vector_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
 				break;
 			}
 
@@ -574,19 +673,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsV		= (int)mxGetN(vol_IN);
 
 				// Input validation
-				chkSingleVec(colsH, colsL, colsC, codeLine);
-
-				if (colsV != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_adosc:InputErr",
-						"Volume data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsH, colsL, colsC, colsV, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int adoscIdx, outElements;
 				double *outReal;
 				
 				// Parse optional inputs if given, else default 
@@ -619,26 +711,25 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					slowMA = 10;
 				}
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(adosc_OUT, rows, cols, TA_ADOSC_Lookback(fastMA, slowMA));
 
 				// Invoke with error catch
-				retCode = TA_ADOSC(startIdx, endIdx, highPtr, lowPtr, closePtr, volPtr, fastMA, slowMA, &adoscIdx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_ADOSC(startIdx, endIdx, highPtr + colOff, lowPtr + colOff, closePtr + colOff, volPtr + colOff, fastMA, slowMA, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgTxt("Invocation to 'ta_adosc' failed. Aborting (577).");
 				}
 
-				// Populate Output
-				adosc_OUT = mxCreateDoubleMatrix(adoscIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(adosc_OUT)) + adoscIdx, outReal, outElements * mxGetElementSize(adosc_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
 				break;
 			}
 
@@ -690,13 +781,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsC		= (int)mxGetN(close_IN);
 
 				// Validate
-				chkSingleVec(colsH, colsL, colsC, codeLine);
+				int cols = chkSameCols(colsH, colsL, colsC, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int adxIdx, outElements;
 				double *outReal;
 
 				// Parse optional inputs if given, else default 
@@ -716,45 +806,40 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					lookback = 14;
 				}
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
-
+				// Outputs are allocated with each invocation below.  TA-Lib writes from outBegIdx (the lookback) onward
 				if (taFuncNameIn.compare("ta_adx") == 0)
 				{
 					// Invoke with error catch
-					retCode = TA_ADX(startIdx, endIdx, highPtr, lowPtr, closePtr, lookback, &adxIdx, &outElements, outReal);
+					outReal = taAllocOut(adx_OUT, rows, cols, TA_ADX_Lookback(lookback));
+					retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+					for (int col = 0; col < cols; col++)
+					{
+						int colOff = col * rows, colBegIdx, colElements;
+						taColCode(retCode, TA_ADX(startIdx, endIdx, highPtr + colOff, lowPtr + colOff, closePtr + colOff, lookback, &colBegIdx, &colElements, outReal + colOff));
+					}
 				}
 				else
 				{
 					// Invoke with error catch
-					retCode = TA_ADXR(startIdx, endIdx, highPtr, lowPtr, closePtr, lookback, &adxIdx, &outElements, outReal);
+					outReal = taAllocOut(adx_OUT, rows, cols, TA_ADXR_Lookback(lookback));
+					retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+					for (int col = 0; col < cols; col++)
+					{
+						int colOff = col * rows, colBegIdx, colElements;
+						taColCode(retCode, TA_ADXR(startIdx, endIdx, highPtr + colOff, lowPtr + colOff, closePtr + colOff, lookback, &colBegIdx, &colElements, outReal + colOff));
+					}
 				}
 				
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				adx_OUT = mxCreateDoubleMatrix(adxIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(adx_OUT)) + adxIdx, outReal, outElements * mxGetElementSize(adx_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *outPtr = mxGetPr(adx_OUT);
-
-				for (int iter = 0; iter < lookback; iter++)
-				{
-					outPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 		
@@ -813,17 +898,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsP		= (int)mxGetN(price_IN);
 				rows		= (int)mxGetM(price_IN);
 
-				if (colsP != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_apo:InputErr",
-						"Price data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsP, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int poIdx, outElements;
 				double *outReal;
 
 				// Parse optional inputs if given, else default 
@@ -886,16 +966,28 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				// Validate
 				typeMAcheck(taFuncNameIn, taFuncDesc, taFuncOptName, typeMA);
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));			// added cast
-
-				switch (s_mapStringValues[taFuncNameIn])
+				// Outputs are allocated with each invocation below.  TA-Lib writes from outBegIdx (the lookback) onward
+				switch (taFunc)
 				{
 					case ta_apo:       
-						retCode = TA_APO(startIdx, endIdx, pricePtr, fastMA, slowMA, (TA_MAType)typeMA, &poIdx, &outElements, outReal);
+						outReal = taAllocOut(po_OUT, rows, cols, TA_APO_Lookback(fastMA, slowMA, (TA_MAType)typeMA));
+						retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+						for (int col = 0; col < cols; col++)
+						{
+							int colOff = col * rows, colBegIdx, colElements;
+							taColCode(retCode, TA_APO(startIdx, endIdx, pricePtr + colOff, fastMA, slowMA, (TA_MAType)typeMA, &colBegIdx, &colElements, outReal + colOff));
+						}
 						break;
 					case ta_ppo:
-						retCode = TA_PPO(startIdx, endIdx, pricePtr, fastMA, slowMA, (TA_MAType)typeMA, &poIdx, &outElements, outReal);
+						outReal = taAllocOut(po_OUT, rows, cols, TA_PPO_Lookback(fastMA, slowMA, (TA_MAType)typeMA));
+						retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+						for (int col = 0; col < cols; col++)
+						{
+							int colOff = col * rows, colBegIdx, colElements;
+							taColCode(retCode, TA_PPO(startIdx, endIdx, pricePtr + colOff, fastMA, slowMA, (TA_MAType)typeMA, &colBegIdx, &colElements, outReal + colOff));
+						}
 						break;
 				}
 
@@ -903,17 +995,10 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgTxt("Invocation to 'ta_apo' failed. Aborting (843).");
 				}
 
-				// Populate Output
-				po_OUT = mxCreateDoubleMatrix(poIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(po_OUT)) + poIdx, outReal, outElements * mxGetElementSize(po_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
 				break;
 			}
 
@@ -963,13 +1048,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsL		= (int)mxGetN(low_IN);
 
 				// Validate
-				chkSingleVec(colsH, colsL, codeLine);
+				int cols = chkSameCols(colsH, colsL, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int aroonIdx, outElements;
 				double *aroonUp, *aroonDn;
 
 				// Get optional input or assign default
@@ -990,44 +1074,27 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					lookback = 14;
 				}
 
-				// Preallocate heap
-				aroonUp = (double*)mxCalloc(rows, sizeof(double));
-				aroonDn = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the outputs up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				int outBeg = TA_AROON_Lookback(lookback);
+				aroonDn = taAllocOut(aroonDn_OUT, rows, cols, outBeg);
+				aroonUp = taAllocOut(aroonUp_OUT, rows, cols, outBeg);
 
 				// Invoke with error catch
-				retCode = TA_AROON(startIdx, endIdx, highPtr, lowPtr, lookback, &aroonIdx, &outElements, aroonDn, aroonUp);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_AROON(startIdx, endIdx, highPtr + colOff, lowPtr + colOff, lookback, &colBegIdx, &colElements, aroonDn + colOff, aroonUp + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(aroonUp);
-					mxFree(aroonDn);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				aroonDn_OUT = mxCreateDoubleMatrix(aroonIdx + outElements,1, mxREAL);
-				aroonUp_OUT = mxCreateDoubleMatrix(aroonIdx + outElements,1, mxREAL);
-				
-				memcpy(((double *) mxGetData(aroonDn_OUT)) + aroonIdx, aroonDn, outElements * mxGetElementSize(aroonDn_OUT));
-				memcpy(((double *) mxGetData(aroonUp_OUT)) + aroonIdx, aroonUp, outElements * mxGetElementSize(aroonUp_OUT));
-
-				// Cleanup
-				mxFree(aroonDn); 
-				mxFree(aroonUp);
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *upPtr = mxGetPr(aroonUp_OUT);
-				double *dnPtr = mxGetPr(aroonDn_OUT);
-
-				for (int iter = 0; iter < lookback; iter++)
-				{
-					upPtr[iter] = m_Nan;
-					dnPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 			
@@ -1075,13 +1142,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsL		= (int)mxGetN(low_IN);
 
 				// Validate
-				chkSingleVec(colsH, colsL, codeLine);
+				int cols = chkSameCols(colsH, colsL, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int aroonoscIdx, outElements;
 				double *aroonOsc;
 
 				// Get optional input or assign default
@@ -1102,36 +1168,25 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					lookback = 14;
 				}
 
-				// Preallocate heap
-				aroonOsc = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				aroonOsc = taAllocOut(aroonOsc_OUT, rows, cols, TA_AROONOSC_Lookback(lookback));
 
 				// Invoke with error catch
-				retCode = TA_AROONOSC(startIdx, endIdx, highPtr, lowPtr, lookback, &aroonoscIdx, &outElements, aroonOsc);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_AROONOSC(startIdx, endIdx, highPtr + colOff, lowPtr + colOff, lookback, &colBegIdx, &colElements, aroonOsc + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(aroonOsc);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				aroonOsc_OUT = mxCreateDoubleMatrix(aroonoscIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(aroonOsc_OUT)) + aroonoscIdx, aroonOsc, outElements * mxGetElementSize(aroonOsc_OUT));
-
-				// Cleanup
-				mxFree(aroonOsc); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *outPtr = mxGetPr(aroonOsc_OUT);
-
-				for (int iter = 0; iter < lookback; iter++)
-				{
-					outPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 
@@ -1177,40 +1232,33 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsSin		= (int)mxGetN(sin_IN);
 				rows		= (int)mxGetM(sin_IN);
 
-				if (colsSin != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_asin:InputErr",
-						"Sine data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsSin, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int asinIdx, outElements;
 				double *outReal;
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(asin_OUT, rows, cols, TA_ASIN_Lookback());
 
 				// Invoke with error catch
-				retCode = TA_ASIN(startIdx, endIdx, sinPtr, &asinIdx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_ASIN(startIdx, endIdx, sinPtr + colOff, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgTxt("Invocation to 'ta_acos' failed. Aborting (1140).");
 				}
 
-				// Populate Output
-				asin_OUT = mxCreateDoubleMatrix(asinIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(asin_OUT)) + asinIdx, outReal, outElements * mxGetElementSize(asin_OUT));
-
-				// Cleanup
-				mxFree(outReal);
-
 				break;
 			}
 			
@@ -1255,40 +1303,33 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsTan		= (int)mxGetN(tan_IN);
 				rows		= (int)mxGetM(tan_IN);
 
-				if (colsTan != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_atan:InputErr",
-						"Tangent data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsTan, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int atanIdx, outElements;
 				double *outReal;
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(atan_OUT, rows, cols, TA_ATAN_Lookback());
 
 				// Invoke with error catch
-				retCode = TA_ATAN(startIdx, endIdx, tanPtr, &atanIdx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_ATAN(startIdx, endIdx, tanPtr + colOff, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgTxt("Invocation to 'ta_atan' failed. Aborting (1219).");
 				}
 
-				// Populate Output
-				atan_OUT = mxCreateDoubleMatrix(atanIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(atan_OUT)) + atanIdx, outReal, outElements * mxGetElementSize(atan_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
 				break;
 			}
 
@@ -1339,13 +1380,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsC		= (int)mxGetN(close_IN);
 
 				// Validate
-				chkSingleVec(colsH, colsL, colsC, codeLine);
+				int cols = chkSameCols(colsH, colsL, colsC, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int atrIdx, outElements;
 				double *outReal;
 
 				// Parse optional inputs if given, else default 
@@ -1366,35 +1406,23 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					lookback = 14;
 				}
 
-				// Preallocate heap
-				outReal	= (double*)mxCalloc(rows, sizeof(double));
-
-				retCode = TA_ATR(startIdx, endIdx, highPtr, lowPtr, closePtr, lookback, &atrIdx, &outElements, outReal);
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(atr_OUT, rows, cols, TA_ATR_Lookback(lookback));
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_ATR(startIdx, endIdx, highPtr + colOff, lowPtr + colOff, closePtr + colOff, lookback, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				atr_OUT = mxCreateDoubleMatrix(atrIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(atr_OUT)) + atrIdx, outReal, outElements * mxGetElementSize(atr_OUT));
-
-				// Cleanup
-				mxFree(outReal);
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *outPtr = mxGetPr(atr_OUT);
-
-				for (int iter = 0; iter < lookback; iter++)
-				{
-					outPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 
@@ -1429,7 +1457,7 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				//		ta_wma		data	a vector of observational data
 
 				// OPTIONAL INPUTS
-				//		Lookback Period	
+				//		Lookback Period	(a scalar, or a vector of K lookbacks to evaluate in one call)
 				//			Defaults:	10	ROC, ROCP, ROCR, ROCR100
 				//						14	AVGDEV, RSI, TSF
 				//						30	SMA, SUM, TEMA, TRIMA, TRIX, WMA
@@ -1448,6 +1476,9 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				//		ta_trix		TRIX		vector of 1-day Rate-Of-Change (ROC) of a Triple Smooth EMA
 				//		ta_tsf		TSF			vector of Time Series Forecast values
 				//		ta_wma		WMA			vector of Weighted Moving Average values
+				//
+				//		Given K lookbacks the output has one column per lookback (N x K), or N x M x K for M instruments.
+				//		SMA and SUM sweeps keep a rolling window sum per lookback, as TA-Lib does, without a call per lookback.
 
 				//		The following is the table of Rate-Of-Change implemented in TA-LIB:
 				//		MOM     = (price - prevPrice)				[Momentum]
@@ -1468,7 +1499,7 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				//		always positive values.
 
 				// Strings for validation feedback
-				switch (s_mapStringValues[taFuncNameIn])
+				switch (taFunc)
 				{
 				case ta_avgdev:
 					taFuncDesc = "Average Deviation";
@@ -1527,7 +1558,8 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				#define vec_OUT		plhs[0]
 
 				// Declare variables
-				int startIdx, endIdx, rows, colsD, lookback;
+				int startIdx, endIdx, rows, colsD, lookback, numLb;
+				int *lookbacks;
 				double *dataPtr;
 
 				// Initialize error handling 
@@ -1540,59 +1572,60 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 
 				// Validate
-				chkSingleVec(colsD, codeLine);
+				int cols = chkSameCols(colsD, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int vecIdx, outElements;
 				double *outReal;
 
 				// Parse optional inputs if given, else default 
 				if (nrhs == 3) 
 				{
 					#define lookback_IN	prhs[2]
-					if (!isRealScalar(lookback_IN))
+					numLb = taGetParams(lookback_IN, lookbacks);
+					if (numLb == 0)
 						mexErrMsgIdAndTxt( "MATLAB:taInvoke:inputErr",
-						"The '%s' lookback must be a scalar. Aborting (%d).",taFuncNameIn, codeLine);
-					/* Get the scalar input lookback */
-					// Assign
-					lookback = (int)mxGetScalar(lookback_IN);
+						"The '%s' lookback must be a scalar or a vector. Aborting (%d).",taFuncNameIn, codeLine);
 
 					// Validation
-					switch (s_mapStringValues[taFuncNameIn])
+					for (int iter = 0; iter < numLb; iter++)
 					{
-						// Throws an error if ....
-						// < 2
-						case ta_rsi:
-						case ta_sma:
-						case ta_sum:
-						case ta_tema:
-						case ta_trima:
-						case ta_tsf:
-						case ta_wma:
-							if (lookback < 2)
-							{
-								mexErrMsgIdAndTxt( "MATLAB:taInvoke:inputErr",
-									"The '%s' lookback must be an integer equal to or greater than 2. Aborting (%d).", taFuncNameIn, codeLine);
-							}
-							break;
-						// < 1
-						default:
-							if (lookback < 1)
-							{
-								mexErrMsgIdAndTxt( "MATLAB:taInvoke:inputErr",
-									"The '%s' lookback must be an integer equal to or greater than 1. Aborting (%d).", taFuncNameIn, codeLine);
-							}
+						lookback = lookbacks[iter];
+						switch (taFunc)
+						{
+							// Throws an error if ....
+							// < 2
+							case ta_rsi:
+							case ta_sma:
+							case ta_sum:
+							case ta_tema:
+							case ta_trima:
+							case ta_tsf:
+							case ta_wma:
+								if (lookback < 2)
+								{
+									mexErrMsgIdAndTxt( "MATLAB:taInvoke:inputErr",
+										"The '%s' lookback must be an integer equal to or greater than 2. Aborting (%d).", taFuncNameIn, codeLine);
+								}
+								break;
+							// < 1
+							default:
+								if (lookback < 1)
+								{
+									mexErrMsgIdAndTxt( "MATLAB:taInvoke:inputErr",
+										"The '%s' lookback must be an integer equal to or greater than 1. Aborting (%d).", taFuncNameIn, codeLine);
+								}
 							
-							break;
+								break;
+						}
 					}
 				}
 				else
 				// Default lookback period
 				{
-					switch (s_mapStringValues[taFuncNameIn])
+					switch (taFunc)
 					{
 						case ta_roc:
 						case ta_rocp:
@@ -1615,78 +1648,113 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 							lookback = 30;
 							break;
 					}	
+
+					numLb = 1;
+					lookbacks = (int*)mxMalloc(sizeof(int));
+					lookbacks[0] = lookback;
 				}
 
-				// Preallocate heap
-				outReal	= (double*)mxCalloc(rows, sizeof(double));
+				// Every function of the group takes a single series and a lookback period
+				taPeriodFunc periodFunc;
+				taPeriodLookback periodLookback;
 
-				switch (s_mapStringValues[taFuncNameIn])
+				switch (taFunc)
 				{
 					case ta_avgdev:
-						retCode = TA_AVGDEV(startIdx, endIdx, dataPtr, lookback, &vecIdx, &outElements, outReal);
+						periodFunc = TA_AVGDEV;
+						periodLookback = TA_AVGDEV_Lookback;
 						break;
 					case ta_roc:
-						retCode = TA_ROC(startIdx, endIdx, dataPtr, lookback, &vecIdx, &outElements, outReal);
+						periodFunc = TA_ROC;
+						periodLookback = TA_ROC_Lookback;
 						break;
 					case ta_rocp:
-						retCode = TA_ROCP(startIdx, endIdx, dataPtr, lookback, &vecIdx, &outElements, outReal);
+						periodFunc = TA_ROCP;
+						periodLookback = TA_ROCP_Lookback;
 						break;
 					case ta_rocr:
-						retCode = TA_ROCR(startIdx, endIdx, dataPtr, lookback, &vecIdx, &outElements, outReal);
+						periodFunc = TA_ROCR;
+						periodLookback = TA_ROCR_Lookback;
 						break;
 					case ta_rocr100:
-						retCode = TA_ROCR100(startIdx, endIdx, dataPtr, lookback, &vecIdx, &outElements, outReal);
+						periodFunc = TA_ROCR100;
+						periodLookback = TA_ROCR100_Lookback;
 						break;
 					case ta_rsi:
-						retCode = TA_RSI(startIdx, endIdx, dataPtr, lookback, &vecIdx, &outElements, outReal);
+						periodFunc = TA_RSI;
+						periodLookback = TA_RSI_Lookback;
 						break;
 					case ta_sma:
-						retCode = TA_SMA(startIdx, endIdx, dataPtr, lookback, &vecIdx, &outElements, outReal);
+						periodFunc = TA_SMA;
+						periodLookback = TA_SMA_Lookback;
 						break;
 					case ta_sum:
-						retCode = TA_SUM(startIdx, endIdx, dataPtr, lookback, &vecIdx, &outElements, outReal);
+						periodFunc = TA_SUM;
+						periodLookback = TA_SUM_Lookback;
 						break;
 					case ta_tema:
-						retCode = TA_TEMA(startIdx, endIdx, dataPtr, lookback, &vecIdx, &outElements, outReal);
-						// Update lookback value for NaN routine
-						lookback = (lookback - 1) * 3;
+						periodFunc = TA_TEMA;
+						periodLookback = TA_TEMA_Lookback;
 						break;
 					case ta_trima:
-						retCode = TA_TRIMA(startIdx, endIdx, dataPtr, lookback, &vecIdx, &outElements, outReal);
+						periodFunc = TA_TRIMA;
+						periodLookback = TA_TRIMA_Lookback;
 						break;
 					case ta_trix:
-						retCode = TA_TRIX(startIdx, endIdx, dataPtr, lookback, &vecIdx, &outElements, outReal);
+						periodFunc = TA_TRIX;
+						periodLookback = TA_TRIX_Lookback;
 						break;
 					case ta_tsf:
-						retCode = TA_TSF(startIdx, endIdx, dataPtr, lookback, &vecIdx, &outElements, outReal);
+						periodFunc = TA_TSF;
+						periodLookback = TA_TSF_Lookback;
 						break;
 					case ta_wma:
-						retCode = TA_WMA(startIdx, endIdx, dataPtr, lookback, &vecIdx, &outElements, outReal);
+						periodFunc = TA_WMA;
+						periodLookback = TA_WMA_Lookback;
 						break;
 				}
 
-				// Error handling
-				if (retCode) 
+				// Allocate the output up front.  Each lookback is written from its own outBegIdx onward
+				int *outBeg = (int*)mxMalloc(numLb * sizeof(int));
+				for (int iter = 0; iter < numLb; iter++)
 				{
-					mxFree(outReal);
-					mexPrintf("%s%i","Return code=",retCode);
-					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
+					outBeg[iter] = min(periodLookback(lookbacks[iter]), rows);
 				}
+				outReal = taAllocGridOut(vec_OUT, rows, cols, numLb, outBeg);
 
-				// Populate Output
-				vec_OUT = mxCreateDoubleMatrix(vecIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(vec_OUT)) + vecIdx, outReal, outElements * mxGetElementSize(vec_OUT));
+				// Invoke with error catch
+				// Columns of the grid (lookback, instrument) are independent.  Column 'job' begins at job * rows.
+				int numJobs = numLb * cols;
+				retCode = TA_SUCCESS;
 
-				// Cleanup
-				mxFree(outReal);
+				if (numLb > 1 && (taFunc == ta_sma || taFunc == ta_sum))
+				{
+#pragma omp parallel for schedule(dynamic) if (numJobs > 1)
+					for (int job = 0; job < numJobs; job++)
+					{
+						int col = job % cols;
+						taRollSums(dataPtr + col * rows, rows, lookbacks[job / cols], taFunc == ta_sma ? taRollMean : taRollSum, 1,
+							outReal + job * rows);
+					}
+				}
+				else
+				{
+#pragma omp parallel for schedule(dynamic) if (numJobs > 1)
+					for (int job = 0; job < numJobs; job++)
+					{
+						int col = job % cols, kk = job / cols, colBegIdx, colElements;
+						taColCode(retCode, periodFunc(startIdx, endIdx, dataPtr + col * rows, lookbacks[kk], &colBegIdx, &colElements, outReal + job * rows + outBeg[kk]));
+					}
+				}
 
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *outPtr = mxGetPr(vec_OUT);
+				mxFree(outBeg);
+				mxFree(lookbacks);
 
-				for (int iter = 0; iter < lookback; iter++)
+				// Error handling
+				if (retCode) 
 				{
-					outPtr[iter] = m_Nan;
+					mexPrintf("%s%i","Return code=",retCode);
+					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
 				break;
@@ -1742,35 +1810,31 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsC		= (int)mxGetN(close_IN);
 
 				// Validate
-				chkSingleVec(colsO, colsH, colsL, colsC, codeLine);
+				int cols = chkSameCols(colsO, colsH, colsL, colsC, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int avgpriceIdx, outElements;
 				double *outReal;
 
-				// Preallocate heap
-				outReal	= (double*)mxCalloc(rows, sizeof(double));
-
-				retCode = TA_AVGPRICE(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &avgpriceIdx, &outElements, outReal);
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(avgPrice_OUT, rows, cols, TA_AVGPRICE_Lookback());
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_AVGPRICE(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				avgPrice_OUT = mxCreateDoubleMatrix(avgpriceIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(avgPrice_OUT)) + avgpriceIdx, outReal, outElements * mxGetElementSize(avgPrice_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
 				break;
 			}
 
@@ -1837,17 +1901,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				rows		= (int)mxGetM(data_IN);
 				colsD		= (int)mxGetN(data_IN);
 
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_bbands:InputErr",
-						"Observational data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int bbandsIdx, outElements;
 				double *bbUpper, *bbMid, *bbLower;
 
 				// Parse optional inputs if given, else default 
@@ -1922,49 +1981,26 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				// Validate
 				typeMAcheck(taFuncNameIn, taFuncDesc, taFuncOptName, typeMA);
 
-				// Preallocate heap
-				bbUpper	= (double*)mxCalloc(rows, sizeof(double));
-				bbMid	= (double*)mxCalloc(rows, sizeof(double));
-				bbLower	= (double*)mxCalloc(rows, sizeof(double));
-
-				retCode = TA_BBANDS(startIdx, endIdx, dataPtr, lookback, upMult,dnMult, (TA_MAType)typeMA, &bbandsIdx, &outElements, bbUpper, bbMid, bbLower);
+				// Allocate the outputs up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				int outBeg = TA_BBANDS_Lookback(lookback, upMult, dnMult, (TA_MAType)typeMA);
+				bbUpper = taAllocOut(bbUpper_OUT, rows, cols, outBeg);
+				bbMid = taAllocOut(bbMid_OUT, rows, cols, outBeg);
+				bbLower = taAllocOut(bbLower_OUT, rows, cols, outBeg);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_BBANDS(startIdx, endIdx, dataPtr + colOff, lookback, upMult, dnMult, (TA_MAType)typeMA, &colBegIdx, &colElements, bbUpper + colOff, bbMid + colOff, bbLower + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(bbUpper);
-					mxFree(bbMid);
-					mxFree(bbLower);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgTxt("Invocation to 'ta_bbands' failed. Aborting (1604).");
 				}
 
-				// Populate Output
-				bbUpper_OUT = mxCreateDoubleMatrix(bbandsIdx + outElements,1, mxREAL);
-				bbMid_OUT = mxCreateDoubleMatrix(bbandsIdx + outElements,1, mxREAL);
-				bbLower_OUT = mxCreateDoubleMatrix(bbandsIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(bbUpper_OUT)) + bbandsIdx, bbUpper, outElements * mxGetElementSize(bbUpper_OUT));
-				memcpy(((double *) mxGetData(bbMid_OUT)) + bbandsIdx, bbMid, outElements * mxGetElementSize(bbMid_OUT));
-				memcpy(((double *) mxGetData(bbLower_OUT)) + bbandsIdx, bbLower, outElements * mxGetElementSize(bbLower_OUT));
-
-				// Cleanup
-				mxFree(bbUpper); 
-				mxFree(bbMid); 
-				mxFree(bbLower); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *uBandPtr = mxGetPr(bbUpper_OUT);
-				double *mBandPtr = mxGetPr(bbMid_OUT);
-				double *lBandPtr = mxGetPr(bbLower_OUT);
-
-				for (int iter = 0; iter < lookback; iter++)
-				{
-					uBandPtr[iter] = m_Nan;
-					mBandPtr[iter] = m_Nan;
-					lBandPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 
@@ -2010,25 +2046,14 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				rows		= (int)mxGetM(ind_IN);
 				colsI		= (int)mxGetN(ind_IN);
 				basePtr		= mxGetPr(base_IN);
-				colsB		= (int)mxGetN(ind_IN);
+				colsB		= (int)mxGetN(base_IN);
 
-				if (colsI != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_beta:InputErr",
-						"The individual instrument data should be a single vector array. Aborting (%d).", codeLine);
-				}
-
-				if (colsB != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_beta:InputErr",
-						"The base instrument data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsI, colsB, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int betaIdx, outElements;
 				double *outReal;
 
 				// Parse optional inputs if given, else default 
@@ -2049,26 +2074,23 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					lookback = 5;
 				}
 
-				// Preallocate heap
-				outReal	= (double*)mxCalloc(rows, sizeof(double));
-
-				retCode = TA_BETA(startIdx, endIdx, indPtr, basePtr, lookback, &betaIdx, &outElements, outReal);
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(beta_OUT, rows, cols, TA_BETA_Lookback(lookback));
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_BETA(startIdx, endIdx, indPtr + colOff, basePtr + colOff, lookback, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				beta_OUT = mxCreateDoubleMatrix(betaIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(beta_OUT)) + betaIdx, outReal, outElements * mxGetElementSize(beta_OUT));
-
-				// Cleanup
-				mxFree(outReal);
-
 				break;
 			}
 
@@ -2122,35 +2144,31 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsC		= (int)mxGetN(close_IN);
 
 				// Validate
-				chkSingleVec(colsO, colsH, colsL, colsC, codeLine);
+				int cols = chkSameCols(colsO, colsH, colsL, colsC, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int bopIdx, outElements;
 				double *outReal;
 
-				// Preallocate heap
-				outReal	= (double*)mxCalloc(rows, sizeof(double));
-
-				retCode = TA_BOP(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &bopIdx, &outElements, outReal);
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(bop_OUT, rows, cols, TA_BOP_Lookback());
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_BOP(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				bop_OUT = mxCreateDoubleMatrix(bopIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(bop_OUT)) + bopIdx, outReal, outElements * mxGetElementSize(bop_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
 				break;
 			}
 
@@ -2201,13 +2219,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsC		= (int)mxGetN(close_IN);
 
 				// Validate
-				chkSingleVec(colsH, colsL, colsC, codeLine);
+				int cols = chkSameCols(colsH, colsL, colsC, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int cciIdx, outElements;
 				double *outReal;
 
 				// Parse optional inputs if given, else default 
@@ -2228,35 +2245,23 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					lookback = 14;
 				}
 
-				// Preallocate heap
-				outReal	= (double*)mxCalloc(rows, sizeof(double));
-
-				retCode = TA_CCI(startIdx, endIdx, highPtr, lowPtr, closePtr, lookback, &cciIdx, &outElements, outReal);
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(cci_OUT, rows, cols, TA_CCI_Lookback(lookback));
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_CCI(startIdx, endIdx, highPtr + colOff, lowPtr + colOff, closePtr + colOff, lookback, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				cci_OUT = mxCreateDoubleMatrix(cciIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(cci_OUT)) + cciIdx, outReal, outElements * mxGetElementSize(cci_OUT));
-
-				// Cleanup
-				mxFree(outReal);
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *outPtr = mxGetPr(cci_OUT);
-
-				for (int iter = 0; iter < lookback; iter++)
-				{
-					outPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 
@@ -2373,54 +2378,100 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsC		= (int)mxGetN(close_IN);
 
 				// Validate
-				chkSingleVec(colsO, colsH, colsL, colsC, codeLine);
+				int cols = chkSameCols(colsO, colsH, colsL, colsC, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int cdlIdx, outElements;
 				int *outInt;
 
-				// Preallocate heap
-				outInt	= (int*)mxCalloc(rows, sizeof(int));
-
+				// Outputs are allocated with each invocation below.  TA-Lib writes from outBegIdx (the lookback) onward
 				// Candlestick Pattern Switch
-				switch (s_mapStringValues[taFuncNameIn])
+				switch (taFunc)
 				{
 					case ta_cdl2crows:
 						{
-							retCode = TA_CDL2CROWS(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDL2CROWS_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDL2CROWS(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdl3blackcrows:   
 						{
-							retCode = TA_CDL3BLACKCROWS(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDL3BLACKCROWS_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDL3BLACKCROWS(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdl3inside:  
 						{
-							retCode = TA_CDL3INSIDE(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDL3INSIDE_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDL3INSIDE(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdl3linestrike: 
 						{
-							retCode = TA_CDL3LINESTRIKE(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDL3LINESTRIKE_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDL3LINESTRIKE(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdl3outside:
 						{
-							retCode = TA_CDL3OUTSIDE(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDL3OUTSIDE_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDL3OUTSIDE(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdl3starsinsouth:  
 						{
-							retCode = TA_CDL3STARSINSOUTH(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDL3STARSINSOUTH_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDL3STARSINSOUTH(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdl3whitesoldiers:   
 						{
-							retCode = TA_CDL3WHITESOLDIERS(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDL3WHITESOLDIERS_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDL3WHITESOLDIERS(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}			
 					case ta_cdlabandonedbaby:
@@ -2457,42 +2508,91 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 								pctPen = .3;
 							}
 
-							switch (s_mapStringValues[taFuncNameIn])
+							switch (taFunc)
 							{
 								case ta_cdlabandonedbaby:
 									{
-										retCode = TA_CDLABANDONEDBABY(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, pctPen, &cdlIdx, &outElements, outInt);
+										outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLABANDONEDBABY_Lookback(pctPen));
+										retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+										for (int col = 0; col < cols; col++)
+										{
+											int colOff = col * rows, colBegIdx, colElements;
+											taColCode(retCode, TA_CDLABANDONEDBABY(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, pctPen, &colBegIdx, &colElements, outInt + colOff));
+										}
 										break;
 									}
 
 								case ta_cdldarkcloudcover:
 									{
-										retCode = TA_CDLDARKCLOUDCOVER(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, pctPen, &cdlIdx, &outElements, outInt);
+										outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLDARKCLOUDCOVER_Lookback(pctPen));
+										retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+										for (int col = 0; col < cols; col++)
+										{
+											int colOff = col * rows, colBegIdx, colElements;
+											taColCode(retCode, TA_CDLDARKCLOUDCOVER(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, pctPen, &colBegIdx, &colElements, outInt + colOff));
+										}
 										break;
 									}
 								case ta_cdleveningdojistar:  
 									{
-										retCode = TA_CDLEVENINGDOJISTAR(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, pctPen, &cdlIdx, &outElements, outInt);
+										outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLEVENINGDOJISTAR_Lookback(pctPen));
+										retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+										for (int col = 0; col < cols; col++)
+										{
+											int colOff = col * rows, colBegIdx, colElements;
+											taColCode(retCode, TA_CDLEVENINGDOJISTAR(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, pctPen, &colBegIdx, &colElements, outInt + colOff));
+										}
 										break;
 									}
 								case ta_cdleveningstar:  
 									{
-										retCode = TA_CDLEVENINGSTAR(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, pctPen, &cdlIdx, &outElements, outInt);
+										outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLEVENINGSTAR_Lookback(pctPen));
+										retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+										for (int col = 0; col < cols; col++)
+										{
+											int colOff = col * rows, colBegIdx, colElements;
+											taColCode(retCode, TA_CDLEVENINGSTAR(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, pctPen, &colBegIdx, &colElements, outInt + colOff));
+										}
 										break;
 									}
 								case ta_cdlmathold:  
 									{
-										retCode = TA_CDLMATHOLD(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr,  pctPen, &cdlIdx, &outElements, outInt);
+										outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLMATHOLD_Lookback(pctPen));
+										retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+										for (int col = 0; col < cols; col++)
+										{
+											int colOff = col * rows, colBegIdx, colElements;
+											taColCode(retCode, TA_CDLMATHOLD(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, pctPen, &colBegIdx, &colElements, outInt + colOff));
+										}
 										break;
 									}
 								case ta_cdlmorningdojistar:  
 									{
-										retCode = TA_CDLMORNINGDOJISTAR(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, pctPen, &cdlIdx, &outElements, outInt);
+										outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLMORNINGDOJISTAR_Lookback(pctPen));
+										retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+										for (int col = 0; col < cols; col++)
+										{
+											int colOff = col * rows, colBegIdx, colElements;
+											taColCode(retCode, TA_CDLMORNINGDOJISTAR(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, pctPen, &colBegIdx, &colElements, outInt + colOff));
+										}
 										break;
 									}
 								case ta_cdlmorningstar:  
 									{
-										retCode = TA_CDLMORNINGSTAR(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, pctPen, &cdlIdx, &outElements, outInt);
+										outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLMORNINGSTAR_Lookback(pctPen));
+										retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+										for (int col = 0; col < cols; col++)
+										{
+											int colOff = col * rows, colBegIdx, colElements;
+											taColCode(retCode, TA_CDLMORNINGSTAR(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, pctPen, &colBegIdx, &colElements, outInt + colOff));
+										}
 										break;
 									}
 							}
@@ -2501,237 +2601,566 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 						}
 					case ta_cdladvanceblock:  
 						{
-							retCode = TA_CDLADVANCEBLOCK(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLADVANCEBLOCK_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLADVANCEBLOCK(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlbelthold:  
 						{
-							retCode = TA_CDLBELTHOLD(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLBELTHOLD_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLBELTHOLD(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlbreakaway:  
 						{
-							retCode = TA_CDLBREAKAWAY(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLBREAKAWAY_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLBREAKAWAY(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlclosingmarubozu:  
 						{
-							retCode = TA_CDLCLOSINGMARUBOZU(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLCLOSINGMARUBOZU_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLCLOSINGMARUBOZU(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlconcealbabyswall:  
 						{
-							retCode = TA_CDLCONCEALBABYSWALL(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLCONCEALBABYSWALL_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLCONCEALBABYSWALL(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlcounterattack:  
 						{
-							retCode = TA_CDLCOUNTERATTACK(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLCOUNTERATTACK_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLCOUNTERATTACK(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdldoji:  
 						{
-							retCode = TA_CDLDOJI(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLDOJI_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLDOJI(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdldojistar:  
 						{
-							retCode = TA_CDLDOJISTAR(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLDOJISTAR_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLDOJISTAR(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdldragonflydoji:  
 						{
-							retCode = TA_CDLDRAGONFLYDOJI(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLDRAGONFLYDOJI_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLDRAGONFLYDOJI(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlengulfing:  
 						{
-							retCode = TA_CDLENGULFING(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
-							break;
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLENGULFING_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLENGULFING(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
+							break;
 						}
 					case ta_cdlgapsidesidewhite:  
 						{
-							retCode = TA_CDLGAPSIDESIDEWHITE(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLGAPSIDESIDEWHITE_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLGAPSIDESIDEWHITE(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlgravestonedoji:  
 						{
-							retCode = TA_CDLGRAVESTONEDOJI(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLGRAVESTONEDOJI_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLGRAVESTONEDOJI(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlhammer:  
 						{
-							retCode = TA_CDLHAMMER(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLHAMMER_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLHAMMER(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlhangingman:  
 						{
-							retCode = TA_CDLHANGINGMAN(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLHANGINGMAN_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLHANGINGMAN(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlharami:  
 						{
-							retCode = TA_CDLHARAMI(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLHARAMI_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLHARAMI(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlharamicross:  
 						{
-							retCode = TA_CDLHARAMICROSS(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLHARAMICROSS_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLHARAMICROSS(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlhighwave:  
 						{
-							retCode = TA_CDLHIGHWAVE(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLHIGHWAVE_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLHIGHWAVE(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlhikkake:  
 						{
-							retCode = TA_CDLHIKKAKE(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLHIKKAKE_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLHIKKAKE(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlhikkakemod:  
 						{
-							retCode = TA_CDLHIKKAKEMOD(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLHIKKAKEMOD_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLHIKKAKEMOD(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlhomingpigeon:  
 						{
-							retCode = TA_CDLHIKKAKEMOD(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLHIKKAKEMOD_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLHIKKAKEMOD(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlidentical3crows:  
 						{
-							retCode = TA_CDLIDENTICAL3CROWS(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLIDENTICAL3CROWS_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLIDENTICAL3CROWS(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlinneck:  
 						{
-							retCode = TA_CDLINNECK(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLINNECK_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLINNECK(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlinvertedhammer:  
 						{
-							retCode = TA_CDLINVERTEDHAMMER(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLINVERTEDHAMMER_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLINVERTEDHAMMER(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlkicking:  
 						{
-							retCode = TA_CDLKICKING(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLKICKING_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLKICKING(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlkickingbylength:  
 						{
-							retCode = TA_CDLKICKINGBYLENGTH(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLKICKINGBYLENGTH_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLKICKINGBYLENGTH(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlladderbottom:  
 						{
-							retCode = TA_CDLLADDERBOTTOM(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLLADDERBOTTOM_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLLADDERBOTTOM(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdllongleggeddoji:  
 						{
-							retCode = TA_CDLLONGLEGGEDDOJI(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLLONGLEGGEDDOJI_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLLONGLEGGEDDOJI(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdllongline:  
 						{
-							retCode = TA_CDLLONGLINE(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLLONGLINE_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLLONGLINE(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlmarubozu:  
 						{
-							retCode = TA_CDLMARUBOZU(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLMARUBOZU_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLMARUBOZU(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlmatchinglow:  
 						{
-							retCode = TA_CDLMATCHINGLOW(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLMATCHINGLOW_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLMATCHINGLOW(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlonneck:  
 						{
-							retCode = TA_CDLONNECK(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLONNECK_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLONNECK(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlpiercing:  
 						{
-							retCode = TA_CDLPIERCING(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLPIERCING_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLPIERCING(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlrickshawman:  
 						{
-							retCode = TA_CDLRICKSHAWMAN(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLRICKSHAWMAN_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLRICKSHAWMAN(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlrisefall3methods:  
 						{
-							retCode = TA_CDLRISEFALL3METHODS(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLRISEFALL3METHODS_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLRISEFALL3METHODS(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlseparatinglines:  
 						{
-							retCode = TA_CDLSEPARATINGLINES(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLSEPARATINGLINES_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLSEPARATINGLINES(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlshootingstar:  
 						{
-							retCode = TA_CDLSHOOTINGSTAR(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLSHOOTINGSTAR_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLSHOOTINGSTAR(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlshortline:  
 						{
-							retCode = TA_CDLSHORTLINE(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLSHORTLINE_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLSHORTLINE(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlspinningtop:  
 						{
-							retCode = TA_CDLSPINNINGTOP(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLSPINNINGTOP_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLSPINNINGTOP(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlstalledpattern:  
 						{
-							retCode = TA_CDLSTALLEDPATTERN(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLSTALLEDPATTERN_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLSTALLEDPATTERN(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlsticksandwich:  
 						{
-							retCode = TA_CDLSTICKSANDWICH(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLSTICKSANDWICH_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLSTICKSANDWICH(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdltakuri:  
 						{
-							retCode = TA_CDLTAKURI(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLTAKURI_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLTAKURI(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdltasukigap:  
 						{
-							retCode = TA_CDLTASUKIGAP(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLTASUKIGAP_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLTASUKIGAP(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlthrusting:  
 						{
-							retCode = TA_CDLTHRUSTING(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLTHRUSTING_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLTHRUSTING(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdltristar:  
 						{
-							retCode = TA_CDLTRISTAR(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLTRISTAR_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLTRISTAR(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlunique3river:  
 						{
-							retCode = TA_CDLUNIQUE3RIVER(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLUNIQUE3RIVER_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLUNIQUE3RIVER(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlupsidegap2crows:  
 						{
-							retCode = TA_CDLUPSIDEGAP2CROWS(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLUPSIDEGAP2CROWS_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLUPSIDEGAP2CROWS(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}
 					case ta_cdlxsidegap3methods:  
 						{
-							retCode = TA_CDLXSIDEGAP3METHODS(startIdx, endIdx, openPtr, highPtr, lowPtr, closePtr, &cdlIdx, &outElements, outInt);
+							outInt = taAllocIntOut(cdl_OUT, rows, cols, TA_CDLXSIDEGAP3METHODS_Lookback());
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_CDLXSIDEGAP3METHODS(startIdx, endIdx, openPtr + colOff, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+							}
 							break;
 						}					
 				}
@@ -2739,18 +3168,10 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outInt);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				cdl_OUT = mxCreateNumericMatrix(cdlIdx + outElements,1, mxINT32_CLASS, mxREAL);
-				memcpy((int*)(mxGetData(cdl_OUT)) + cdlIdx, outInt, outElements * mxGetElementSize(cdl_OUT));
-
-				// Cleanup
-				mxFree(outInt); 
-
 				break;
 			}
 
@@ -2794,40 +3215,33 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 				rows		= (int)mxGetM(data_IN);
 
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_ceil:InputErr",
-						"Observation data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *outReal;
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(ceil_OUT, rows, cols, TA_CEIL_Lookback());
 
 				// Invoke with error catch
-				retCode = TA_CEIL(startIdx, endIdx, dataPtr, &dataIdx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_CEIL(startIdx, endIdx, dataPtr + colOff, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgTxt("Invocation to 'ta_ceil' failed. Aborting (2562).");
 				}
 
-				// Populate Output
-				ceil_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(ceil_OUT)) + dataIdx, outReal, outElements * mxGetElementSize(ceil_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
 				break;
 			}
 			
@@ -2872,17 +3286,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 
 				// Validation
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_cmo:InputErr",
-						"Observation data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int cmoIdx, outElements;
 				double *outReal;
 
 				// Get optional input or assign default
@@ -2903,36 +3312,25 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					lookback = 14;
 				}
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(cmo_OUT, rows, cols, TA_CMO_Lookback(lookback));
 
 				// Invoke with error catch
-				retCode = TA_CMO(startIdx, endIdx, dataPtr, lookback, &cmoIdx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_CMO(startIdx, endIdx, dataPtr + colOff, lookback, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				cmo_OUT = mxCreateDoubleMatrix(cmoIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(cmo_OUT)) + cmoIdx, outReal, outElements * mxGetElementSize(cmo_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *outPtr = mxGetPr(cmo_OUT);
-
-				for (int iter = 0; iter < lookback; iter++)
-				{
-					outPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 			
@@ -2982,17 +3380,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsB		= (int)mxGetN(obvB_IN);
 
 				// Validate
-				if (colsA != 1 || colsB != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_correl:InputErr",
-						"Observational data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsA, colsB, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int corrIdx, outElements;
 				double *outReal;
 
 				// Get optional input or assign default
@@ -3013,36 +3406,25 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					lookback = 30;
 				}
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(corr_OUT, rows, cols, TA_CORREL_Lookback(lookback));
 
 				// Invoke with error catch
-				retCode = TA_CORREL(startIdx, endIdx, obsAPtr, obsBPtr, lookback, &corrIdx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_CORREL(startIdx, endIdx, obsAPtr + colOff, obsBPtr + colOff, lookback, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				corr_OUT = mxCreateDoubleMatrix(corrIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(corr_OUT)) + corrIdx, outReal, outElements * mxGetElementSize(corr_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *outPtr = mxGetPr(corr_OUT);
-
-				for (int iter = 0; iter < lookback; iter++)
-				{
-					outPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 
@@ -3087,40 +3469,33 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsT		= (int)mxGetN(theta_IN);
 				rows		= (int)mxGetM(theta_IN);
 
-				if (colsT != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_cos:InputErr",
-						"Angle observations should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsT, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int cosIdx, outElements;
 				double *outReal;
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(cos_OUT, rows, cols, TA_COS_Lookback());
 
 				// Invoke with error catch
-				retCode = TA_COS(startIdx, endIdx, thetaPtr, &cosIdx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_COS(startIdx, endIdx, thetaPtr + colOff, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgTxt("Invocation to 'ta_cos' failed. Aborting (2856).");
 				}
 
-				// Populate Output
-				cos_OUT = mxCreateDoubleMatrix(cosIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(cos_OUT)) + cosIdx, outReal, outElements * mxGetElementSize(cos_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
 				break;
 			}
 
@@ -3165,40 +3540,33 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsT		= (int)mxGetN(theta_IN);
 				rows		= (int)mxGetM(theta_IN);
 
-				if (colsT != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_cosh:InputErr",
-						"Angle observations should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsT, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int coshIdx, outElements;
 				double *outReal;
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(cos_OUT, rows, cols, TA_COSH_Lookback());
 
 				// Invoke with error catch
-				retCode = TA_COSH(startIdx, endIdx, thetaPtr, &coshIdx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_COSH(startIdx, endIdx, thetaPtr + colOff, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgTxt("Invocation to 'ta_cosh' failed. Aborting (2935).");
 				}
 
-				// Populate Output
-				cosh_OUT = mxCreateDoubleMatrix(coshIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(cos_OUT)) + coshIdx, outReal, outElements * mxGetElementSize(cosh_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
 				break;
 			}
 		
@@ -3244,17 +3612,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 
 				// Validate
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_dema:InputErr",
-						"Observational data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *outReal;
 
 				// Get optional input or assign default
@@ -3281,36 +3644,25 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					lookback = 30;
 				}
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(dema_OUT, rows, cols, TA_DEMA_Lookback(lookback));
 
 				// Invoke with error catch
-				retCode = TA_DEMA(startIdx, endIdx, dataPtr, lookback, &dataIdx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_DEMA(startIdx, endIdx, dataPtr + colOff, lookback, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				dema_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(dema_OUT)) + dataIdx, outReal, outElements * mxGetElementSize(dema_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *outPtr = mxGetPr(dema_OUT);
-
-				for (int iter = (lookback * 2) - 1; iter < lookback; iter++)
-				{
-					outPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 			
@@ -3355,45 +3707,31 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				divisPtr		= mxGetPr(divis_IN);
 				colsDV			= (int)mxGetN(divis_IN);
 
-				if (colsDD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:InputErr",
-						"Vector division inputs should be single dimensional vectors.\nThe dividend vector has more than 1 column.  Aborting (%d).", codeLine);
-				}
-
-				if (colsDV != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:InputErr",
-						"Vector division inputs should be single dimensional vectors.\nThe divisor vector had more than 1 column.  Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsDD, colsDV, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int quotIdx, outElements;
 				double *quotient;
 
-				// Preallocate heap
-				quotient = (double*)mxCalloc(rows, sizeof(double));
-
-				retCode = TA_DIV(startIdx, endIdx, dividPtr, divisPtr, &quotIdx, &outElements, quotient);
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				quotient = taAllocOut(quot_OUT, rows, cols, TA_DIV_Lookback());
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_DIV(startIdx, endIdx, dividPtr + colOff, divisPtr + colOff, &colBegIdx, &colElements, quotient + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(quotient);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				quot_OUT = mxCreateDoubleMatrix(quotIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(quot_OUT)) + quotIdx, quotient, outElements * mxGetElementSize(quot_OUT));
-
-				// Cleanup
-				mxFree(quotient); 
-
 				break;
 			}
 
@@ -3447,13 +3785,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsC		= (int)mxGetN(close_IN);
 
 				// Validate
-				chkSingleVec(colsH, colsL, colsC, codeLine);
+				int cols = chkSameCols(colsH, colsL, colsC, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *outReal;
 
 				// Parse optional inputs if given, else default 
@@ -3482,35 +3819,23 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				}
 
 
-				// Preallocate heap
-				outReal	= (double*)mxCalloc(rows, sizeof(double));
-
-				retCode = TA_DX(startIdx, endIdx, highPtr, lowPtr, closePtr, lookback, &dataIdx, &outElements, outReal);
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(dx_OUT, rows, cols, TA_DX_Lookback(lookback));
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_DX(startIdx, endIdx, highPtr + colOff, lowPtr + colOff, closePtr + colOff, lookback, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				dx_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(dx_OUT)) + dataIdx, outReal, outElements * mxGetElementSize(dx_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *dxPtr = mxGetPr(dx_OUT);
-
-				for (int iter = 0; iter < lookback; iter++)
-				{
-					dxPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 			
@@ -3556,17 +3881,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 
 				// Validate
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_ema:InputErr",
-						"Observational data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *outReal;
 
 				// Get optional input or assign default
@@ -3593,36 +3913,25 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					lookback = 30;
 				}
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(ema_OUT, rows, cols, TA_EMA_Lookback(lookback));
 
 				// Invoke with error catch
-				retCode = TA_EMA(startIdx, endIdx, dataPtr, lookback, &dataIdx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_EMA(startIdx, endIdx, dataPtr + colOff, lookback, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				ema_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(ema_OUT)) + dataIdx, outReal, outElements * mxGetElementSize(ema_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *outPtr = mxGetPr(ema_OUT);
-
-				for (int iter = 0; iter < lookback; iter++)
-				{
-					outPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 
@@ -3669,40 +3978,33 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 
 				// Validate
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_exp:InputErr",
-						"Observational data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *outReal;
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(e_OUT, rows, cols, TA_EXP_Lookback());
 
 				// Invoke with error catch
-				retCode = TA_EXP(startIdx, endIdx, dataPtr, &dataIdx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_EXP(startIdx, endIdx, dataPtr + colOff, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				e_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(e_OUT)) + dataIdx, outReal, outElements * mxGetElementSize(e_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
 				break;
 			}
 
@@ -3746,40 +4048,33 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 				rows		= (int)mxGetM(data_IN);
 
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_floor:InputErr",
-						"Observation data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *outReal;
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(ceil_OUT, rows, cols, TA_FLOOR_Lookback());
 
 				// Invoke with error catch
-				retCode = TA_FLOOR(startIdx, endIdx, dataPtr, &dataIdx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_FLOOR(startIdx, endIdx, dataPtr + colOff, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgTxt("Invocation to 'ta_floor' failed. Aborting (3458).");
 				}
 
-				// Populate Output
-				ceil_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(ceil_OUT)) + dataIdx, outReal, outElements * mxGetElementSize(ceil_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
 				break;
 			}
 
@@ -3823,11 +4118,7 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 				rows		= (int)mxGetM(data_IN);
 
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_ht_dcperiod:InputErr",
-						"Observation data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				if (rows < 33)
 				{
@@ -3839,39 +4130,27 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *outReal;
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(period_OUT, rows, cols, TA_HT_DCPERIOD_Lookback());
 
 				// Invoke with error catch
-				retCode = TA_HT_DCPERIOD(startIdx, endIdx, dataPtr, &dataIdx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_HT_DCPERIOD(startIdx, endIdx, dataPtr + colOff, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgTxt("Invocation to 'ta_ht_dcperiod' failed. Aborting (3536).");
 				}
 
-				// Populate Output
-				period_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(period_OUT)) + dataIdx, outReal, outElements * mxGetElementSize(period_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *outPtr = mxGetPr(period_OUT);
-
-				for (int iter = 0; iter < 32; iter++)
-				{
-					outPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 
@@ -3915,11 +4194,7 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 				rows		= (int)mxGetM(data_IN);
 
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_ht_dcphase:InputErr",
-						"Observation data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				if (rows < 64)
 				{
@@ -3931,39 +4206,27 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *outReal;
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(phase_OUT, rows, cols, TA_HT_DCPHASE_Lookback());
 
 				// Invoke with error catch
-				retCode = TA_HT_DCPHASE(startIdx, endIdx, dataPtr, &dataIdx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_HT_DCPHASE(startIdx, endIdx, dataPtr + colOff, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgTxt("Invocation to 'ta_ht_dcperiod' failed. Aborting (3536).");
 				}
 
-				// Populate Output
-				phase_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(phase_OUT)) + dataIdx, outReal, outElements * mxGetElementSize(phase_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *outPtr = mxGetPr(phase_OUT);
-
-				for (int iter = 0; iter < 63; iter++)
-				{
-					outPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 		
@@ -4014,11 +4277,7 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 				rows		= (int)mxGetM(data_IN);
 
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_ht_phasor:InputErr",
-						"Observation data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				if (rows < 33)
 				{
@@ -4030,46 +4289,29 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *inPhase, *quad;
 
-				// Preallocate heap
-				inPhase = (double*)mxCalloc(rows, sizeof(double));
-				quad = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the outputs up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				int outBeg = TA_HT_PHASOR_Lookback();
+				inPhase = taAllocOut(inPhase_OUT, rows, cols, outBeg);
+				quad = taAllocOut(quad_OUT, rows, cols, outBeg);
 
 				// Invoke with error catch
-				retCode = TA_HT_PHASOR(startIdx, endIdx, dataPtr, &dataIdx, &outElements, inPhase, quad);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_HT_PHASOR(startIdx, endIdx, dataPtr + colOff, &colBegIdx, &colElements, inPhase + colOff, quad + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(inPhase);
-					mxFree(quad);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgTxt("Invocation to 'ta_ht_dcperiod' failed. Aborting (3736).");
 				}
 
-				// Populate Output
-				inPhase_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				quad_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(inPhase_OUT)) + dataIdx, inPhase, outElements * mxGetElementSize(inPhase_OUT));
-				memcpy(((double *) mxGetData(quad_OUT)) + dataIdx, quad, outElements * mxGetElementSize(quad_OUT));
-
-				// Cleanup
-				mxFree(inPhase); 
-				mxFree(quad); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *inPhasePtr = mxGetPr(inPhase_OUT);
-				double *quadPtr = mxGetPr(quad_OUT);
-
-				for (int iter = 0; iter < 32; iter++)
-				{
-					inPhasePtr[iter] = m_Nan;
-					quadPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 
@@ -4138,11 +4380,7 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 				rows		= (int)mxGetM(data_IN);
 
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_ht_phasor:InputErr",
-						"Observation data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				if (rows < 64)
 				{
@@ -4154,46 +4392,29 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *sine, *leadSine;
 
-				// Preallocate heap
-				sine = (double*)mxCalloc(rows, sizeof(double));
-				leadSine = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the outputs up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				int outBeg = TA_HT_SINE_Lookback();
+				sine = taAllocOut(sine_OUT, rows, cols, outBeg);
+				leadSine = taAllocOut(leadSine_OUT, rows, cols, outBeg);
 
 				// Invoke with error catch
-				retCode = TA_HT_SINE(startIdx, endIdx, dataPtr, &dataIdx, &outElements, sine, leadSine);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_HT_SINE(startIdx, endIdx, dataPtr + colOff, &colBegIdx, &colElements, sine + colOff, leadSine + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(sine);
-					mxFree(leadSine);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgTxt("Invocation to 'ta_ht_sine' failed. Aborting (3861).");
 				}
 
-				// Populate Output
-				sine_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				leadSine_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(sine_OUT)) + dataIdx, sine, outElements * mxGetElementSize(sine_OUT));
-				memcpy(((double *) mxGetData(leadSine_OUT)) + dataIdx, leadSine, outElements * mxGetElementSize(leadSine_OUT));
-
-				// Cleanup
-				mxFree(sine); 
-				mxFree(leadSine); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *sinePtr = mxGetPr(sine_OUT);
-				double *leadSinePtr = mxGetPr(leadSine_OUT);
-
-				for (int iter = 0; iter < 63; iter++)
-				{
-					sinePtr[iter] = m_Nan;
-					leadSinePtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 
@@ -4237,11 +4458,7 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 				rows		= (int)mxGetM(data_IN);
 
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_ht_trendline:InputErr",
-						"Observation data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				if (rows < 64)
 				{
@@ -4253,39 +4470,27 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *outReal;
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(trend_OUT, rows, cols, TA_HT_TRENDLINE_Lookback());
 
 				// Invoke with error catch
-				retCode = TA_HT_TRENDLINE(startIdx, endIdx, dataPtr, &dataIdx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_HT_TRENDLINE(startIdx, endIdx, dataPtr + colOff, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgTxt("Invocation to 'ta_ht_trendline' failed. Aborting (3959).");
 				}
 
-				// Populate Output
-				trend_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(trend_OUT)) + dataIdx, outReal, outElements * mxGetElementSize(trend_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *outPtr = mxGetPr(trend_OUT);
-
-				for (int iter = 0; iter < 63; iter++)
-				{
-					outPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 
@@ -4329,11 +4534,7 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 				rows		= (int)mxGetM(data_IN);
 
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_ht_trendmode:InputErr",
-						"Observation data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				if (rows < 64)
 				{
@@ -4345,39 +4546,27 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				int *outInt;
 
-				// Preallocate heap
-				outInt = (int*)mxCalloc(rows, sizeof(int));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outInt = taAllocIntOut(mode_OUT, rows, cols, TA_HT_TRENDMODE_Lookback());
 
 				// Invoke with error catch
-				retCode = TA_HT_TRENDMODE(startIdx, endIdx, dataPtr, &dataIdx, &outElements, outInt);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_HT_TRENDMODE(startIdx, endIdx, dataPtr + colOff, &colBegIdx, &colElements, outInt + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outInt);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgTxt("Invocation to 'ta_ht_trendmode' failed. Aborting (4046).");
 				}
 
-				// Populate Output
-				mode_OUT = mxCreateNumericMatrix(dataIdx + outElements,1, mxINT32_CLASS, mxREAL);
-				memcpy(((int *) mxGetData(mode_OUT)) + dataIdx, outInt, outElements * mxGetElementSize(mode_OUT));
-
-				// Cleanup
-				mxFree(outInt); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *outPtr = mxGetPr(trend_OUT);
-
-				for (int iter = 0; iter < 63; iter++)
-				{
-					outPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 
@@ -4423,17 +4612,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 
 				// Validate
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_kama:InputErr",
-						"Observational data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *outReal;
 
 				// Get optional input or assign default
@@ -4460,36 +4644,25 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					lookback = 30;
 				}
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(kama_OUT, rows, cols, TA_KAMA_Lookback(lookback));
 
 				// Invoke with error catch
-				retCode = TA_KAMA(startIdx, endIdx, dataPtr, lookback, &dataIdx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_KAMA(startIdx, endIdx, dataPtr + colOff, lookback, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				kama_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(kama_OUT)) + dataIdx, outReal, outElements * mxGetElementSize(kama_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *outPtr = mxGetPr(kama_OUT);
-
-				for (int iter = 0; iter < lookback; iter++)
-				{
-					outPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 
@@ -4535,17 +4708,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 
 				// Validate
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_linearreg:InputErr",
-						"Observational data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *outReal;
 
 				// Get optional input or assign default
@@ -4572,36 +4740,25 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					lookback = 14;
 				}
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(linreg_OUT, rows, cols, TA_LINEARREG_Lookback(lookback));
 
 				// Invoke with error catch
-				retCode = TA_LINEARREG(startIdx, endIdx, dataPtr, lookback, &dataIdx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_LINEARREG(startIdx, endIdx, dataPtr + colOff, lookback, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				linreg_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(linreg_OUT)) + dataIdx, outReal, outElements * mxGetElementSize(linreg_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *outPtr = mxGetPr(linreg_OUT);
-
-				for (int iter = 0; iter < lookback; iter++)
-				{
-					outPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 
@@ -4659,17 +4816,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 
 				// Validate
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_linearreg_angle:InputErr",
-						"Observational data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *outReal;
 
 				// Get optional input or assign default
@@ -4696,36 +4848,25 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					lookback = 14;
 				}
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(linrega_OUT, rows, cols, TA_LINEARREG_ANGLE_Lookback(lookback));
 
 				// Invoke with error catch
-				retCode = TA_LINEARREG_ANGLE(startIdx, endIdx, dataPtr, lookback, &dataIdx, &outElements, outReal);
-
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_LINEARREG_ANGLE(startIdx, endIdx, dataPtr + colOff, lookback, &colBegIdx, &colElements, outReal + colOff));
+				}
+
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				linrega_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(linrega_OUT)) + dataIdx, outReal, outElements * mxGetElementSize(linrega_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *outPtr = mxGetPr(linrega_OUT);
-
-				for (int iter = 0; iter < lookback; iter++)
-				{
-					outPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 
@@ -4783,17 +4924,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 
 				// Validate
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_linearreg_intercept:InputErr",
-						"Observational data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *outReal;
 
 				// Get optional input or assign default
@@ -4820,36 +4956,25 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					lookback = 14;
 				}
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(linregi_OUT, rows, cols, TA_LINEARREG_INTERCEPT_Lookback(lookback));
 
 				// Invoke with error catch
-				retCode = TA_LINEARREG_INTERCEPT(startIdx, endIdx, dataPtr, lookback, &dataIdx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_LINEARREG_INTERCEPT(startIdx, endIdx, dataPtr + colOff, lookback, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				linregi_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(linregi_OUT)) + dataIdx, outReal, outElements * mxGetElementSize(linregi_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *outPtr = mxGetPr(linregi_OUT);
-
-				for (int iter = 0; iter < lookback; iter++)
-				{
-					outPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 
@@ -4907,17 +5032,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 
 				// Validate
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_linearreg_slope:InputErr",
-						"Observational data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *outReal;
 
 				// Get optional input or assign default
@@ -4944,36 +5064,25 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					lookback = 14;
 				}
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(linregs_OUT, rows, cols, TA_LINEARREG_SLOPE_Lookback(lookback));
 
 				// Invoke with error catch
-				retCode = TA_LINEARREG_SLOPE(startIdx, endIdx, dataPtr, lookback, &dataIdx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_LINEARREG_SLOPE(startIdx, endIdx, dataPtr + colOff, lookback, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				linregs_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(linregs_OUT)) + dataIdx, outReal, outElements * mxGetElementSize(linregs_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *outPtr = mxGetPr(linregs_OUT);
-
-				for (int iter = 0; iter < lookback; iter++)
-				{
-					outPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 
@@ -5017,40 +5126,33 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 				rows		= (int)mxGetM(data_IN);
 
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_acos:InputErr",
-						"Cosine data should be a single vector array. Aborting (%d).",codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int lnIdx, outElements;
 				double *outReal;
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(ln_OUT, rows, cols, TA_LN_Lookback());
 
 				// Invoke with error catch
-				retCode = TA_LN(startIdx, endIdx, dataPtr, &lnIdx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_LN(startIdx, endIdx, dataPtr + colOff, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgTxt("Invocation to 'ta_ln' failed. Aborting (4735).");
 				}
 
-				// Populate Output
-				ln_OUT = mxCreateDoubleMatrix(lnIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(ln_OUT)) + lnIdx, outReal, outElements * mxGetElementSize(ln_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
 				break;
 			}
 
@@ -5094,40 +5196,33 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 				rows		= (int)mxGetM(data_IN);
 
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_log10:InputErr",
-						"Input data should be a single vector array. Aborting (%d).",codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int log10Idx, outElements;
 				double *outReal;
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(log10_OUT, rows, cols, TA_LOG10_Lookback());
 
 				// Invoke with error catch
-				retCode = TA_LOG10(startIdx, endIdx, dataPtr, &log10Idx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_LOG10(startIdx, endIdx, dataPtr + colOff, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgTxt("Invocation to 'ta_log10' failed. Aborting (4813).");
 				}
 
-				// Populate Output
-				log10_OUT = mxCreateDoubleMatrix(log10Idx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(log10_OUT)) + log10Idx, outReal, outElements * mxGetElementSize(log10_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
 				break;
 			}
 
@@ -5139,7 +5234,7 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 
 				// OPTIONAL INPUTS
 				//		Lookback	lookback period	(default 14)
-				//		typeMA		Moving average calculation type:
+				//		typeMA		Moving average calculation type (default 0):
 				//						0	-	Simple Moving Average				SMA	(default)
 				//						1	-	Exponential Moving Average			EMA
 				//						2	-	Weighted Moving Average				WMA
@@ -5150,8 +5245,11 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				//						7	-	MESA Adaptive Moving Average		MAMA
 				//						8	-	Triple Exponential Moving Average	T3	
 
+				//		Either may be a vector to evaluate a grid of K = numel(Lookback) * numel(typeMA) averages in
+				//		one call.  Lookback varies fastest: column k is Lookback(mod(k-1,numLb)+1), typeMA(floor((k-1)/numLb)+1)
+
 				// OUTPUT
-				//		MA			vector of simple moving average values
+				//		MA			vector of moving average values.  N x K for K averages or N x M x K for M instruments.
 
 				// Strings for validation
 				taFuncDesc = "Moving average";
@@ -5172,7 +5270,8 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				#define ma_OUT		plhs[0]
 
 				// Declare variables
-				int startIdx, endIdx, rows, colsD, lookback, typeMA;
+				int startIdx, endIdx, rows, colsD, numLb, numTypes;
+				int *lookbacks, *typesMA;
 				double *dataPtr;
 
 				// Initialize error handling 
@@ -5185,92 +5284,102 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 
 				// Validate
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_ma:InputErr",
-						"Observational data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *outReal;
 
 				// Get optional input or assign default
 				if (nrhs > 2) 
 				{
 					#define lookback_IN	prhs[2]
-					if (!isRealScalar(lookback_IN))
-						mexErrMsgIdAndTxt( "MATLAB:taInvoke:inputErr",
-						"The MOVING AVERAGE lookback must be a scalar. Aborting (%d).", codeLine);
-
-					/* Get the scalar input lookback */
-					// Assign
-					lookback = (int)mxGetScalar(lookback_IN);
-
-					if(lookback < 1)
-					{
+					numLb = taGetParams(lookback_IN, lookbacks);
+					if (numLb == 0)
 						mexErrMsgIdAndTxt( "MATLAB:taInvoke:inputErr",
-							"The MOVING AVERAGE lookback must be a scalar with a value of 1 or greater. Aborting (%d).", codeLine);
-					}
+						"The MOVING AVERAGE lookback must be a scalar or a vector. Aborting (%d).", codeLine);
 
-					if(nrhs == 4)
+					for (int iter = 0; iter < numLb; iter++)
 					{
-						#define typeMA_IN	prhs[3]
-						if (!isRealScalar(typeMA_IN))
+						if(lookbacks[iter] < 1)
+						{
 							mexErrMsgIdAndTxt( "MATLAB:taInvoke:inputErr",
-							"The %s typeMA must be a scalar. Aborting (%d).", taFuncDesc, codeLine);
-
-						/* Get the scalar input typeMA */
-						// Assign
-						typeMA = (int)mxGetScalar(typeMA_IN);
-					}
-					else
-					{
-						typeMA = 0;
+								"The MOVING AVERAGE lookback must have values of 1 or greater. Aborting (%d).", codeLine);
+						}
 					}
 				}
 				else
 				{
-					typeMA = 0;
-					lookback = 14;
+					numLb = 1;
+					lookbacks = (int*)mxMalloc(sizeof(int));
+					lookbacks[0] = 14;
+				}
+
+				if(nrhs == 4)
+				{
+					#define typeMA_IN	prhs[3]
+					numTypes = taGetParams(typeMA_IN, typesMA);
+					if (numTypes == 0)
+						mexErrMsgIdAndTxt( "MATLAB:taInvoke:inputErr",
+						"The %s typeMA must be a scalar or a vector. Aborting (%d).", taFuncDesc, codeLine);
+				}
+				else
+				{
+					numTypes = 1;
+					typesMA = (int*)mxMalloc(sizeof(int));
+					typesMA[0] = 0;
 				}
 
 				// Validate
-				typeMAcheck(taFuncNameIn, taFuncDesc, taFuncOptName, typeMA);
+				for (int iter = 0; iter < numTypes; iter++)
+				{
+					typeMAcheck(taFuncNameIn, taFuncDesc, taFuncOptName, typesMA[iter]);
+				}
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  Each average is written from its own outBegIdx onward
+				int numMA = numLb * numTypes;
+				int *outBeg = (int*)mxMalloc(numMA * sizeof(int));
+				for (int iter = 0; iter < numMA; iter++)
+				{
+					outBeg[iter] = min(TA_MA_Lookback(lookbacks[iter % numLb], (TA_MAType)typesMA[iter / numLb]), rows);
+				}
+				outReal = taAllocGridOut(ma_OUT, rows, cols, numMA, outBeg);
 
 				// Invoke with error catch
-				retCode = TA_MA(startIdx, endIdx, dataPtr, lookback, (TA_MAType)typeMA, &dataIdx, &outElements, outReal);
+				// Columns of the grid (average, instrument) are independent.  Column 'job' begins at job * rows.
+				int numJobs = numMA * cols;
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (numJobs > 1)
+				for (int job = 0; job < numJobs; job++)
+				{
+					int col = job % cols, kk = job / cols;
+					int lookback = lookbacks[kk % numLb], typeMA = typesMA[kk / numLb];
+
+					// Simple averages of a grid keep a rolling window sum rather than a call per average
+					if (numMA > 1 && typeMA == TA_MAType_SMA)
+					{
+						taRollSums(dataPtr + col * rows, rows, lookback, taRollMean, 1, outReal + job * rows);
+					}
+					else
+					{
+						int colBegIdx, colElements;
+						taColCode(retCode, TA_MA(startIdx, endIdx, dataPtr + col * rows, lookback, (TA_MAType)typeMA, &colBegIdx, &colElements, outReal + job * rows + outBeg[kk]));
+					}
+				}
+
+				mxFree(outBeg);
+				mxFree(lookbacks);
+				mxFree(typesMA);
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				ma_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(ma_OUT)) + dataIdx, outReal, outElements * mxGetElementSize(ma_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *outPtr = mxGetPr(ma_OUT);
-
-				for (int iter = 0; iter < lookback; iter++)
-				{
-					outPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 
@@ -5325,17 +5434,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 
 				// Validate
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_macd:InputErr",
-						"Observational data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *macd, *macdSig, *macdHist;
 
 				// Parse optional inputs if given, else default 
@@ -5412,53 +5516,26 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					}
 				}
 
-				// Preallocate heap
-				macd		= (double*)mxCalloc(rows, sizeof(double));
-				macdSig		= (double*)mxCalloc(rows, sizeof(double));
-				macdHist	= (double*)mxCalloc(rows, sizeof(double));
-
-				retCode = TA_MACD(startIdx, endIdx, dataPtr, fastMA, slowMA, smoothP, &dataIdx, &outElements, macd, macdSig, macdHist);
+				// Allocate the outputs up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				int outBeg = TA_MACD_Lookback(fastMA, slowMA, smoothP);
+				macd = taAllocOut(macd_OUT, rows, cols, outBeg);
+				macdSig = taAllocOut(macdSig_OUT, rows, cols, outBeg);
+				macdHist = taAllocOut(macdHist_OUT, rows, cols, outBeg);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_MACD(startIdx, endIdx, dataPtr + colOff, fastMA, slowMA, smoothP, &colBegIdx, &colElements, macd + colOff, macdSig + colOff, macdHist + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(macd);
-					mxFree(macdSig);
-					mxFree(macdHist);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				macd_OUT		= mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				macdSig_OUT		= mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				macdHist_OUT	= mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(macd_OUT)) + dataIdx, macd, outElements * mxGetElementSize(macd_OUT));
-				memcpy(((double *) mxGetData(macdSig_OUT)) + dataIdx, macdSig, outElements * mxGetElementSize(macdSig_OUT));
-				memcpy(((double *) mxGetData(macdHist_OUT)) + dataIdx, macdHist, outElements * mxGetElementSize(macdHist_OUT));
-
-				// Cleanup
-				mxFree(macd); 
-				mxFree(macdSig); 
-				mxFree(macdHist); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *macdPtr = mxGetPr(macd_OUT);
-				double *macdSigPtr = mxGetPr(macdSig_OUT);
-				double *macdHistPtr = mxGetPr(macdHist_OUT);
-
-				for (int iter = 0; iter < slowMA; iter++)
-				{
-					macdPtr[iter] = m_Nan;
-					macdSigPtr[iter] = m_Nan;
-				}
-
-				for (int iter = 0; iter < smoothP; iter++)
-				{
-					macdHistPtr[iter] = m_Nan;
-				}
-									
 				break;
 			}
 
@@ -5518,17 +5595,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 
 				// Validate
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_macdext:InputErr",
-						"Observational data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *macd, *macdSig, *macdHist;
 
 				// Parse optional inputs if given, else default 
@@ -5630,53 +5702,26 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					}
 				}
 
-				// Preallocate heap
-				macd		= (double*)mxCalloc(rows, sizeof(double));
-				macdSig		= (double*)mxCalloc(rows, sizeof(double));
-				macdHist	= (double*)mxCalloc(rows, sizeof(double));
-
-				retCode = TA_MACDEXT(startIdx, endIdx, dataPtr, fastMA, (TA_MAType)fastType, slowMA, (TA_MAType)slowType, smoothP, (TA_MAType)smoothType, &dataIdx, &outElements, macd, macdSig, macdHist);
+				// Allocate the outputs up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				int outBeg = TA_MACDEXT_Lookback(fastMA, (TA_MAType)fastType, slowMA, (TA_MAType)slowType, smoothP, (TA_MAType)smoothType);
+				macd = taAllocOut(macd_OUT, rows, cols, outBeg);
+				macdSig = taAllocOut(macdSig_OUT, rows, cols, outBeg);
+				macdHist = taAllocOut(macdHist_OUT, rows, cols, outBeg);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_MACDEXT(startIdx, endIdx, dataPtr + colOff, fastMA, (TA_MAType)fastType, slowMA, (TA_MAType)slowType, smoothP, (TA_MAType)smoothType, &colBegIdx, &colElements, macd + colOff, macdSig + colOff, macdHist + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(macd);
-					mxFree(macdSig);
-					mxFree(macdHist);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				macd_OUT		= mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				macdSig_OUT		= mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				macdHist_OUT	= mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(macd_OUT)) + dataIdx, macd, outElements * mxGetElementSize(macd_OUT));
-				memcpy(((double *) mxGetData(macdSig_OUT)) + dataIdx, macdSig, outElements * mxGetElementSize(macdSig_OUT));
-				memcpy(((double *) mxGetData(macdHist_OUT)) + dataIdx, macdHist, outElements * mxGetElementSize(macdHist_OUT));
-
-				// Cleanup
-				mxFree(macd); 
-				mxFree(macdSig); 
-				mxFree(macdHist); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *macdPtr = mxGetPr(macd_OUT);
-				double *macdSigPtr = mxGetPr(macdSig_OUT);
-				double *macdHistPtr = mxGetPr(macdHist_OUT);
-
-				for (int iter = 0; iter < slowMA; iter++)
-				{
-					macdPtr[iter] = m_Nan;
-					macdSigPtr[iter] = m_Nan;
-				}
-
-				for (int iter = 0; iter < smoothP; iter++)
-				{
-					macdHistPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 
@@ -5725,11 +5770,7 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 
 				// Validate
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_macdfix:InputErr",
-						"Observational data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				if (rows < 26)
 				{
@@ -5741,7 +5782,6 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *macd, *macdSig, *macdHist;
 
 				// Parse optional inputs if given, else default 
@@ -5771,53 +5811,26 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					smoothP = 9;
 				}
 
-				// Preallocate heap
-				macd		= (double*)mxCalloc(rows, sizeof(double));
-				macdSig		= (double*)mxCalloc(rows, sizeof(double));
-				macdHist	= (double*)mxCalloc(rows, sizeof(double));
-
-				retCode = TA_MACDFIX(startIdx, endIdx, dataPtr, smoothP, &dataIdx, &outElements, macd, macdSig, macdHist);
+				// Allocate the outputs up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				int outBeg = TA_MACDFIX_Lookback(smoothP);
+				macd = taAllocOut(macd_OUT, rows, cols, outBeg);
+				macdSig = taAllocOut(macdSig_OUT, rows, cols, outBeg);
+				macdHist = taAllocOut(macdHist_OUT, rows, cols, outBeg);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_MACDFIX(startIdx, endIdx, dataPtr + colOff, smoothP, &colBegIdx, &colElements, macd + colOff, macdSig + colOff, macdHist + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(macd);
-					mxFree(macdSig);
-					mxFree(macdHist);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				macd_OUT		= mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				macdSig_OUT		= mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				macdHist_OUT	= mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(macd_OUT)) + dataIdx, macd, outElements * mxGetElementSize(macd_OUT));
-				memcpy(((double *) mxGetData(macdSig_OUT)) + dataIdx, macdSig, outElements * mxGetElementSize(macdSig_OUT));
-				memcpy(((double *) mxGetData(macdHist_OUT)) + dataIdx, macdHist, outElements * mxGetElementSize(macdHist_OUT));
-
-				// Cleanup
-				mxFree(macd); 
-				mxFree(macdSig); 
-				mxFree(macdHist); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *macdPtr = mxGetPr(macd_OUT);
-				double *macdSigPtr = mxGetPr(macdSig_OUT);
-				double *macdHistPtr = mxGetPr(macdHist_OUT);
-
-				for (int iter = 0; iter < 26; iter++)
-				{
-					macdPtr[iter] = m_Nan;
-					macdSigPtr[iter] = m_Nan;
-				}
-
-				for (int iter = 0; iter < smoothP; iter++)
-				{
-					macdHistPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 
@@ -5876,11 +5889,7 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 
 				// Validate
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_mama:InputErr",
-						"Observational data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				if (rows < 32)
 				{
@@ -5892,7 +5901,6 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *mama, *fama;
 
 				// Get optional input or assign default
@@ -5952,43 +5960,27 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 						"The MESA ADAPTIVE MOVING AVERAGE slowLmt must be less than or equal to the fastLmt. Aborting (%d).", codeLine);
 				}
 
-				// Preallocate heap
-				mama = (double*)mxCalloc(rows, sizeof(double));
-				fama = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the outputs up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				int outBeg = TA_MAMA_Lookback(fastLmt, slowLmt);
+				mama = taAllocOut(mama_OUT, rows, cols, outBeg);
+				fama = taAllocOut(fama_OUT, rows, cols, outBeg);
 
 				// Invoke with error catch
-				retCode = TA_MAMA(startIdx, endIdx, dataPtr, fastLmt, slowLmt, &dataIdx, &outElements, mama, fama);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_MAMA(startIdx, endIdx, dataPtr + colOff, fastLmt, slowLmt, &colBegIdx, &colElements, mama + colOff, fama + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(mama);
-					mxFree(fama);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				mama_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				fama_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(mama_OUT)) + dataIdx, mama, outElements * mxGetElementSize(mama_OUT));
-				memcpy(((double *) mxGetData(fama_OUT)) + dataIdx, fama, outElements * mxGetElementSize(fama_OUT));
-
-				// Cleanup
-				mxFree(mama); 
-				mxFree(fama); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *mamaPtr = mxGetPr(mama_OUT);
-				double *famaPtr = mxGetPr(fama_OUT);
-
-				for (int iter = 0; iter < 32; iter++)
-				{
-					mamaPtr[iter] = m_Nan;
-					famaPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 
@@ -6052,11 +6044,7 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				
 
 				// Validate
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_mavp:InputErr",
-						"Observational data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				if (!isRealScalar(period_IN))
 					mexErrMsgIdAndTxt( "MATLAB:taInvoke:inputErr",
@@ -6068,7 +6056,6 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *mavp;
 
 				// Get optional input or assign default
@@ -6145,39 +6132,25 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				// Validate
 				typeMAcheck(taFuncNameIn, taFuncDesc, taFuncOptName, typeMA);
 
-				// Preallocate heap
-				mavp = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				mavp = taAllocOut(mavp_OUT, rows, cols, TA_MAVP_Lookback(minPeriod, maxPeriod, (TA_MAType)typeMA));
 
 				// Invoke with error catch
-				retCode = TA_MAVP(startIdx, endIdx, dataPtr, periodPtr, minPeriod, maxPeriod, (TA_MAType)typeMA, &dataIdx, &outElements, mavp);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_MAVP(startIdx, endIdx, dataPtr + colOff, periodPtr, minPeriod, maxPeriod, (TA_MAType)typeMA, &colBegIdx, &colElements, mavp + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(mavp);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				mavp_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(mavp_OUT)) + dataIdx, mavp, outElements * mxGetElementSize(mavp_OUT));
-
-				// Cleanup
-				mxFree(mavp); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *mavpPtr = mxGetPr(mavp_OUT);
-
-				// Get the larger of the minPeriod or the original lookback period
-				int isGtr = max((int)*periodPtr, minPeriod);
-
-				for (int iter = 0; iter < isGtr; iter++)
-				{
-					mavpPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 
@@ -6223,17 +6196,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 
 				// Validate
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_max:InputErr",
-						"Observational data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *outReal;
 
 				// Get optional input or assign default
@@ -6260,27 +6228,25 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					lookback = 30;
 				}
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(max_OUT, rows, cols, TA_MAX_Lookback(lookback));
 
 				// Invoke with error catch
-				retCode = TA_MAX(startIdx, endIdx, dataPtr, lookback, &dataIdx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_MAX(startIdx, endIdx, dataPtr + colOff, lookback, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				max_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(max_OUT)) + dataIdx, outReal, outElements * mxGetElementSize(max_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
 				break;
 			}
 
@@ -6326,17 +6292,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 
 				// Validate
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_maxindex:InputErr",
-						"Observational data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				int *outInt;
 
 				// Get optional input or assign default
@@ -6363,27 +6324,25 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					lookback = 30;
 				}
 
-				// Preallocate heap
-				outInt = (int*)mxCalloc(rows, sizeof(int));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outInt = taAllocIntOut(maxidx_OUT, rows, cols, TA_MAXINDEX_Lookback(lookback));
 
 				// Invoke with error catch
-				retCode = TA_MAXINDEX(startIdx, endIdx, dataPtr, lookback, &dataIdx, &outElements, outInt);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_MAXINDEX(startIdx, endIdx, dataPtr + colOff, lookback, &colBegIdx, &colElements, outInt + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outInt);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				maxidx_OUT = mxCreateNumericMatrix(dataIdx + outElements,1, mxINT32_CLASS, mxREAL);
-				memcpy(((int *) mxGetData(maxidx_OUT)) + dataIdx, outInt, outElements * mxGetElementSize(maxidx_OUT));
-
-				// Cleanup
-				mxFree(outInt); 
-
 				break;
 			}
 
@@ -6433,40 +6392,33 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsL		= (int)mxGetN(low_IN);
 
 				// Validate
-				if (colsH != 1 || colsL != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_medprice:InputErr",
-						"Observational data should be provided as single vector arrays. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsH, colsL, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *outReal;
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(med_OUT, rows, cols, TA_MEDPRICE_Lookback());
 
 				// Invoke with error catch
-				retCode = TA_MEDPRICE(startIdx, endIdx, highPtr, lowPtr, &dataIdx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_MEDPRICE(startIdx, endIdx, highPtr + colOff, lowPtr + colOff, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				med_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(med_OUT)) + dataIdx, outReal, outElements * mxGetElementSize(med_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
 				break;
 			}
 
@@ -6521,19 +6473,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsV		= (int)mxGetN(vol_IN);
 
 				// Input validation
-				chkSingleVec(colsH, colsL, colsC, codeLine);
-
-				if (colsV != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_mfi:InputErr",
-						"Volume data should be a single vector array. Aborting (%d).",codeLine);
-				}
+				int cols = chkSameCols(colsH, colsL, colsC, colsV, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int adIdx, outElements;
 				double *outReal;
 
 				// Get optional input or assign default
@@ -6560,36 +6505,25 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					lookback = 14;
 				}
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));			// added cast
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(mfi_OUT, rows, cols, TA_MFI_Lookback(lookback));
 
 				// Invoke with error catch
-				retCode = TA_MFI(startIdx, endIdx, highPtr, lowPtr, closePtr, volPtr, lookback, &adIdx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_MFI(startIdx, endIdx, highPtr + colOff, lowPtr + colOff, closePtr + colOff, volPtr + colOff, lookback, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgTxt("Invocation to 'ta_ad' failed. Aborting.");
 				}
 
-				// Populate Output
-				mfi_OUT = mxCreateDoubleMatrix(adIdx + outElements,1, mxREAL);
-				memcpy(((double*) mxGetData(mfi_OUT)) + adIdx, outReal, outElements * mxGetElementSize(mfi_OUT));
-
-				// Cleanup
-				mxFree(outReal);  
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *outPtr = mxGetPr(ma_OUT);
-
-				for (int iter = 0; iter < lookback; iter++)
-				{
-					outPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 
@@ -6635,17 +6569,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 
 				// Validate
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_midpoint:InputErr",
-						"Observational data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *outReal;
 
 				// Get optional input or assign default
@@ -6672,27 +6601,25 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					lookback = 14;
 				}
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(midpt_OUT, rows, cols, TA_MIDPOINT_Lookback(lookback));
 
 				// Invoke with error catch
-				retCode = TA_MIDPOINT(startIdx, endIdx, dataPtr, lookback, &dataIdx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_MIDPOINT(startIdx, endIdx, dataPtr + colOff, lookback, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				midpt_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(midpt_OUT)) + dataIdx, outReal, outElements * mxGetElementSize(midpt_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
 				break;
 			}
 
@@ -6742,17 +6669,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsL		= (int)mxGetN(low_IN);
 
 				// Validate
-				if (colsH != 1 || colsL != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_midprice:InputErr",
-						"Observational data should be provided as single vector arrays. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsH, colsL, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *outReal;
 
 				// Get optional input or assign default
@@ -6779,27 +6701,25 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					lookback = 14;
 				}
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(midpr_OUT, rows, cols, TA_MIDPRICE_Lookback(lookback));
 
 				// Invoke with error catch
-				retCode = TA_MIDPRICE(startIdx, endIdx, highPtr, lowPtr, lookback, &dataIdx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_MIDPRICE(startIdx, endIdx, highPtr + colOff, lowPtr + colOff, lookback, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				midpr_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(midpr_OUT)) + dataIdx, outReal, outElements * mxGetElementSize(midpr_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
 				break;
 			}
 		
@@ -6845,17 +6765,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 
 				// Validate
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_min:InputErr",
-						"Observational data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *outReal;
 
 				// Get optional input or assign default
@@ -6882,27 +6797,25 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					lookback = 30;
 				}
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(min_OUT, rows, cols, TA_MIN_Lookback(lookback));
 
 				// Invoke with error catch
-				retCode = TA_MIN(startIdx, endIdx, dataPtr, lookback, &dataIdx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_MIN(startIdx, endIdx, dataPtr + colOff, lookback, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				min_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(min_OUT)) + dataIdx, outReal, outElements * mxGetElementSize(min_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
 				break;
 			}
 
@@ -6948,17 +6861,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 
 				// Validate
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_minindex:InputErr",
-						"Observational data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				int *outInt;
 
 				// Get optional input or assign default
@@ -6985,27 +6893,25 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					lookback = 30;
 				}
 
-				// Preallocate heap
-				outInt = (int*)mxCalloc(rows, sizeof(int));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outInt = taAllocIntOut(minidx_OUT, rows, cols, TA_MININDEX_Lookback(lookback));
 
 				// Invoke with error catch
-				retCode = TA_MININDEX(startIdx, endIdx, dataPtr, lookback, &dataIdx, &outElements, outInt);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_MININDEX(startIdx, endIdx, dataPtr + colOff, lookback, &colBegIdx, &colElements, outInt + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outInt);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				minidx_OUT = mxCreateNumericMatrix(dataIdx + outElements,1, mxINT32_CLASS, mxREAL);
-				memcpy(((int*) mxGetData(minidx_OUT)) + dataIdx, outInt, outElements * mxGetElementSize(minidx_OUT));
-
-				// Cleanup
-				mxFree(outInt); 
-
 				break;
 			}
 
@@ -7053,17 +6959,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 
 				// Validate
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_max:InputErr",
-						"Observational data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *outMin, *outMax;
 
 				// Get optional input or assign default
@@ -7090,32 +6991,27 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					lookback = 30;
 				}
 
-				// Preallocate heap
-				outMin = (double*)mxCalloc(rows, sizeof(double));
-				outMax = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the outputs up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				int outBeg = TA_MINMAX_Lookback(lookback);
+				outMin = taAllocOut(min_OUT, rows, cols, outBeg);
+				outMax = taAllocOut(max_OUT, rows, cols, outBeg);
 
 				// Invoke with error catch
-				retCode = TA_MINMAX(startIdx, endIdx, dataPtr, lookback, &dataIdx, &outElements, outMin, outMax);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_MINMAX(startIdx, endIdx, dataPtr + colOff, lookback, &colBegIdx, &colElements, outMin + colOff, outMax + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outMin);
-					mxFree(outMax);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				max_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				min_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(min_OUT)) + dataIdx, outMin, outElements * mxGetElementSize(min_OUT));
-				memcpy(((double *) mxGetData(max_OUT)) + dataIdx, outMax, outElements * mxGetElementSize(max_OUT));
-
-				// Cleanup
-				mxFree(outMin); 
-				mxFree(outMax); 
-
 				// NaN those values less than the lookback period
 				double *minPtr = mxGetPr(min_OUT);
 				double *maxPtr = mxGetPr(max_OUT);
@@ -7127,6 +7023,7 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 
 
 				break;
+
 				break;
 			}
 
@@ -7174,17 +7071,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 
 				// Validate
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_max:InputErr",
-						"Observational data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				int *outMinIdx, *outMaxIdx;
 
 				// Get optional input or assign default
@@ -7211,32 +7103,27 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					lookback = 30;
 				}
 
-				// Preallocate heap
-				outMinIdx = (int*)mxCalloc(rows, sizeof(int));
-				outMaxIdx = (int*)mxCalloc(rows, sizeof(int));
+				// Allocate the outputs up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				int outBeg = TA_MINMAXINDEX_Lookback(lookback);
+				outMinIdx = taAllocIntOut(minIdx_OUT, rows, cols, outBeg);
+				outMaxIdx = taAllocIntOut(maxIdx_OUT, rows, cols, outBeg);
 
 				// Invoke with error catch
-				retCode = TA_MINMAXINDEX(startIdx, endIdx, dataPtr, lookback, &dataIdx, &outElements, outMinIdx, outMaxIdx);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_MINMAXINDEX(startIdx, endIdx, dataPtr + colOff, lookback, &colBegIdx, &colElements, outMinIdx + colOff, outMaxIdx + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outMinIdx);
-					mxFree(outMaxIdx);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				maxIdx_OUT = mxCreateNumericMatrix(dataIdx + outElements,1, mxINT32_CLASS, mxREAL);
-				minIdx_OUT = mxCreateNumericMatrix(dataIdx + outElements,1, mxINT32_CLASS, mxREAL);
-				memcpy(((int *) mxGetData(minIdx_OUT)) + dataIdx, outMinIdx, outElements * mxGetElementSize(minIdx_OUT));
-				memcpy(((int *) mxGetData(maxIdx_OUT)) + dataIdx, outMaxIdx, outElements * mxGetElementSize(maxIdx_OUT));
-
-				// Cleanup
-				mxFree(outMinIdx); 
-				mxFree(outMaxIdx); 
-
 				break;
 			}
 
@@ -7257,7 +7144,7 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				//		ta_willr		WPR					Vector of Williams' %R values for the lookback period
 
 				// Strings for validation feedback
-				switch (s_mapStringValues[taFuncNameIn])
+				switch (taFunc)
 				{
 				case ta_minus_di:
 					taFuncDesc = "Minus Directional Indicator";
@@ -7302,13 +7189,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsC		= (int)mxGetN(close_IN);
 
 				// Validate
-				chkSingleVec(colsH, colsL, colsC, codeLine);
+				int cols = chkSameCols(colsH, colsL, colsC, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *outReal;
 
 				// Parse optional inputs if given, else default 
@@ -7331,7 +7217,7 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				}
 
 				// Validate
-				switch (s_mapStringValues[taFuncNameIn])
+				switch (taFunc)
 				{
 					case ta_minus_di:
 						if (lookback < 1)
@@ -7349,43 +7235,38 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 						break;
 				}
 				
-				// Preallocate heap
-				outReal	= (double*)mxCalloc(rows, sizeof(double));
-
-				switch (s_mapStringValues[taFuncNameIn])
+				// Outputs are allocated with each invocation below.  TA-Lib writes from outBegIdx (the lookback) onward
+				switch (taFunc)
 				{
 				case ta_minus_di:
-					retCode = TA_MINUS_DI(startIdx, endIdx, highPtr, lowPtr, closePtr, lookback, &dataIdx, &outElements, outReal);
+					outReal = taAllocOut(data_OUT, rows, cols, TA_MINUS_DI_Lookback(lookback));
+					retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+					for (int col = 0; col < cols; col++)
+					{
+						int colOff = col * rows, colBegIdx, colElements;
+						taColCode(retCode, TA_MINUS_DI(startIdx, endIdx, highPtr + colOff, lowPtr + colOff, closePtr + colOff, lookback, &colBegIdx, &colElements, outReal + colOff));
+					}
 					break;
 				case ta_willr:
-					retCode = TA_WILLR(startIdx, endIdx, highPtr, lowPtr, closePtr, lookback, &dataIdx, &outElements, outReal);
+					outReal = taAllocOut(data_OUT, rows, cols, TA_WILLR_Lookback(lookback));
+					retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+					for (int col = 0; col < cols; col++)
+					{
+						int colOff = col * rows, colBegIdx, colElements;
+						taColCode(retCode, TA_WILLR(startIdx, endIdx, highPtr + colOff, lowPtr + colOff, closePtr + colOff, lookback, &colBegIdx, &colElements, outReal + colOff));
+					}
 					break;
 				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				data_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(data_OUT)) + dataIdx, outReal, outElements * mxGetElementSize(data_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *dataPtr = mxGetPr(data_OUT);
-
-				for (int iter = 0; iter < lookback; iter++)
-				{
-					dataPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 
@@ -7433,13 +7314,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsL		= (int)mxGetN(low_IN);
 
 				// Validate
-				chkSingleVec(colsH, colsL, codeLine);
+				int cols = chkSameCols(colsH, colsL, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *mDM;
 
 				// Parse optional inputs if given, else default 
@@ -7467,35 +7347,23 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					lookback = 14;
 				}
 
-				// Preallocate heap
-				mDM	= (double*)mxCalloc(rows, sizeof(double));
-
-				retCode = TA_MINUS_DM(startIdx, endIdx, highPtr, lowPtr, lookback, &dataIdx, &outElements, mDM);
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				mDM = taAllocOut(mDM_OUT, rows, cols, TA_MINUS_DM_Lookback(lookback));
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_MINUS_DM(startIdx, endIdx, highPtr + colOff, lowPtr + colOff, lookback, &colBegIdx, &colElements, mDM + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(mDM);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				mDM_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(mDM_OUT)) + dataIdx, mDM, outElements * mxGetElementSize(mDM_OUT));
-
-				// Cleanup
-				mxFree(mDM); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *mDMPtr = mxGetPr(mDM_OUT);
-
-				for (int iter = 0; iter < lookback; iter++)
-				{
-					mDMPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 		
@@ -7540,17 +7408,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 
 				// Validate
-				if (colsD != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_minindex:InputErr",
-						"Observational data should be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *MOM;
 
 				// Parse optional inputs if given, else default 
@@ -7578,35 +7441,23 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					lookback = 14;
 				}
 
-				// Preallocate heap
-				MOM	= (double*)mxCalloc(rows, sizeof(double));
-
-				retCode = TA_MOM(startIdx, endIdx, dataPtr, lookback, &dataIdx, &outElements, MOM);
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				MOM = taAllocOut(MOM_OUT, rows, cols, TA_MOM_Lookback(lookback));
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_MOM(startIdx, endIdx, dataPtr + colOff, lookback, &colBegIdx, &colElements, MOM + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(MOM);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				MOM_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(MOM_OUT)) + dataIdx, MOM, outElements * mxGetElementSize(MOM_OUT));
-
-				// Cleanup
-				mxFree(MOM); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *momPtr = mxGetPr(MOM_OUT);
-
-				for (int iter = 0; iter < lookback; iter++)
-				{
-					momPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 		
@@ -7651,45 +7502,31 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				mPlierPtr		= mxGetPr(mPlier_IN);
 				colsP			= (int)mxGetN(mPlier_IN);
 
-				if (colsC != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:InputErr",
-						"Vector multiplication inputs should be single dimensional vectors.\nThe multiplicand vector had more than 1 column.  Aborting (%d).",codeLine);
-				}
-
-				if (colsP != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:InputErr",
-						"Vector multiplication inputs should be single dimensional vectors.\nThe multiplier vector had more than 1 column.  Aborting (%d).",codeLine);
-				}
+				int cols = chkSameCols(colsC, colsP, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *product;
 
-				// Preallocate heap
-				product = (double*)mxCalloc(rows, sizeof(double));
-
-				retCode = TA_MULT(startIdx, endIdx, mCandPtr, mPlierPtr, &dataIdx, &outElements, product);
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				product = taAllocOut(product_OUT, rows, cols, TA_MULT_Lookback());
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_MULT(startIdx, endIdx, mCandPtr + colOff, mPlierPtr + colOff, &colBegIdx, &colElements, product + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(product);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				product_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(product_OUT)) + dataIdx, product, outElements * mxGetElementSize(product_OUT));
-
-				// Cleanup
-				mxFree(product); 
-
 				break;
 			}
 
@@ -7740,13 +7577,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsC		= (int)mxGetN(close_IN);
 
 				// Validate
-				chkSingleVec(colsH, colsL, colsC, codeLine);
+				int cols = chkSameCols(colsH, colsL, colsC, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int natrIdx, outElements;
 				double *outReal;
 
 				// Parse optional inputs if given, else default 
@@ -7775,35 +7611,23 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					lookback = 14;
 				}
 
-				// Preallocate heap
-				outReal	= (double*)mxCalloc(rows, sizeof(double));
-
-				retCode = TA_NATR(startIdx, endIdx, highPtr, lowPtr, closePtr, lookback, &natrIdx, &outElements, outReal);
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(natr_OUT, rows, cols, TA_NATR_Lookback(lookback));
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_NATR(startIdx, endIdx, highPtr + colOff, lowPtr + colOff, closePtr + colOff, lookback, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				natr_OUT = mxCreateDoubleMatrix(natrIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(natr_OUT)) + natrIdx, outReal, outElements * mxGetElementSize(natr_OUT));
-
-				// Cleanup
-				mxFree(outReal);
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *outPtr = mxGetPr(natr_OUT);
-
-				for (int iter = 0; iter < lookback; iter++)
-				{
-					outPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 
@@ -7852,40 +7676,33 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsV		= (int)mxGetN(vol_IN);
 
 				// Input validation
-				if (colsV != 1 || colsV != 1)
-				{
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:ta_obv:InputErr",
-						"Observational price data and volume data should each be a single vector array. Aborting (%d).", codeLine);
-				}
+				int cols = chkSameCols(colsD, colsV, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *outReal;
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));			// added cast
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(obv_OUT, rows, cols, TA_OBV_Lookback());
 
 				// Invoke with error catch
-				retCode = TA_OBV(startIdx, endIdx, dataPtr, volPtr, &dataIdx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_OBV(startIdx, endIdx, dataPtr + colOff, volPtr + colOff, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				obv_OUT = mxCreateDoubleMatrix(dataIdx + outElements, 1, mxREAL);
-				memcpy(((double*) mxGetData(obv_OUT)) + dataIdx, outReal, outElements * mxGetElementSize(obv_OUT));
-
-				// Cleanup
-				mxFree(outReal);  
-
 				break;
 			}
 		
@@ -7936,13 +7753,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsC		= (int)mxGetN(close_IN);
 
 				// Validate
-				chkSingleVec(colsH, colsL, colsC, codeLine);
+				int cols = chkSameCols(colsH, colsL, colsC, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *outReal;
 
 				// Parse optional inputs if given, else default 
@@ -7970,35 +7786,23 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					lookback = 14;
 				}
 
-				// Preallocate heap
-				outReal	= (double*)mxCalloc(rows, sizeof(double));
-
-				retCode = TA_PLUS_DI(startIdx, endIdx, highPtr, lowPtr, closePtr, lookback, &dataIdx, &outElements, outReal);
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(plus_OUT, rows, cols, TA_PLUS_DI_Lookback(lookback));
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_PLUS_DI(startIdx, endIdx, highPtr + colOff, lowPtr + colOff, closePtr + colOff, lookback, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				plus_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(plus_OUT)) + dataIdx, outReal, outElements * mxGetElementSize(plus_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *plusPtr = mxGetPr(plus_OUT);
-
-				for (int iter = 0; iter < lookback; iter++)
-				{
-					plusPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 
@@ -8046,13 +7850,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsL		= (int)mxGetN(low_IN);
 
 				// Validate
-				chkSingleVec(colsH, colsL, codeLine);
+				int cols = chkSameCols(colsH, colsL, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *outReal;
 
 				// Parse optional inputs if given, else default 
@@ -8080,35 +7883,23 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					lookback = 14;
 				}
 
-				// Preallocate heap
-				outReal	= (double*)mxCalloc(rows, sizeof(double));
-
-				retCode = TA_PLUS_DM(startIdx, endIdx, highPtr, lowPtr, lookback, &dataIdx, &outElements, outReal);
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(plus_OUT, rows, cols, TA_PLUS_DM_Lookback(lookback));
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_PLUS_DM(startIdx, endIdx, highPtr + colOff, lowPtr + colOff, lookback, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				plus_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(plus_OUT)) + dataIdx, outReal, outElements * mxGetElementSize(plus_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *plusPtr = mxGetPr(plus_OUT);
-
-				for (int iter = 0; iter < lookback; iter++)
-				{
-					plusPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 
@@ -8195,13 +7986,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsL		= (int)mxGetN(low_IN);
 
 				// Input validation
-				chkSingleVec(colsH, colsL, codeLine);
+				int cols = chkSameCols(colsH, colsL, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int vecIdx, outElements;
 				double *outReal;
 
 				// Parse optional inputs if given, else default 
@@ -8248,28 +8038,26 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 						"The optional inputs must be a scalar greater than or equal to 0. Aborting (%d).",codeLine);
 				}
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(vec_OUT, rows, cols, TA_SAR_Lookback(opt1, opt2));
 
 				// Invoke with error catch
-				retCode = TA_SAR(startIdx, endIdx, highPtr, lowPtr, opt1, opt2, &vecIdx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_SAR(startIdx, endIdx, highPtr + colOff, lowPtr + colOff, opt1, opt2, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt( "MATLAB:taInvoke:invokeErr",
 						"Invocation to '%s' failed.. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				vec_OUT = mxCreateDoubleMatrix(vecIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(vec_OUT)) + vecIdx, outReal, outElements * mxGetElementSize(vec_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
 				break;
 			}
 		
@@ -8379,13 +8167,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsL		= (int)mxGetN(low_IN);
 
 				// Input validation
-				chkSingleVec(colsH, colsL, codeLine);
+				int cols = chkSameCols(colsH, colsL, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int vecIdx, outElements;
 				double *outReal;
 
 				if (nrhs > 3)
@@ -8560,27 +8347,25 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 						"Each optional input must be a scalar greater than or equal to 0. Aborting (%d).", codeLine);
 				}
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(vec_OUT, rows, cols, TA_SAREXT_Lookback(opt1, opt2, opt3, opt4, opt5, opt6, opt7, opt8));
 
 				// Invoke with error catch
-				retCode = TA_SAREXT(startIdx, endIdx, highPtr, lowPtr, opt1, opt2, opt3, opt4, opt5, opt6, opt7, opt8, &vecIdx, &outElements, outReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_SAREXT(startIdx, endIdx, highPtr + colOff, lowPtr + colOff, opt1, opt2, opt3, opt4, opt5, opt6, opt7, opt8, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgTxt("Invocation to 'ta_adosc' failed. Aborting (577).");
 				}
 
-				// Populate Output
-				vec_OUT = mxCreateDoubleMatrix(vecIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(vec_OUT)) + vecIdx, outReal, outElements * mxGetElementSize(vec_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
 				break;
 			}
 
@@ -8592,13 +8377,15 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				//		ta_stddev	data		A single vector of observations
 
 				// OPTIONAL INPUTS
-				//		ta_stddev	Lookback	lookback period							(default 5)
+				//		ta_stddev	Lookback	lookback period, or a vector of K lookbacks	(default 5)
 				//					numDev		Number of deviations from the mean		(default 1)
 
 				// OUTPUT
 				//		ta_stddev	STDDEV		vector of standard deviation values
+				//		Given K lookbacks the output is N x K, or N x M x K for M instruments.  Each lookback keeps
+				//		rolling window sums (of values and squared values) as TA-Lib does, so columns match a scalar call.
 
-				switch (s_mapStringValues[taFuncNameIn])
+				switch (taFunc)
 				{
 					case ta_stddev:
 						taFuncDesc = "Standard Deviation";
@@ -8624,7 +8411,8 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				#define vec_OUT			plhs[0]
 
 				// Declare variables
-				int startIdx, endIdx, rows, colsD, lookback;
+				int startIdx, endIdx, rows, colsD, lookback, numLb;
+				int *lookbacks;
 				double *dataPtr, numDev;
 
 				// Initialize error handling 
@@ -8637,26 +8425,22 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 
 				// Validate
-				chkSingleVec(colsD, codeLine);
+				int cols = chkSameCols(colsD, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *outReal;
 
 				// Get optional input or assign default
 				if (nrhs > 2) 
 				{
 					#define lookback_IN		prhs[2]
-					if (!isRealScalar(lookback_IN))
+					numLb = taGetParams(lookback_IN, lookbacks);
+					if (numLb == 0)
 						mexErrMsgIdAndTxt( "MATLAB:taInvoke:inputErr",
-						"The first optional value must be a scalar. Aborting (%d).", codeLine);
-
-					/* Get the scalar input lookback */
-					// Assign
-					lookback = (int)mxGetScalar(lookback_IN);
+						"The first optional value must be a scalar or a vector. Aborting (%d).", codeLine);
 
 					if (nrhs > 3)
 					{
@@ -8677,51 +8461,83 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				else
 					// Defaults
 				{
-					lookback = 5;
+					numLb = 1;
+					lookbacks = (int*)mxMalloc(sizeof(int));
+					lookbacks[0] = 5;
 					numDev = 1;
 				}
 
 				// Validate
-				if(lookback < 2)
-					mexErrMsgIdAndTxt( "MATLAB:taInvoke:InputErr",
-					"Lookback period must be a scalar greater than or equal to 2. Aborting (%d).", codeLine);
+				for (int iter = 0; iter < numLb; iter++)
+				{
+					if(lookbacks[iter] < 2)
+						mexErrMsgIdAndTxt( "MATLAB:taInvoke:InputErr",
+						"Lookback period must be greater than or equal to 2. Aborting (%d).", codeLine);
+				}
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
+				// A single lookback is passed to TA-Lib
+				lookback = lookbacks[0];
 
-				// Invoke with error catch
-				switch (s_mapStringValues[taFuncNameIn])
+				if (numLb > 1)
 				{
-					case ta_stddev:
-						retCode = TA_STDDEV(startIdx, endIdx, dataPtr, lookback, numDev, &dataIdx, &outElements, outReal);
-						break;
-					case ta_var:
-						retCode = TA_VAR(startIdx, endIdx, dataPtr, lookback, numDev, &dataIdx, &outElements, outReal);
-						break;
+					// Allocate the output up front.  Each lookback is written from its own outBegIdx (lookback - 1) onward
+					int *outBeg = (int*)mxMalloc(numLb * sizeof(int));
+					for (int iter = 0; iter < numLb; iter++)
+					{
+						outBeg[iter] = min(lookbacks[iter] - 1, rows);
+					}
+					outReal = taAllocGridOut(vec_OUT, rows, cols, numLb, outBeg);
+
+					// Columns of the grid (lookback, instrument) are independent.  Column 'job' begins at job * rows.
+					int numJobs = numLb * cols;
+					taRollType rollType = (taFunc == ta_stddev) ? taRollStdDev : taRollVar;
+
+#pragma omp parallel for schedule(dynamic) if (numJobs > 1)
+					for (int job = 0; job < numJobs; job++)
+					{
+						int col = job % cols;
+						taRollSums(dataPtr + col * rows, rows, lookbacks[job / cols], rollType, numDev, outReal + job * rows);
+					}
+
+					mxFree(outBeg);
+					retCode = TA_SUCCESS;
 				}
-				
-				// Error handling
-				if (retCode) 
+				else
 				{
-					mxFree(outReal);
-					mexPrintf("%s%i","Return code=",retCode);
-					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
+					// Outputs are allocated with each invocation below.  TA-Lib writes from outBegIdx (the lookback) onward
+					// Invoke with error catch
+					switch (taFunc)
+					{
+						case ta_stddev:
+							outReal = taAllocOut(vec_OUT, rows, cols, TA_STDDEV_Lookback(lookback, numDev));
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_STDDEV(startIdx, endIdx, dataPtr + colOff, lookback, numDev, &colBegIdx, &colElements, outReal + colOff));
+							}
+							break;
+						case ta_var:
+							outReal = taAllocOut(vec_OUT, rows, cols, TA_VAR_Lookback(lookback, numDev));
+							retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+							for (int col = 0; col < cols; col++)
+							{
+								int colOff = col * rows, colBegIdx, colElements;
+								taColCode(retCode, TA_VAR(startIdx, endIdx, dataPtr + colOff, lookback, numDev, &colBegIdx, &colElements, outReal + colOff));
+							}
+							break;
+					}
 				}
 
-				// Populate Output
-				vec_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(vec_OUT)) + dataIdx, outReal, outElements * mxGetElementSize(vec_OUT));
+				mxFree(lookbacks);
 
-				// Cleanup
-				mxFree(outReal); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *vecPtr = mxGetPr(vec_OUT);
-
-				for (int iter = 0; iter < lookback; iter++)
+				// Error handling
+				if (retCode) 
 				{
-					vecPtr[iter] = m_Nan;
+					mexPrintf("%s%i","Return code=",retCode);
+					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
 				break;
@@ -8825,13 +8641,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsC		= (int)mxGetN(close_IN);
 
 				// Validate
-				chkSingleVec(colsH, colsL, colsC, codeLine);
+				int cols = chkSameCols(colsH, colsL, colsC, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int vecIdx, outElements;
 				double *outDReal, *outKReal;
 
 				if (nrhs > 4)
@@ -8940,43 +8755,27 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 						"Period based optional inputs must be a scalar greater than or equal to 1. Aborting (%d).", codeLine);
 				}
 
-				// Preallocate heap
-				outDReal = (double*)mxCalloc(rows, sizeof(double));
-				outKReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the outputs up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				int outBeg = TA_STOCH_Lookback(opt1, opt2, (TA_MAType)opt3, opt4, (TA_MAType)opt5);
+				outKReal = taAllocOut(slowK_OUT, rows, cols, outBeg);
+				outDReal = taAllocOut(slowD_OUT, rows, cols, outBeg);
 
 				// Invoke with error catch
-				retCode = TA_STOCH(startIdx, endIdx, highPtr, lowPtr, closePtr, opt1, opt2, (TA_MAType)opt3, opt4, (TA_MAType)opt5, &vecIdx, &outElements, outKReal, outDReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_STOCH(startIdx, endIdx, highPtr + colOff, lowPtr + colOff, closePtr + colOff, opt1, opt2, (TA_MAType)opt3, opt4, (TA_MAType)opt5, &colBegIdx, &colElements, outKReal + colOff, outDReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outKReal);
-					mxFree(outDReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				slowK_OUT = mxCreateDoubleMatrix(vecIdx + outElements,1, mxREAL);
-				slowD_OUT = mxCreateDoubleMatrix(vecIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(slowK_OUT)) + vecIdx, outKReal, outElements * mxGetElementSize(slowK_OUT));
-				memcpy(((double *) mxGetData(slowD_OUT)) + vecIdx, outDReal, outElements * mxGetElementSize(slowD_OUT));
-
-				// Cleanup
-				mxFree(outKReal);
-				mxFree(outDReal); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *kPtr = mxGetPr(slowK_OUT);
-				double *dPtr = mxGetPr(slowD_OUT);
-
-				for (int iter = 0; iter < opt1 + max(opt2, opt4); iter++)
-				{
-					kPtr[iter] = m_Nan;
-					dPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 
@@ -9075,13 +8874,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsC		= (int)mxGetN(close_IN);
 
 				// Validate
-				chkSingleVec(colsH, colsL, colsC, codeLine);
+				int cols = chkSameCols(colsH, colsL, colsC, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int vecIdx, outElements;
 				double *outDReal, *outKReal;
 
 				if (nrhs > 4)
@@ -9149,43 +8947,27 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 						"Period based optional inputs must be a scalar greater than or equal to 1. Aborting (%d).", codeLine);
 				}
 
-				// Preallocate heap
-				outDReal = (double*)mxCalloc(rows, sizeof(double));
-				outKReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the outputs up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				int outBeg = TA_STOCHF_Lookback(opt1, opt2, (TA_MAType)opt3);
+				outKReal = taAllocOut(slowK_OUT, rows, cols, outBeg);
+				outDReal = taAllocOut(slowD_OUT, rows, cols, outBeg);
 
 				// Invoke with error catch
-				retCode = TA_STOCHF(startIdx, endIdx, highPtr, lowPtr, closePtr, opt1, opt2, (TA_MAType)opt3, &vecIdx, &outElements, outKReal, outDReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_STOCHF(startIdx, endIdx, highPtr + colOff, lowPtr + colOff, closePtr + colOff, opt1, opt2, (TA_MAType)opt3, &colBegIdx, &colElements, outKReal + colOff, outDReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outKReal);
-					mxFree(outDReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				slowK_OUT = mxCreateDoubleMatrix(vecIdx + outElements,1, mxREAL);
-				slowD_OUT = mxCreateDoubleMatrix(vecIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(slowK_OUT)) + vecIdx, outKReal, outElements * mxGetElementSize(slowK_OUT));
-				memcpy(((double *) mxGetData(slowD_OUT)) + vecIdx, outDReal, outElements * mxGetElementSize(slowD_OUT));
-
-				// Cleanup
-				mxFree(outKReal);
-				mxFree(outDReal); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *kPtr = mxGetPr(slowK_OUT);
-				double *dPtr = mxGetPr(slowD_OUT);
-
-				for (int iter = 0; iter < opt1 + opt2; iter++)
-				{
-					kPtr[iter] = m_Nan;
-					dPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 
@@ -9273,13 +9055,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsD		= (int)mxGetN(data_IN);
 
 				// Validate
-				chkSingleVec(colsD, codeLine);
+				int cols = chkSameCols(colsD, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int vecIdx, outElements;
 				double *outDReal, *outKReal;
 
 				if (nrhs > 3)
@@ -9373,43 +9154,27 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 						"Period based optional inputs must be a scalar greater than or equal to 1. Aborting (%d).", codeLine);
 				}
 
-				// Preallocate heap
-				outDReal = (double*)mxCalloc(rows, sizeof(double));
-				outKReal = (double*)mxCalloc(rows, sizeof(double));
+				// Allocate the outputs up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				int outBeg = TA_STOCHRSI_Lookback(opt1, opt2, opt3, (TA_MAType)opt4);
+				outKReal = taAllocOut(slowK_OUT, rows, cols, outBeg);
+				outDReal = taAllocOut(slowD_OUT, rows, cols, outBeg);
 
 				// Invoke with error catch
-				retCode = TA_STOCHRSI(startIdx, endIdx, dataPtr, opt1, opt2, opt3, (TA_MAType)opt4, &vecIdx, &outElements, outKReal, outDReal);
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_STOCHRSI(startIdx, endIdx, dataPtr + colOff, opt1, opt2, opt3, (TA_MAType)opt4, &colBegIdx, &colElements, outKReal + colOff, outDReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outKReal);
-					mxFree(outDReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				slowK_OUT = mxCreateDoubleMatrix(vecIdx + outElements,1, mxREAL);
-				slowD_OUT = mxCreateDoubleMatrix(vecIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(slowK_OUT)) + vecIdx, outKReal, outElements * mxGetElementSize(slowK_OUT));
-				memcpy(((double *) mxGetData(slowD_OUT)) + vecIdx, outDReal, outElements * mxGetElementSize(slowD_OUT));
-
-				// Cleanup
-				mxFree(outKReal);
-				mxFree(outDReal); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *kPtr = mxGetPr(slowK_OUT);
-				double *dPtr = mxGetPr(slowD_OUT);
-
-				for (int iter = 0; iter < max(opt1, opt2 + opt3); iter++)
-				{
-					kPtr[iter] = m_Nan;
-					dPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 
@@ -9457,13 +9222,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				rows		= (int)mxGetM(vec_IN);
 
 				// Validate
-				chkSingleVec(colsVec, codeLine);
+				int cols = chkSameCols(colsVec, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int vecIdx, outElements;
 				double *outReal;
 
 				if (nrhs > 2)
@@ -9511,42 +9275,30 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 						"The '%s' inVfactor must be an integer between 0 =< x >= 1. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Preallocate heap
-				outReal = (double*)mxCalloc(rows, sizeof(double));
-
 				// Invoke with error catch
-				switch (s_mapStringValues[taFuncNameIn])
+				switch (taFunc)
 				{
 				case ta_t3:
-					retCode = TA_T3(startIdx, endIdx, vecPtr, lookback, inVfactor, &vecIdx, &outElements, outReal);
+					// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+					outReal = taAllocOut(vec_OUT, rows, cols, TA_T3_Lookback(lookback, inVfactor));
+					retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+					for (int col = 0; col < cols; col++)
+					{
+						int colOff = col * rows, colBegIdx, colElements;
+						taColCode(retCode, TA_T3(startIdx, endIdx, vecPtr + colOff, lookback, inVfactor, &colBegIdx, &colElements, outReal + colOff));
+					}
 					break;
 				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt( "MATLAB:taInvoke:invokeErr",
 						"Invocation to '%s' failed.. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				vec_OUT = mxCreateDoubleMatrix(vecIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(vec_OUT)) + vecIdx, outReal, outElements * mxGetElementSize(vec_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *outPtr = mxGetPr(vec_OUT);
-
-				for (int iter = 0; iter < (lookback - 1) * 6; iter++)
-				{
-					outPtr[iter] = m_Nan;
-				}
-
 				break;
 			}
 
@@ -9566,7 +9318,7 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				//		ta_typprice	TYPPRICE	A single vector of Typical Price values
 
 				// Strings for validation feedback
-				switch (s_mapStringValues[taFuncNameIn])
+				switch (taFunc)
 				{
 					case ta_trange:
 						taFuncDesc = "True Range";
@@ -9611,43 +9363,46 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsC		= (int)mxGetN(close_IN);
 
 				// Validate
-				chkSingleVec(colsH, colsL, colsC, codeLine);
+				int cols = chkSameCols(colsH, colsL, colsC, codeLine);
 				
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *outReal;
 
-				// Preallocate heap
-				outReal	= (double*)mxCalloc(rows, sizeof(double));
-
-				switch (s_mapStringValues[taFuncNameIn])
+				// Outputs are allocated with each invocation below.  TA-Lib writes from outBegIdx (the lookback) onward
+				switch (taFunc)
 				{
 					case ta_trange:
-						retCode = TA_TRANGE(startIdx, endIdx, highPtr, lowPtr, closePtr, &dataIdx, &outElements, outReal);
+						outReal = taAllocOut(vec_OUT, rows, cols, TA_TRANGE_Lookback());
+						retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+						for (int col = 0; col < cols; col++)
+						{
+							int colOff = col * rows, colBegIdx, colElements;
+							taColCode(retCode, TA_TRANGE(startIdx, endIdx, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outReal + colOff));
+						}
 						break;
 					case ta_typprice:
-						retCode = TA_TYPPRICE(startIdx, endIdx, highPtr, lowPtr, closePtr, &dataIdx, &outElements, outReal);
+						outReal = taAllocOut(vec_OUT, rows, cols, TA_TYPPRICE_Lookback());
+						retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+						for (int col = 0; col < cols; col++)
+						{
+							int colOff = col * rows, colBegIdx, colElements;
+							taColCode(retCode, TA_TYPPRICE(startIdx, endIdx, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outReal + colOff));
+						}
 						break;
 				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				vec_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(vec_OUT)) + dataIdx, outReal, outElements * mxGetElementSize(vec_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
 				if (taFuncNameIn.compare("ta_trange") == 0)
 				{
 					// NaN first entry
@@ -9673,7 +9428,7 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				//		ta_ultosc	ULTOSC		A single vector of Ultimate Oscillator values
 				// Strings for validation feedback
 				
-				switch (s_mapStringValues[taFuncNameIn])
+				switch (taFunc)
 				{
 				case ta_ultosc:
 					taFuncDesc = "Ultimate Oscillator ";
@@ -9715,13 +9470,12 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsC		= (int)mxGetN(close_IN);
 
 				// Validate
-				chkSingleVec(colsH, colsL, colsC, codeLine);
+				int cols = chkSameCols(colsH, colsL, colsC, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *outReal;
 
 				if (nrhs > 4)
@@ -9791,14 +9545,19 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 					mexErrMsgIdAndTxt( "MATLAB:taInvoke:inputErr",
 						"Lookback periods must be of a value greater than or equal to 1. Aborting (%d).", rows, codeLine);
 				}
-				// Preallocate heap
-				outReal	= (double*)mxCalloc(rows, sizeof(double));
-
 				// Invoke with error catch
-				switch (s_mapStringValues[taFuncNameIn])
+				switch (taFunc)
 				{
 				case ta_ultosc:
-					retCode = TA_ULTOSC(startIdx, endIdx, highPtr, lowPtr, closePtr, lookback1, lookback2, lookback3, &dataIdx, &outElements, outReal);
+					// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+					outReal = taAllocOut(data_OUT, rows, cols, TA_ULTOSC_Lookback(lookback1, lookback2, lookback3));
+					retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+					for (int col = 0; col < cols; col++)
+					{
+						int colOff = col * rows, colBegIdx, colElements;
+						taColCode(retCode, TA_ULTOSC(startIdx, endIdx, highPtr + colOff, lowPtr + colOff, closePtr + colOff, lookback1, lookback2, lookback3, &colBegIdx, &colElements, outReal + colOff));
+					}
 					break;
 				}
 
@@ -9806,32 +9565,11 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt( "MATLAB:taInvoke:invokeErr",
 						"Invocation to '%s' failed.. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				data_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(data_OUT)) + dataIdx, outReal, outElements * mxGetElementSize(data_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
-				// NaN data before lookback
-				// assign the variables for manipulating the arrays (by pointer reference)
-				double *outPtr = mxGetPr(data_OUT);
-
-				int lookback = max(lookback1, max(lookback2, lookback3));
-				
-				if (lookback > 1)
-				{
-					for (int iter = 0; iter < lookback; iter++)
-					{
-						outPtr[iter] = m_Nan;
-					}
-				}
 				break;
 			}
 
@@ -9886,35 +9624,31 @@ void mexFunction(int nlhs, mxArray *plhs[], /* Output variables */
 				colsC		= (int)mxGetN(close_IN);
 
 				// Validate
-				chkSingleVec(colsH, colsL, colsC, codeLine);
+				int cols = chkSameCols(colsH, colsL, colsC, codeLine);
 
 				endIdx = rows - 1;  // Adjust for C++ starting at '0'
 				startIdx = 0;
 
 				// Output variables
-				int dataIdx, outElements;
 				double *outReal;
 
-				// Preallocate heap
-				outReal	= (double*)mxCalloc(rows, sizeof(double));
-
-				retCode = TA_WCLPRICE(startIdx, endIdx, highPtr, lowPtr, closePtr, &dataIdx, &outElements, outReal);
+				// Allocate the output up front.  TA-Lib writes from outBegIdx (the lookback) onward
+				outReal = taAllocOut(data_OUT, rows, cols, TA_WCLPRICE_Lookback());
+				retCode = TA_SUCCESS;
+#pragma omp parallel for schedule(dynamic) if (cols > 1)
+				for (int col = 0; col < cols; col++)
+				{
+					int colOff = col * rows, colBegIdx, colElements;
+					taColCode(retCode, TA_WCLPRICE(startIdx, endIdx, highPtr + colOff, lowPtr + colOff, closePtr + colOff, &colBegIdx, &colElements, outReal + colOff));
+				}
 
 				// Error handling
 				if (retCode) 
 				{
-					mxFree(outReal);
 					mexPrintf("%s%i","Return code=",retCode);
 					mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' failed. Aborting (%d).", taFuncNameIn, codeLine);
 				}
 
-				// Populate Output
-				data_OUT = mxCreateDoubleMatrix(dataIdx + outElements,1, mxREAL);
-				memcpy(((double *) mxGetData(data_OUT)) + dataIdx, outReal, outElements * mxGetElementSize(data_OUT));
-
-				// Cleanup
-				mxFree(outReal); 
-
 				break;
 			}
 
@@ -10313,246 +10047,77 @@ void taInvokeInfoOnly()
 	mxFree(typeOut);
 }
 
-void InitSwitchMapping()
+// Resolve a (lowercase) function name by a binary search of the sorted name table
+static bool taNameLess(const char *a, const char *b)
 {
-	s_mapStringValues["ta_accbands"]			= ta_accbands;
-	s_mapStringValues["ta_acos"]				= ta_acos;
-	s_mapStringValues["ta_ad"]					= ta_ad;
-	s_mapStringValues["ta_add"]					= ta_add;
-	s_mapStringValues["ta_adosc"]				= ta_adosc;
-	s_mapStringValues["ta_adx"]					= ta_adx;
-	s_mapStringValues["ta_adxr"]				= ta_adxr;
-	s_mapStringValues["ta_apo"]					= ta_apo;
-	s_mapStringValues["ta_aroon"]				= ta_aroon;
-	s_mapStringValues["ta_aroonosc"]			= ta_aroonosc;
-	s_mapStringValues["ta_asin"]				= ta_asin;
-	s_mapStringValues["ta_atan"]				= ta_atan;
-	s_mapStringValues["ta_atr"]					= ta_atr;
-	s_mapStringValues["ta_avgdev"]				= ta_avgdev;
-	s_mapStringValues["ta_avgprice"]			= ta_avgprice;
-	s_mapStringValues["ta_bbands"]				= ta_bbands;
-	s_mapStringValues["ta_beta"]				= ta_beta;
-	s_mapStringValues["ta_bop"]					= ta_bop;
-	s_mapStringValues["ta_cci"]					= ta_cci;
-	s_mapStringValues["ta_cdl2crows"]			= ta_cdl2crows;
-	s_mapStringValues["ta_cdl3blackcrows"]		= ta_cdl3blackcrows;
-	s_mapStringValues["ta_cdl3inside"]			= ta_cdl3inside;
-	s_mapStringValues["ta_cdl3linestrike"]		= ta_cdl3linestrike;
-	s_mapStringValues["ta_cdl3outside"]			= ta_cdl3outside;
-	s_mapStringValues["ta_cdl3starsinsouth"]	= ta_cdl3starsinsouth;
-	s_mapStringValues["ta_cdl3whitesoldiers"]	= ta_cdl3whitesoldiers;
-	s_mapStringValues["ta_cdlabandonedbaby"]	= ta_cdlabandonedbaby;
-	s_mapStringValues["ta_cdladvanceblock"]		= ta_cdladvanceblock;
-	s_mapStringValues["ta_cdlbelthold"]			= ta_cdlbelthold;
-	s_mapStringValues["ta_cdlbreakaway"]		= ta_cdlbreakaway;
-	s_mapStringValues["ta_cdlclosingmarubozu"]	= ta_cdlclosingmarubozu;
-	s_mapStringValues["ta_cdlconcealbabyswall"]	= ta_cdlconcealbabyswall;
-	s_mapStringValues["ta_cdlcounterattack"]	= ta_cdlcounterattack;
-	s_mapStringValues["ta_cdldarkcloudcover"]	= ta_cdldarkcloudcover;
-	s_mapStringValues["ta_cdldoji"]				= ta_cdldoji;
-	s_mapStringValues["ta_cdldojistar"]			= ta_cdldojistar;
-	s_mapStringValues["ta_cdldragonflydoji"]	= ta_cdldragonflydoji;
-	s_mapStringValues["ta_cdlengulfing"]		= ta_cdlengulfing;
-	s_mapStringValues["ta_cdleveningdojistar"]	= ta_cdleveningdojistar;
-	s_mapStringValues["ta_cdleveningstar"]		= ta_cdleveningstar;
-	s_mapStringValues["ta_cdlgapsidesidewhite"]	= ta_cdlgapsidesidewhite;
-	s_mapStringValues["ta_cdlgravestonedoji"]	= ta_cdlgravestonedoji;
-	s_mapStringValues["ta_cdlhammer"]			= ta_cdlhammer;
-	s_mapStringValues["ta_cdlhangingman"]		= ta_cdlhangingman;
-	s_mapStringValues["ta_cdlharami"]			= ta_cdlharami;
-	s_mapStringValues["ta_cdlharamicross"]		= ta_cdlharamicross;
-	s_mapStringValues["ta_cdlhighwave"]			= ta_cdlhighwave;
-	s_mapStringValues["ta_cdlhikkake"]			= ta_cdlhikkake;
-	s_mapStringValues["ta_cdlhikkakemod"]		= ta_cdlhikkakemod;
-	s_mapStringValues["ta_cdlhomingpigeon"]		= ta_cdlhomingpigeon;
-	s_mapStringValues["ta_cdlidentical3crows"]	= ta_cdlidentical3crows;
-	s_mapStringValues["ta_cdlinneck"]			= ta_cdlinneck;
-	s_mapStringValues["ta_cdlinvertedhammer"]	= ta_cdlinvertedhammer;
-	s_mapStringValues["ta_cdlkicking"]			= ta_cdlkicking;
-	s_mapStringValues["ta_cdlkickingbylength"]	= ta_cdlkickingbylength;
-	s_mapStringValues["ta_cdlladderbottom"]		= ta_cdlladderbottom;
-	s_mapStringValues["ta_cdllongleggeddoji"]	= ta_cdllongleggeddoji;
-	s_mapStringValues["ta_cdllongline"]			= ta_cdllongline;
-	s_mapStringValues["ta_cdlmarubozu"]			= ta_cdlmarubozu;
-	s_mapStringValues["ta_cdlmatchinglow"]		= ta_cdlmatchinglow;
-	s_mapStringValues["ta_cdlmathold"]			= ta_cdlmathold;
-	s_mapStringValues["ta_cdlmorningdojistar"]	= ta_cdlmorningdojistar;
-	s_mapStringValues["ta_cdlmorningstar"]		= ta_cdlmorningstar;
-	s_mapStringValues["ta_cdlonneck"]			= ta_cdlonneck;
-	s_mapStringValues["ta_cdlpiercing"]			= ta_cdlpiercing;
-	s_mapStringValues["ta_cdlrickshawman"]		= ta_cdlrickshawman;
-	s_mapStringValues["ta_cdlrisefall3methods"]	= ta_cdlrisefall3methods;
-	s_mapStringValues["ta_cdlseparatinglines"]	= ta_cdlseparatinglines;
-	s_mapStringValues["ta_cdlshootingstar"]		= ta_cdlshootingstar;
-	s_mapStringValues["ta_cdlshortline"]		= ta_cdlshortline;
-	s_mapStringValues["ta_cdlspinningtop"]		= ta_cdlspinningtop;
-	s_mapStringValues["ta_cdlstalledpattern"]	= ta_cdlstalledpattern;
-	s_mapStringValues["ta_cdlsticksandwich"]	= ta_cdlsticksandwich;
-	s_mapStringValues["ta_cdltakuri"]			= ta_cdltakuri;
-	s_mapStringValues["ta_cdltasukigap"]		= ta_cdltasukigap;
-	s_mapStringValues["ta_cdlthrusting"]		= ta_cdlthrusting;
-	s_mapStringValues["ta_cdltristar"]			= ta_cdltristar;
-	s_mapStringValues["ta_cdlunique3river"]		= ta_cdlunique3river;
-	s_mapStringValues["ta_cdlupsidegap2crows"]	= ta_cdlupsidegap2crows;
-	s_mapStringValues["ta_cdlxsidegap3methods"]	= ta_cdlxsidegap3methods;
-	s_mapStringValues["ta_ceil"]				= ta_ceil;
-	s_mapStringValues["ta_cmo"]					= ta_cmo;
-	s_mapStringValues["ta_correl"]				= ta_correl;
-	s_mapStringValues["ta_cos"]					= ta_cos;
-	s_mapStringValues["ta_cosh"]				= ta_cosh;
-	s_mapStringValues["ta_dema"]				= ta_dema;
-	s_mapStringValues["ta_div"]					= ta_div;
-	s_mapStringValues["ta_dx"]					= ta_dx;
-	s_mapStringValues["ta_ema"]					= ta_ema;
-	s_mapStringValues["ta_exp"]					= ta_exp;
-	s_mapStringValues["ta_floor"]				= ta_floor;
-	s_mapStringValues["ta_ht_dcperiod"]			= ta_ht_dcperiod;
-	s_mapStringValues["ta_ht_dcphase"]			= ta_ht_dcphase;
-	s_mapStringValues["ta_ht_phasor"]			= ta_ht_phasor;
-	s_mapStringValues["ta_ht_sine"]				= ta_ht_sine;
-	s_mapStringValues["ta_ht_trendline"]		= ta_ht_trendline;
-	s_mapStringValues["ta_ht_trendmode"]		= ta_ht_trendmode;
-	s_mapStringValues["ta_kama"]				= ta_kama;
-	s_mapStringValues["ta_linearreg"]			= ta_linearreg;
-	s_mapStringValues["ta_linearreg_angle"]		= ta_linearreg_angle;
-	s_mapStringValues["ta_linearreg_intercept"]	= ta_linearreg_intercept;
-	s_mapStringValues["ta_linearreg_slope"]		= ta_linearreg_slope;
-	s_mapStringValues["ta_ln"]					= ta_ln;
-	s_mapStringValues["ta_log10"]				= ta_log10;
-	s_mapStringValues["ta_ma"]					= ta_ma;
-	s_mapStringValues["ta_macd"]				= ta_macd;
-	s_mapStringValues["ta_macdext"]				= ta_macdext;
-	s_mapStringValues["ta_macdfix"]				= ta_macdfix;
-	s_mapStringValues["ta_mama"]				= ta_mama;
-	s_mapStringValues["ta_mavp"]				= ta_mavp;
-	s_mapStringValues["ta_max"]					= ta_max;
-	s_mapStringValues["ta_maxindex"]			= ta_maxindex;
-	s_mapStringValues["ta_medprice"]			= ta_medprice;
-	s_mapStringValues["ta_mfi"]					= ta_mfi;
-	s_mapStringValues["ta_midpoint"]			= ta_midpoint;
-	s_mapStringValues["ta_midprice"]			= ta_midprice;
-	s_mapStringValues["ta_min"]					= ta_min;
-	s_mapStringValues["ta_minindex"]			= ta_minindex;
-	s_mapStringValues["ta_minmax"]				= ta_minmax;
-	s_mapStringValues["ta_minmaxindex"]			= ta_minmaxindex;
-	s_mapStringValues["ta_minus_di"]			= ta_minus_di;
-	s_mapStringValues["ta_minus_dm"]			= ta_minus_dm;
-	s_mapStringValues["ta_mom"]					= ta_mom;
-	s_mapStringValues["ta_mult"]				= ta_mult;
-	s_mapStringValues["ta_natr"]				= ta_natr;
-	s_mapStringValues["ta_obv"]					= ta_obv;
-	s_mapStringValues["ta_plus_di"]				= ta_plus_di;
-	s_mapStringValues["ta_plus_dm"]				= ta_plus_dm;
-	s_mapStringValues["ta_ppo"]					= ta_ppo;
-	s_mapStringValues["ta_roc"]					= ta_roc;
-	s_mapStringValues["ta_rocp"]				= ta_rocp;
-	s_mapStringValues["ta_rocr"]				= ta_rocr;
-	s_mapStringValues["ta_rocr100"]				= ta_rocr100;
-	s_mapStringValues["ta_rsi"]					= ta_rsi;
-	s_mapStringValues["ta_sar"]					= ta_sar;
-	s_mapStringValues["ta_sarext"]				= ta_sarext;
-	s_mapStringValues["ta_sin"]					= ta_sin;
-	s_mapStringValues["ta_sinh"]				= ta_sinh;
-	s_mapStringValues["ta_sma"]					= ta_sma;
-	s_mapStringValues["ta_sqrt"]				= ta_sqrt;
-	s_mapStringValues["ta_stddev"]				= ta_stddev;
-	s_mapStringValues["ta_stoch"]				= ta_stoch;
-	s_mapStringValues["ta_stochf"]				= ta_stochf;
-	s_mapStringValues["ta_stochrsi"]			= ta_stochrsi;
-	s_mapStringValues["ta_sub"]					= ta_sub;
-	s_mapStringValues["ta_sum"]					= ta_sum;
-	s_mapStringValues["ta_t3"]					= ta_t3;
-	s_mapStringValues["ta_tan"]					= ta_tan;
-	s_mapStringValues["ta_tanh"]				= ta_tanh;
-	s_mapStringValues["ta_tema"]				= ta_tema;
-	s_mapStringValues["ta_trange"]				= ta_trange;
-	s_mapStringValues["ta_trima"]				= ta_trima;
-	s_mapStringValues["ta_trix"]				= ta_trix;
-	s_mapStringValues["ta_tsf"]					= ta_tsf;
-	s_mapStringValues["ta_typprice"]			= ta_typprice;
-	s_mapStringValues["ta_ultosc"]				= ta_ultosc;
-	s_mapStringValues["ta_var"]					= ta_var;
-	s_mapStringValues["ta_wclprice"]			= ta_wclprice;
-	s_mapStringValues["ta_willr"]				= ta_willr;
-	s_mapStringValues["ta_wma"]					= ta_wma;
-
+	return strcmp(a, b) < 0;
 }
 
-// Validation Methods
-// DBL
-void chkSingleVec(int colsD, int lineNum)
+static StringValue taResolve(const char *taFuncName)
 {
-	if (colsD != 1)
+	const char **first = taFuncNames + 1;
+	const char **last = taFuncNames + taNumFuncs;
+	const char **found = lower_bound(first, last, taFuncName, taNameLess);
+
+	if (found != last && strcmp(*found, taFuncName) == 0)
 	{
-		mexErrMsgIdAndTxt( "MATLAB:taInvoke:InputErr",
-			"Observational data should be passed to the function as a single column vector (e.g. Close or Angle).  Aborting (%i).", lineNum);
+		return (StringValue)(found - taFuncNames);
 	}
+
+	return taNotDefined;
 }
 
-// H | L
-void chkSingleVec( int colsH, int colsL, int lineNum )
+// Validation Methods
+// Each series input is a single column vector or an N x M matrix with one column per instrument.  All series
+// inputs of a call must have the same number of columns.  Returns the number of columns.
+int chkSameCols(int colsA, int lineNum)
 {
-	if (colsH != 1)
+	if (colsA < 1)
 	{
 		mexErrMsgIdAndTxt( "MATLAB:taInvoke:InputErr",
-			"Price data should be passed to the function already parsed into H | L vectors.\nThe 'High' vector had more than 1 column.  Aborting (%i).", lineNum);
+			"Observational data should be passed to the function as a column vector or as a matrix with one column per instrument.  Aborting (%i).", lineNum);
 	}
 
-	if (colsL != 1)
-	{
-		mexErrMsgIdAndTxt( "MATLAB:taInvoke:InputErr",
-			"Price data should be passed to the function already parsed into H | L vectors.\nThe 'Low' vector had more than 1 column.  Aborting (%i).", lineNum);
-	}
+	return colsA;
 }
 
-// H | L | C
-void chkSingleVec( int colsH, int colsL, int colsC, int lineNum )
+int chkSameCols(int colsA, int colsB, int lineNum)
 {
-	if (colsH != 1)
-	{
-		mexErrMsgIdAndTxt( "MATLAB:taInvoke:InputErr",
-			"Price data should be passed to the function already parsed into H | L | C vectors.\nThe 'High' vector had more than 1 column.  Aborting (%i).", lineNum);
-	}
+	chkSameCols(colsA, lineNum);
 
-	if (colsL != 1)
+	if (colsB != colsA)
 	{
 		mexErrMsgIdAndTxt( "MATLAB:taInvoke:InputErr",
-			"Price data should be passed to the function already parsed into H | L | C vectors.\nThe 'Low' vector had more than 1 column.  Aborting (%i).", lineNum);
+			"The second input has %i columns where %i were expected.  All inputs should have one column per instrument.  Aborting (%i).", colsB, colsA, lineNum);
 	}
 
-	if (colsC != 1)
-	{
-		mexErrMsgIdAndTxt( "MATLAB:taInvoke:InputErr",
-			"Price data should be passed to the function already parsed into H | L | C vectors.\nThe 'Close' vector had more than 1 column.  Aborting (%i).", lineNum);
-	}
+	return colsA;
 }
 
-// O | H | L | C
-void chkSingleVec(int colsO, int colsH, int colsL, int colsC, int lineNum )
+int chkSameCols(int colsA, int colsB, int colsC, int lineNum)
 {
-	if (colsO != 1)
-	{
-		mexErrMsgIdAndTxt( "MATLAB:taInvoke:InputErr",
-			"Price data should be passed to the function already parsed into O | H | L | C vectors.\nThe 'Open' vector had more than 1 column.  Aborting (%i).", lineNum);
-	}
+	chkSameCols(colsA, colsB, lineNum);
 
-	if (colsH != 1)
+	if (colsC != colsA)
 	{
 		mexErrMsgIdAndTxt( "MATLAB:taInvoke:InputErr",
-			"Price data should be passed to the function already parsed into O | H | L | C vectors.\nThe 'High' vector had more than 1 column.  Aborting (%i).", lineNum);
+			"The third input has %i columns where %i were expected.  All inputs should have one column per instrument.  Aborting (%i).", colsC, colsA, lineNum);
 	}
 
-	if (colsL != 1)
-	{
-		mexErrMsgIdAndTxt( "MATLAB:taInvoke:InputErr",
-			"Price data should be passed to the function already parsed into O | H | L | C vectors.\nThe 'Low' vector had more than 1 column.  Aborting (%i).", lineNum);
-	}
+	return colsA;
+}
 
-	if (colsC != 1)
+int chkSameCols(int colsA, int colsB, int colsC, int colsD, int lineNum)
+{
+	chkSameCols(colsA, colsB, colsC, lineNum);
+
+	if (colsD != colsA)
 	{
 		mexErrMsgIdAndTxt( "MATLAB:taInvoke:InputErr",
-			"Price data should be passed to the function already parsed into O | H | L | C vectors.\nThe 'Close' vector had more than 1 column.  Aborting (%i).", lineNum);
+			"The fourth input has %i columns where %i were expected.  All inputs should have one column per instrument.  Aborting (%i).", colsD, colsA, lineNum);
 	}
+
+	return colsA;
 }
 
 // typeMA 
@@ -10598,6 +10163,511 @@ void typeMAcheck(string taFuncNameIn, string taFuncDesc, string taFuncOptName, i
 	}
 }
 
+// Output allocation
+// Outputs are created at full size (one column per instrument) and TA-Lib writes directly into them.  When invoked
+// with a startIdx of 0 TA-Lib begins writing at outBegIdx, which is the function's lookback, so only that prefix of
+// each column needs to be NaN filled.  Returns the address TA-Lib should write to for the first column.
+double *taAllocOut(mxArray *&outArray, int rows, int cols, int lookback)
+{
+	// Nothing is written if there are not enough observations
+	if (lookback > rows)
+		lookback = rows;
+
+	outArray = mxCreateDoubleMatrix(rows, cols, mxREAL);
+	double *outPtr = mxGetPr(outArray);
+
+	for (int col = 0; col < cols; col++)
+	{
+		for (int iter = 0; iter < lookback; iter++)
+		{
+			outPtr[col * rows + iter] = m_Nan;
+		}
+	}
+
+	return outPtr + lookback;
+}
+
+// INT32 outputs have no NaN.  The prefix is left as zero.
+int *taAllocIntOut(mxArray *&outArray, int rows, int cols, int lookback)
+{
+	if (lookback > rows)
+		lookback = rows;
+
+	outArray = mxCreateNumericMatrix(rows, cols, mxINT32_CLASS, mxREAL);
+
+	return (int *)mxGetData(outArray) + lookback;
+}
+
+// Columns are invoked concurrently.  Keep the return code of a failed column so it may be reported
+// once all columns have completed (no MEX API calls are made from the workers).
+void taColCode(TA_RetCode &retCode, TA_RetCode colCode)
+{
+	if (colCode != TA_SUCCESS)
+	{
+#pragma omp critical (taRetCode)
+		retCode = colCode;
+	}
+}
+
+// Parameters which may be given as a scalar or a vector (e.g. a set of lookbacks).  The values are copied to
+// an mxMalloc'd array the caller frees.  Returns the count, or 0 if the input is not a real scalar or vector.
+int taGetParams(const mxArray *paramIn, int *&params)
+{
+	if (!isReal2DfullDouble(paramIn) || mxIsEmpty(paramIn) || (mxGetM(paramIn) != 1 && mxGetN(paramIn) != 1))
+		return 0;
+
+	int numParams = (int)mxGetNumberOfElements(paramIn);
+	double *paramPtr = mxGetPr(paramIn);
+
+	params = (int*)mxMalloc(numParams * sizeof(int));
+	for (int iter = 0; iter < numParams; iter++)
+	{
+		params[iter] = (int)paramPtr[iter];
+	}
+
+	return numParams;
+}
+
+// Output of several parameter sets.  Follows relStrIdx: a single instrument gives rows x K and M instruments give
+// rows x M x K.  Either way parameter set k of instrument col is the column k * cols + col.  outBeg holds the
+// outBegIdx of each parameter set (already limited to rows) and that prefix of every column is NaN filled.
+// Returns the base of the output.
+double *taAllocGridOut(mxArray *&outArray, int rows, int cols, int numParams, const int *outBeg)
+{
+	if (cols > 1 && numParams > 1)
+	{
+		mwSize dims[3] = {(mwSize)rows, (mwSize)cols, (mwSize)numParams};
+		outArray = mxCreateNumericArray(3, dims, mxDOUBLE_CLASS, mxREAL);
+	}
+	else
+		outArray = mxCreateDoubleMatrix(rows, cols * numParams, mxREAL);
+
+	double *outPtr = mxGetPr(outArray);
+
+	for (int kk = 0; kk < numParams; kk++)
+	{
+		for (int col = 0; col < cols; col++)
+		{
+			double *colPtr = outPtr + (kk * cols + col) * rows;
+			for (int iter = 0; iter < outBeg[kk]; iter++)
+			{
+				colPtr[iter] = m_Nan;
+			}
+		}
+	}
+
+	return outPtr;
+}
+
+// Window statistics in O(1) per observation from sums of the window, added to as an observation enters and
+// subtracted from as it leaves.  The steps are those of TA_SUM, TA_SMA, TA_VAR and TA_STDDEV so a column of a grid
+// is identical to a call with that lookback: values are written from lookback - 1 (outBegIdx) onward and the
+// variance is that of the population.  Sums over the window alone (rather than differences of sums over the whole
+// series) keep the error independent of the length of the series.
+void taRollSums(const double *data, int rows, int lookback, int rollType, double numDev, double *out)
+{
+	if (rows < lookback)
+		return;
+
+	double periodTotal = 0, periodTotal2 = 0;
+	int trailIdx = 0;
+
+	for (int iter = 0; iter < lookback - 1; iter++)
+	{
+		periodTotal += data[iter];
+		periodTotal2 += data[iter] * data[iter];
+	}
+
+	for (int iter = lookback - 1; iter < rows; iter++)
+	{
+		double tempReal = data[iter];
+		periodTotal += tempReal;
+		periodTotal2 += tempReal * tempReal;
+
+		switch (rollType)
+		{
+			case taRollSum:
+				out[iter] = periodTotal;
+				break;
+
+			case taRollMean:
+				out[iter] = periodTotal / lookback;
+				break;
+
+			default:
+				{
+					double meanValue1 = periodTotal / lookback;
+					double var = periodTotal2 / lookback - meanValue1 * meanValue1;
+
+					if (rollType == taRollVar)
+						out[iter] = var;
+					// TA-Lib treats a near zero variance as zero
+					else
+						out[iter] = var < 0.00000001 ? 0 : sqrt(var) * numDev;
+				}
+				break;
+		}
+
+		tempReal = data[trailIdx++];
+		periodTotal -= tempReal;
+		periodTotal2 -= tempReal * tempReal;
+	}
+}
+
+// Pipeline stage kinds
+enum taStageKind { taStageUnary, taStagePeriod, taStageMA, taStageDev };
+
+// A stage of a pipeline.  'source' is 0 for the data input or the (1 based) stage whose output is consumed.
+struct taStage
+{
+	StringValue taFunc;
+	int kind;
+	taUnaryFunc unaryFunc;
+	taUnaryLookback unaryLookback;
+	taPeriodFunc periodFunc;
+	taPeriodLookback periodLookback;
+	int source;
+	int period;
+	int typeMA;
+	double numDev;
+	int outBeg;				// First valid observation (NaN before it)
+	int level;				// Stages of a level only depend on earlier levels
+	int lastUse;			// Last level reading this stage's output.  -1 for outputs.
+	int outIdx;				// plhs index of an output stage
+	bool needed;			// Requested, or read by a requested stage
+	double *buf;
+};
+
+// Map a function to its pipeline stage kind.  Only functions of a single series with a single output may be chained.
+bool taStageResolve(StringValue taFunc, taStage &stage)
+{
+	stage.unaryFunc = NULL;
+	stage.unaryLookback = NULL;
+	stage.periodFunc = NULL;
+	stage.periodLookback = NULL;
+
+	switch (taFunc)
+	{
+		case ta_acos:		stage.unaryFunc = TA_ACOS;		stage.unaryLookback = TA_ACOS_Lookback;		break;
+		case ta_asin:		stage.unaryFunc = TA_ASIN;		stage.unaryLookback = TA_ASIN_Lookback;		break;
+		case ta_atan:		stage.unaryFunc = TA_ATAN;		stage.unaryLookback = TA_ATAN_Lookback;		break;
+		case ta_ceil:		stage.unaryFunc = TA_CEIL;		stage.unaryLookback = TA_CEIL_Lookback;		break;
+		case ta_cos:		stage.unaryFunc = TA_COS;		stage.unaryLookback = TA_COS_Lookback;		break;
+		case ta_cosh:		stage.unaryFunc = TA_COSH;		stage.unaryLookback = TA_COSH_Lookback;		break;
+		case ta_exp:		stage.unaryFunc = TA_EXP;		stage.unaryLookback = TA_EXP_Lookback;		break;
+		case ta_floor:		stage.unaryFunc = TA_FLOOR;		stage.unaryLookback = TA_FLOOR_Lookback;	break;
+		case ta_ln:			stage.unaryFunc = TA_LN;		stage.unaryLookback = TA_LN_Lookback;		break;
+		case ta_log10:		stage.unaryFunc = TA_LOG10;		stage.unaryLookback = TA_LOG10_Lookback;	break;
+		case ta_sin:		stage.unaryFunc = TA_SIN;		stage.unaryLookback = TA_SIN_Lookback;		break;
+		case ta_sinh:		stage.unaryFunc = TA_SINH;		stage.unaryLookback = TA_SINH_Lookback;		break;
+		case ta_sqrt:		stage.unaryFunc = TA_SQRT;		stage.unaryLookback = TA_SQRT_Lookback;		break;
+		case ta_tan:		stage.unaryFunc = TA_TAN;		stage.unaryLookback = TA_TAN_Lookback;		break;
+		case ta_tanh:		stage.unaryFunc = TA_TANH;		stage.unaryLookback = TA_TANH_Lookback;		break;
+
+		case ta_avgdev:		stage.periodFunc = TA_AVGDEV;	stage.periodLookback = TA_AVGDEV_Lookback;	break;
+		case ta_cmo:		stage.periodFunc = TA_CMO;		stage.periodLookback = TA_CMO_Lookback;		break;
+		case ta_dema:		stage.periodFunc = TA_DEMA;		stage.periodLookback = TA_DEMA_Lookback;	break;
+		case ta_ema:		stage.periodFunc = TA_EMA;		stage.periodLookback = TA_EMA_Lookback;		break;
+		case ta_kama:		stage.periodFunc = TA_KAMA;		stage.periodLookback = TA_KAMA_Lookback;	break;
+		case ta_linearreg:	stage.periodFunc = TA_LINEARREG;	stage.periodLookback = TA_LINEARREG_Lookback;	break;
+		case ta_linearreg_angle:		stage.periodFunc = TA_LINEARREG_ANGLE;		stage.periodLookback = TA_LINEARREG_ANGLE_Lookback;		break;
+		case ta_linearreg_intercept:	stage.periodFunc = TA_LINEARREG_INTERCEPT;	stage.periodLookback = TA_LINEARREG_INTERCEPT_Lookback;	break;
+		case ta_linearreg_slope:		stage.periodFunc = TA_LINEARREG_SLOPE;		stage.periodLookback = TA_LINEARREG_SLOPE_Lookback;		break;
+		case ta_max:		stage.periodFunc = TA_MAX;		stage.periodLookback = TA_MAX_Lookback;		break;
+		case ta_midpoint:	stage.periodFunc = TA_MIDPOINT;	stage.periodLookback = TA_MIDPOINT_Lookback;	break;
+		case ta_min:		stage.periodFunc = TA_MIN;		stage.periodLookback = TA_MIN_Lookback;		break;
+		case ta_mom:		stage.periodFunc = TA_MOM;		stage.periodLookback = TA_MOM_Lookback;		break;
+		case ta_roc:		stage.periodFunc = TA_ROC;		stage.periodLookback = TA_ROC_Lookback;		break;
+		case ta_rocp:		stage.periodFunc = TA_ROCP;		stage.periodLookback = TA_ROCP_Lookback;	break;
+		case ta_rocr:		stage.periodFunc = TA_ROCR;		stage.periodLookback = TA_ROCR_Lookback;	break;
+		case ta_rocr100:	stage.periodFunc = TA_ROCR100;	stage.periodLookback = TA_ROCR100_Lookback;	break;
+		case ta_rsi:		stage.periodFunc = TA_RSI;		stage.periodLookback = TA_RSI_Lookback;		break;
+		case ta_sma:		stage.periodFunc = TA_SMA;		stage.periodLookback = TA_SMA_Lookback;		break;
+		case ta_sum:		stage.periodFunc = TA_SUM;		stage.periodLookback = TA_SUM_Lookback;		break;
+		case ta_tema:		stage.periodFunc = TA_TEMA;		stage.periodLookback = TA_TEMA_Lookback;	break;
+		case ta_trima:		stage.periodFunc = TA_TRIMA;	stage.periodLookback = TA_TRIMA_Lookback;	break;
+		case ta_trix:		stage.periodFunc = TA_TRIX;		stage.periodLookback = TA_TRIX_Lookback;	break;
+		case ta_tsf:		stage.periodFunc = TA_TSF;		stage.periodLookback = TA_TSF_Lookback;		break;
+		case ta_wma:		stage.periodFunc = TA_WMA;		stage.periodLookback = TA_WMA_Lookback;		break;
+
+		case ta_ma:
+			stage.kind = taStageMA;
+			return true;
+
+		case ta_stddev:
+		case ta_var:
+			stage.kind = taStageDev;
+			return true;
+
+		default:
+			return false;
+	}
+
+	stage.kind = (stage.unaryFunc != NULL) ? taStageUnary : taStagePeriod;
+	return true;
+}
+
+// Invoke a stage on one column.  'in' begins at the source's first valid observation and holds numObs values.
+// TA-Lib writes from outBegIdx (the stage's lookback) onward so the output is passed at the matching offset.
+TA_RetCode taStageInvoke(const taStage &stage, const double *in, int numObs, double *out, int lookback)
+{
+	int colBegIdx, colElements;
+
+	if (numObs <= lookback)
+		return TA_SUCCESS;
+
+	switch (stage.kind)
+	{
+		case taStageUnary:
+			return stage.unaryFunc(0, numObs - 1, in, &colBegIdx, &colElements, out + lookback);
+		case taStagePeriod:
+			return stage.periodFunc(0, numObs - 1, in, stage.period, &colBegIdx, &colElements, out + lookback);
+		case taStageMA:
+			return TA_MA(0, numObs - 1, in, stage.period, (TA_MAType)stage.typeMA, &colBegIdx, &colElements, out + lookback);
+		default:
+			if (stage.taFunc == ta_stddev)
+				return TA_STDDEV(0, numObs - 1, in, stage.period, stage.numDev, &colBegIdx, &colElements, out + lookback);
+			return TA_VAR(0, numObs - 1, in, stage.period, stage.numDev, &colBegIdx, &colElements, out + lookback);
+	}
+}
+
+int taStageLookback(const taStage &stage)
+{
+	switch (stage.kind)
+	{
+		case taStageUnary:
+			return stage.unaryLookback();
+		case taStagePeriod:
+			return stage.periodLookback(stage.period);
+		case taStageMA:
+			return TA_MA_Lookback(stage.period, (TA_MAType)stage.typeMA);
+		default:
+			if (stage.taFunc == ta_stddev)
+				return TA_STDDEV_Lookback(stage.period, stage.numDev);
+			return TA_VAR_Lookback(stage.period, stage.numDev);
+	}
+}
+
+// [out1, out2, ...] = taInvoke('@pipeline', data, stages)
+//
+// Evaluates a chain (or tree) of single series functions without returning intermediate results to MatLab.
+//		data		N x M observations (one column per instrument)
+//		stages		cell array of stages.  Each stage is a cell {taFunction, source, params...}
+//						taFunction	name or handle from '@resolve'
+//						source		0 for data, or the (1 based) index of an earlier stage whose output is consumed
+//						params		lookback period (period functions), lookback and typeMA (ta_ma),
+//									lookback and numDev (ta_stddev, ta_var).  Vector transforms have none.
+//
+// Every stage whose output is not consumed by a later stage is returned, in stage order.  An output has the
+// same N x M shape as data with NaN before the first observation for which all stages of its chain are defined.
+//
+// Stages are grouped into levels (a stage is one level above its source).  All stages of a level and all of
+// their columns run concurrently.  Intermediate results are held in native buffers which are returned to a
+// pool once the last level reading them has run, so a long chain reuses a couple of buffers.
+//
+//		rsiEma = taInvoke('@pipeline', Close, {{'ta_rsi', 0, 14}, {'ta_ema', 1, 10}});
+void taPipeline(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+	#define data_IN		prhs[1]
+	#define stages_IN	prhs[2]
+
+	if (nrhs != 3 || !isReal2DfullDouble(data_IN) || !mxIsCell(stages_IN))
+		mexErrMsgIdAndTxt("MATLAB:taInvoke:Parsing",
+		"Usage is [out1, ...] = taInvoke('@pipeline', data, {{'ta_function', source, params...}, ...}). Aborting (%d).", codeLine);
+
+	int rows = (int)mxGetM(data_IN);
+	int cols = (int)mxGetN(data_IN);
+	int numStages = (int)mxGetNumberOfElements(stages_IN);
+	double *dataPtr = mxGetPr(data_IN);
+
+	if (numStages == 0)
+		mexErrMsgIdAndTxt("MATLAB:taInvoke:Parsing", "A pipeline requires at least one stage. Aborting (%d).", codeLine);
+
+	taStage *stages = (taStage*)mxCalloc(numStages, sizeof(taStage));
+	int numLevels = 0;
+
+	// Parse
+	for (int st = 0; st < numStages; st++)
+	{
+		const mxArray *stageIn = mxGetCell(stages_IN, st);
+		taStage &stage = stages[st];
+
+		if (stageIn == NULL || !mxIsCell(stageIn) || mxGetNumberOfElements(stageIn) < 2)
+			mexErrMsgIdAndTxt("MATLAB:taInvoke:Parsing",
+			"Stage %d must be a cell of {taFunction, source, params...}. Aborting (%d).", st + 1, codeLine);
+
+		// Function as a name or handle
+		const mxArray *funcIn = mxGetCell(stageIn, 0);
+		if (funcIn != NULL && mxIsChar(funcIn))
+		{
+			char *funcAsChars = mxArrayToString(funcIn);
+			string funcName(funcAsChars);
+			mxFree(funcAsChars);
+			transform(funcName.begin(), funcName.end(), funcName.begin(), ::tolower);
+			stage.taFunc = taResolve(funcName.c_str());
+		}
+		else if (funcIn != NULL && isRealScalar(funcIn) && mxGetScalar(funcIn) >= 1 && mxGetScalar(funcIn) < taNumFuncs)
+			stage.taFunc = (StringValue)(int)mxGetScalar(funcIn);
+		else
+			stage.taFunc = taNotDefined;
+
+		if (stage.taFunc == taNotDefined || !taStageResolve(stage.taFunc, stage))
+			mexErrMsgIdAndTxt("MATLAB:taInvoke:Parsing",
+			"Stage %d is not a function of a single series with a single output. Aborting (%d).", st + 1, codeLine);
+
+		// Source
+		const mxArray *sourceIn = mxGetCell(stageIn, 1);
+		if (sourceIn == NULL || !isRealScalar(sourceIn))
+			mexErrMsgIdAndTxt("MATLAB:taInvoke:Parsing", "The source of stage %d must be a scalar. Aborting (%d).", st + 1, codeLine);
+
+		stage.source = (int)mxGetScalar(sourceIn);
+		if (stage.source < 0 || stage.source > st)
+			mexErrMsgIdAndTxt("MATLAB:taInvoke:Parsing",
+			"The source of stage %d must be 0 (data) or an earlier stage. Aborting (%d).", st + 1, codeLine);
+
+		// Parameters
+		int numParams = (int)mxGetNumberOfElements(stageIn) - 2;
+		double params[2] = {0, 0};
+		int maxParams = (stage.kind == taStageUnary) ? 0 : (stage.kind == taStagePeriod) ? 1 : 2;
+		int minParams = (stage.kind == taStageUnary) ? 0 : 1;
+
+		if (numParams < minParams || numParams > maxParams)
+			mexErrMsgIdAndTxt("MATLAB:taInvoke:Parsing",
+			"Stage %d ('%s') takes %d to %d parameters. Aborting (%d).", st + 1, taFuncNames[stage.taFunc], minParams, maxParams, codeLine);
+
+		for (int iter = 0; iter < numParams; iter++)
+		{
+			const mxArray *paramIn = mxGetCell(stageIn, iter + 2);
+			if (paramIn == NULL || !isRealScalar(paramIn))
+				mexErrMsgIdAndTxt("MATLAB:taInvoke:Parsing", "The parameters of stage %d must be scalars. Aborting (%d).", st + 1, codeLine);
+			params[iter] = mxGetScalar(paramIn);
+		}
+
+		stage.period = (int)params[0];
+		stage.typeMA = (stage.kind == taStageMA) ? (int)params[1] : 0;
+		stage.numDev = (stage.kind == taStageDev && numParams > 1) ? params[1] : 1;
+
+		if (stage.kind != taStageUnary && stage.period < 1)
+			mexErrMsgIdAndTxt("MATLAB:taInvoke:inputErr",
+			"The lookback of stage %d must be 1 or greater. Aborting (%d).", st + 1, codeLine);
+
+		if (stage.kind == taStageMA)
+			typeMAcheck(taFuncNames[stage.taFunc], "Moving average", "typeMA", stage.typeMA);
+
+		// Placement
+		const taStage *src = (stage.source > 0) ? &stages[stage.source - 1] : NULL;
+		int srcBeg = (src != NULL) ? src->outBeg : 0;
+
+		stage.outBeg = min(srcBeg + taStageLookback(stage), rows);
+		stage.level = (src != NULL) ? src->level + 1 : 0;
+		stage.lastUse = -1;
+		stage.outIdx = -1;
+
+		if (src != NULL)
+			stages[stage.source - 1].lastUse = stage.level;
+
+		numLevels = max(numLevels, stage.level + 1);
+	}
+
+	// Unconsumed stages are the outputs
+	int numOut = 0;
+	for (int st = 0; st < numStages; st++)
+	{
+		if (stages[st].lastUse < 0)
+			stages[st].outIdx = numOut++;
+	}
+
+	if (nlhs > numOut)
+		mexErrMsgIdAndTxt("MATLAB:taInvoke:Parsing",
+		"The pipeline has %d outputs where %d were requested. Aborting (%d).", numOut, nlhs, codeLine);
+
+	// Outputs which are not requested (and stages only they read) are not evaluated
+	for (int st = numStages - 1; st >= 0; st--)
+	{
+		if (stages[st].outIdx >= 0)
+			stages[st].needed = stages[st].outIdx < max(nlhs, 1);
+		if (stages[st].needed && stages[st].source > 0)
+			stages[stages[st].source - 1].needed = true;
+	}
+
+	// Native buffers for intermediate results (rows x cols).  Released buffers are reused by later levels.
+	double **pool = (double**)mxCalloc(numStages, sizeof(double*));
+	int poolSize = 0;
+
+	int *jobStage = (int*)mxCalloc(numStages * cols, sizeof(int));
+	TA_RetCode retCode = TA_SUCCESS;
+	int failedStage = 0;
+
+	for (int level = 0; level < numLevels && retCode == TA_SUCCESS; level++)
+	{
+		// Allocate the level's outputs on the main thread
+		int numJobs = 0;
+		for (int st = 0; st < numStages; st++)
+		{
+			taStage &stage = stages[st];
+			if (stage.level != level || !stage.needed)
+				continue;
+
+			if (stage.outIdx >= 0)
+				stage.buf = taAllocOut(plhs[stage.outIdx], rows, cols, stage.outBeg) - stage.outBeg;
+			else
+				stage.buf = (poolSize > 0) ? pool[--poolSize] : (double*)mxMalloc(rows * cols * sizeof(double));
+
+			jobStage[numJobs++] = st;
+		}
+
+		// Every (stage, column) pair of the level is independent
+		int levelJobs = numJobs * cols;
+
+#pragma omp parallel for schedule(dynamic) if (levelJobs > 1)
+		for (int job = 0; job < levelJobs; job++)
+		{
+			const taStage &stage = stages[jobStage[job / cols]];
+			int col = job % cols;
+			int srcBeg = (stage.source > 0) ? stages[stage.source - 1].outBeg : 0;
+			const double *in = (stage.source > 0) ? stages[stage.source - 1].buf : dataPtr;
+
+			TA_RetCode colCode = taStageInvoke(stage, in + col * rows + srcBeg, rows - srcBeg,
+				stage.buf + col * rows + srcBeg, stage.outBeg - srcBeg);
+
+			if (colCode != TA_SUCCESS)
+			{
+#pragma omp critical (taRetCode)
+				{
+					retCode = colCode;
+					failedStage = jobStage[job / cols] + 1;
+				}
+			}
+		}
+
+		// Return buffers whose last reader has run
+		for (int st = 0; st < numStages; st++)
+		{
+			if (stages[st].lastUse == level && stages[st].buf != NULL)
+			{
+				pool[poolSize++] = stages[st].buf;
+				stages[st].buf = NULL;
+			}
+		}
+	}
+
+	for (int iter = 0; iter < poolSize; iter++)
+	{
+		mxFree(pool[iter]);
+	}
+	mxFree(pool);
+	mxFree(jobStage);
+
+	if (retCode)
+	{
+		mexPrintf("%s%i","Return code=",retCode);
+		mexErrMsgIdAndTxt("MATLAB:taInvoke","Invocation to '%s' (stage %d) failed. Aborting (%d).",
+			taFuncNames[stages[failedStage - 1].taFunc], failedStage, codeLine);
+	}
+
+	mxFree(stages);
+}
+
 void taInvokeFuncInfo(string taFuncNameIn)
 {
 	char *para1;
@@ -10607,7 +10677,7 @@ void taInvokeFuncInfo(string taFuncNameIn)
 	char *form = NULL;
 	char *typeOut;
 
-	switch (s_mapStringValues[taFuncNameIn])
+	switch (taResolve(taFuncNameIn.c_str()))
 	{
 		case ta_accbands:
 			{